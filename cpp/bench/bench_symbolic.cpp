@@ -1,5 +1,22 @@
 #include <benchmark/benchmark.h>
+#include "mathllm/canonical.h"
+#include "mathllm/derivatives.h"
+#include "mathllm/egraph.h"
+#include "mathllm/groebner.h"
+#include "mathllm/integration.h"
+#include "mathllm/intern.h"
+#include "mathllm/rational.h"
+#include "mathllm/roots.h"
+#include "mathllm/series.h"
+#include "mathllm/solver.h"
 #include "mathllm/symbolic.h"
+#include "mathllm/trig.h"
+
+#include <symengine/parser.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
 
 static void BM_Integrate_Simple(benchmark::State& state) {
     for (auto _ : state) {
@@ -25,6 +42,30 @@ static void BM_Integrate_Trig(benchmark::State& state) {
 }
 BENCHMARK(BM_Integrate_Trig);
 
+static void BM_IntegrateDefinite_Symbolic(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::integrate_definite("x*sin(x)", "x", 0.0, 3.0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_IntegrateDefinite_Symbolic);
+
+static void BM_IntegrateDefinite_Quadrature(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::integrate_definite("exp(-x^2)*cos(5*x)", "x", -2.0, 2.0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_IntegrateDefinite_Quadrature);
+
+static void BM_IntegrateND_Cubature(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::integrate_nd("exp(-x^2 - y^2)*cos(x*y)", {"x", "y"}, {{0.0, 2.0}, {0.0, 2.0}});
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_IntegrateND_Cubature);
+
 static void BM_Diff_Simple(benchmark::State& state) {
     for (auto _ : state) {
         std::string result = mathllm::diff("x^2", "x");
@@ -41,6 +82,124 @@ static void BM_Diff_Polynomial(benchmark::State& state) {
 }
 BENCHMARK(BM_Diff_Polynomial);
 
+namespace {
+
+// 20 variables coupled through shared subexpressions: every term sits under
+// the common exp(-r2) factor.
+const std::vector<std::string>& hessian_vars() {
+    static const std::vector<std::string> vars = [] {
+        std::vector<std::string> names;
+        for (int i = 0; i < 20; ++i) {
+            names.push_back("x" + std::to_string(i));
+        }
+        return names;
+    }();
+    return vars;
+}
+
+std::string hessian_expr() {
+    const auto& vars = hessian_vars();
+    std::string r2 = "0";
+    std::string chain = "0";
+    for (std::size_t i = 0; i < vars.size(); ++i) {
+        r2 += " + " + vars[i] + "^2";
+        if (i + 1 < vars.size()) {
+            chain += " + sin(" + vars[i] + "*" + vars[i + 1] + ")";
+        }
+    }
+    return "exp(-(" + r2 + ")/20)*(" + chain + ")";
+}
+
+}
+
+static void BM_Hessian_20Vars(benchmark::State& state) {
+    const std::string expr = hessian_expr();
+    for (auto _ : state) {
+        auto result = mathllm::hessian(expr, hessian_vars());
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Hessian_20Vars);
+
+// Baseline: the same Hessian from n^2 string round trips through diff.
+static void BM_Hessian_20Vars_StringDiff(benchmark::State& state) {
+    const std::string expr = hessian_expr();
+    const auto& vars = hessian_vars();
+    for (auto _ : state) {
+        std::vector<std::string> entries;
+        for (const auto& first : vars) {
+            const std::string partial = mathllm::diff(expr, first);
+            for (const auto& second : vars) {
+                entries.push_back(mathllm::diff(partial, second));
+            }
+        }
+        benchmark::DoNotOptimize(entries);
+    }
+}
+BENCHMARK(BM_Hessian_20Vars_StringDiff);
+
+static void BM_HessianEvaluate_20Vars(benchmark::State& state) {
+    const auto hess = mathllm::hessian(hessian_expr(), hessian_vars());
+    const std::size_t count = 256;
+    std::vector<double> points(count * hessian_vars().size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points[i] = 0.01 * static_cast<double>(i % 97) - 0.5;
+    }
+    std::vector<double> out(count * hess.rows() * hess.cols());
+    for (auto _ : state) {
+        hess.evaluate_batch(points.data(), count, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_HessianEvaluate_20Vars);
+
+static void BM_Series_Tan(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::series("tan(x)", "x", "0", 12);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Series_Tan);
+
+static void BM_Series_Laurent(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::series("(exp(x) - 1 - x)/(x*sin(x)^2)", "x", "0", 6);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Series_Laurent);
+
+// Textbook limits; eval/scripts/bench_limits.py times the same corpus
+// against SymPy.
+static void BM_Limit_Corpus(benchmark::State& state) {
+    struct Case {
+        const char* expr;
+        const char* point;
+        const char* dir;
+    };
+    const std::vector<Case> corpus = {
+        {"sin(x)/x", "0", "+-"},
+        {"(1 - cos(x))/x^2", "0", "+-"},
+        {"(exp(x) - 1)/x", "0", "+-"},
+        {"(1 + 1/x)^x", "oo", "+-"},
+        {"sqrt(x^2 + x) - x", "oo", "+-"},
+        {"(x^2 - 1)/(x - 1)", "1", "+-"},
+        {"tan(x)/x", "0", "+-"},
+        {"x*sin(1/x)", "oo", "+-"},
+        {"(sin(x) - x)/x^3", "0", "+-"},
+        {"exp(-1/x)/x", "0", "+"},
+    };
+    for (auto _ : state) {
+        for (const auto& c : corpus) {
+            auto result = mathllm::limit(c.expr, "x", c.point, c.dir);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.size()));
+}
+BENCHMARK(BM_Limit_Corpus);
+
 static void BM_Solve_Linear(benchmark::State& state) {
     for (auto _ : state) {
         std::string result = mathllm::solve_equation("2*x + 1", "5", "x");
@@ -57,6 +216,103 @@ static void BM_Solve_Quadratic(benchmark::State& state) {
 }
 BENCHMARK(BM_Solve_Quadratic);
 
+static void BM_Solve_Quintic(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string result = mathllm::solve_equation("x^5 - x", "1", "x");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Solve_Quintic);
+
+static void BM_PolynomialRoots_Batch(benchmark::State& state) {
+    // 256 degree-20 polynomials with coefficients in [-1, 1].
+    std::vector<std::vector<double>> polys(256, std::vector<double>(21));
+    unsigned int seed = 1;
+    for (auto& poly : polys) {
+        for (auto& coeff : poly) {
+            seed = seed * 1103515245u + 12345u;
+            coeff = static_cast<double>(seed >> 8) / static_cast<double>(1u << 23) - 1.0;
+        }
+    }
+    for (auto _ : state) {
+        auto results = mathllm::find_polynomial_roots_batch(polys);
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(polys.size()));
+}
+BENCHMARK(BM_PolynomialRoots_Batch);
+
+static void BM_FindRealRoots_Transcendental(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::find_real_roots("x*exp(x)", "2", "x", -10.0, 10.0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FindRealRoots_Transcendental);
+
+static void BM_SolveSystem_Newton(benchmark::State& state) {
+    // Diode with series resistor feeding a second branch.
+    const std::vector<std::string> equations = {
+        "1e-12*(exp(v1/0.025) - 1) = i1",
+        "(5 - v1)/1000 = i1 + i2",
+        "i2 = v1/2000"
+    };
+    for (auto _ : state) {
+        auto result = mathllm::solve_system(equations, {"v1", "i1", "i2"}, {0.6, 0.001, 0.0003});
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_SolveSystem_Newton);
+
+static void BM_SolveLinear_Exact(benchmark::State& state) {
+    const std::vector<std::string> equations = {
+        "2*x + y - z = 8", "-3*x - y + 2*z = -11", "-2*x + y + 2*z = -3"
+    };
+    for (auto _ : state) {
+        auto result = mathllm::solve_linear_system(equations, {"x", "y", "z"});
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_SolveLinear_Exact);
+
+static void BM_SolveParametric_Quadratic(benchmark::State& state) {
+    const auto solution = mathllm::solve_parametric("a*x^2 + b*x + c", "0", "x", {"a", "b", "c"});
+    const std::size_t count = 10000;
+    std::vector<double> points;
+    for (std::size_t i = 0; i < count; ++i) {
+        points.push_back(1.0 + 0.001 * static_cast<double>(i));
+        points.push_back(-5.0);
+        points.push_back(0.5 * static_cast<double>(i % 7));
+    }
+    std::vector<double> out(count * solution.width());
+    for (auto _ : state) {
+        solution.evaluate_batch(points.data(), count, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_SolveParametric_Quadratic);
+
+static void BM_Groebner_Cyclic4(benchmark::State& state) {
+    const std::vector<std::string> cyclic = {
+        "a + b + c + d", "a*b + b*c + c*d + d*a", "a*b*c + b*c*d + c*d*a + d*a*b", "a*b*c*d - 1"
+    };
+    for (auto _ : state) {
+        auto result = mathllm::groebner_basis(cyclic, {"a", "b", "c", "d"});
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Groebner_Cyclic4);
+
+static void BM_SolvePolynomialSystem(benchmark::State& state) {
+    const std::vector<std::string> equations = {"x^2 + y^2 = 5", "x*y = 2", "z = x + y"};
+    for (auto _ : state) {
+        auto result = mathllm::solve_polynomial_system(equations, {"x", "y", "z"});
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_SolvePolynomialSystem);
+
 static void BM_Verify_Simple(benchmark::State& state) {
     for (auto _ : state) {
         bool result = mathllm::verify_equal("x + x", "2*x", 1000.0);
@@ -81,4 +337,90 @@ static void BM_Verify_Trig(benchmark::State& state) {
 }
 BENCHMARK(BM_Verify_Trig);
 
+static void BM_Simplify_Rational(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::simplify("(x^3 - 1)/(x^2 - 1) + 1/(x + 1)");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Simplify_Rational);
+
+static void BM_Simplify_Trig(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::simplify("tan(x)*cos(x)^3 + sin(x)^3");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Simplify_Trig);
+
+static void BM_EGraph_Equivalent_Trig(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::egraph_equivalent("sec(x)^2 - tan(x)^2", "1");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_EGraph_Equivalent_Trig);
+
+static void BM_EGraph_Simplify(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::egraph_simplify("sin(x)^4 + 2*sin(x)^2*cos(x)^2 + cos(x)^4 + x*y + x*z");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_EGraph_Simplify);
+
+static void BM_Verify_Rational(benchmark::State& state) {
+    for (auto _ : state) {
+        bool result = mathllm::verify_equal("1/(x - 1) - 1/(x + 1)", "2/(x^2 - 1)", 1000.0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Verify_Rational);
+
+static void BM_Cancel_Multivariate(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::cancel("(x^3*y - x*y^3)/(x^2*y + 2*x*y^2 + y^3)");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Cancel_Multivariate);
+
+static void BM_Verify_Trig_MultipleAngle(benchmark::State& state) {
+    for (auto _ : state) {
+        bool result = mathllm::verify_equal("sin(5*x)", "16*sin(x)^5 - 20*sin(x)^3 + 5*sin(x)", 1000.0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Verify_Trig_MultipleAngle);
+
+static void BM_Trig_Canonical(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = mathllm::trig_canonical("sin(x)^3*cos(y)^2 + tan(x)*cos(x)*sin(y)^2");
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Trig_Canonical);
+
+static void BM_Intern_Shared(benchmark::State& state) {
+    const auto expr = SymEngine::parse("sin(x)^2*exp(x*y) + cos(x)^2*exp(x*y) + (x + y)^5");
+    for (auto _ : state) {
+        auto result = mathllm::intern(expr);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Intern_Shared);
+
+// Renamed copies of one integrand; after the first, each is answered from
+// the alpha cache.
+static void BM_Integrate_Renamed(benchmark::State& state) {
+    const std::vector<std::string> vars = {"x", "t", "u", "w"};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& var = vars[i++ % vars.size()];
+        auto result = mathllm::integrate(var + "^2*exp(" + var + ")*sin(" + var + ")", var);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Integrate_Renamed);
+
 BENCHMARK_MAIN();
@@ -1,9 +1,22 @@
+#include <pybind11/complex.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include "mathllm/symbolic.h"
+#include "mathllm/canonical.h"
+#include "mathllm/integration.h"
+#include "mathllm/derivatives.h"
+#include "mathllm/egraph.h"
+#include "mathllm/intern.h"
+#include "mathllm/groebner.h"
 #include "mathllm/verifier.h"
 #include "mathllm/numeric.h"
+#include "mathllm/rational.h"
+#include "mathllm/roots.h"
+#include "mathllm/series.h"
+#include "mathllm/solution_set.h"
+#include "mathllm/solver.h"
+#include "mathllm/trig.h"
 #include "mathllm/units.h"
 #include "mathllm/ode.h"
 
@@ -21,14 +34,215 @@ PYBIND11_MODULE(mathcore, m) {
     
     m.def("integrate", &mathllm::integrate, 
           py::arg("expr"), py::arg("var"));
+    
+    py::class_<mathllm::IntegrationResult>(m, "IntegrationResult")
+        .def_readonly("antiderivative", &mathllm::IntegrationResult::antiderivative)
+        .def_readonly("rules_fired", &mathllm::IntegrationResult::rules_fired)
+        .def_readonly("steps_used", &mathllm::IntegrationResult::steps_used);
+    
+    m.def("integrate_traced", &mathllm::integrate_traced,
+          py::arg("expr"), py::arg("var"), py::arg("step_budget") = 512);
+    
+    py::class_<mathllm::DefiniteIntegralResult>(m, "DefiniteIntegralResult")
+        .def_readonly("value", &mathllm::DefiniteIntegralResult::value)
+        .def_readonly("error_estimate", &mathllm::DefiniteIntegralResult::error_estimate)
+        .def_readonly("evaluations", &mathllm::DefiniteIntegralResult::evaluations)
+        .def_readonly("converged", &mathllm::DefiniteIntegralResult::converged)
+        .def_readonly("method", &mathllm::DefiniteIntegralResult::method)
+        .def_readonly("antiderivative", &mathllm::DefiniteIntegralResult::antiderivative);
+    
+    m.def("integrate_definite", &mathllm::integrate_definite,
+          py::arg("expr"), py::arg("var"), py::arg("a"), py::arg("b"), py::arg("tol") = 1e-10);
+    m.def("integrate_nd", &mathllm::integrate_nd,
+          py::arg("expr"), py::arg("vars"), py::arg("bounds"),
+          py::arg("tol") = 1e-8, py::arg("seed") = 42);
+    
+    py::class_<mathllm::IntegrationMemoStats>(m, "IntegrationMemoStats")
+        .def_readonly("hits", &mathllm::IntegrationMemoStats::hits)
+        .def_readonly("misses", &mathllm::IntegrationMemoStats::misses)
+        .def_readonly("entries", &mathllm::IntegrationMemoStats::entries)
+        .def_readonly("capacity", &mathllm::IntegrationMemoStats::capacity)
+        .def_readonly("hit_rate", &mathllm::IntegrationMemoStats::hit_rate);
+    
+    m.def("integration_memo_stats", &mathllm::integration_memo_stats);
+    m.def("clear_integration_memo", &mathllm::clear_integration_memo);
+    m.def("set_integration_memo_capacity", &mathllm::set_integration_memo_capacity,
+          py::arg("capacity"));
+    m.def("load_integration_memo", &mathllm::load_integration_memo, py::arg("path"));
+    m.def("save_integration_memo", &mathllm::save_integration_memo, py::arg("path"));
+    
+    py::class_<mathllm::InternStats>(m, "InternStats")
+        .def_readonly("entries", &mathllm::InternStats::entries)
+        .def_readonly("capacity", &mathllm::InternStats::capacity)
+        .def_readonly("hits", &mathllm::InternStats::hits)
+        .def_readonly("misses", &mathllm::InternStats::misses)
+        .def_readonly("rejected", &mathllm::InternStats::rejected)
+        .def_readonly("retired", &mathllm::InternStats::retired)
+        .def_readonly("reclaimed", &mathllm::InternStats::reclaimed)
+        .def_readonly("epoch", &mathllm::InternStats::epoch);
+    
+    m.def("intern_stats", &mathllm::intern_stats);
+    m.def("set_intern_capacity", &mathllm::set_intern_capacity, py::arg("capacity"));
+    m.def("reclaim_interned", &mathllm::reclaim_interned);
+    m.def("clear_intern_table", &mathllm::clear_intern_table);
+    
+    py::class_<mathllm::AlphaCanonical>(m, "AlphaCanonical")
+        .def_readonly("exprs", &mathllm::AlphaCanonical::exprs)
+        .def_property_readonly("key", [](const mathllm::AlphaCanonical& canonical) { return canonical.key.hex(); })
+        .def_readonly("renaming", &mathllm::AlphaCanonical::renaming);
+    
+    m.def("alpha_canonicalize",
+          py::overload_cast<const std::string&, const std::vector<std::string>&>(&mathllm::alpha_canonicalize),
+          py::arg("expr"), py::arg("bound") = std::vector<std::string>(),
+          py::call_guard<py::gil_scoped_release>());
+    
+    py::class_<mathllm::AlphaCacheStats>(m, "AlphaCacheStats")
+        .def_readonly("hits", &mathllm::AlphaCacheStats::hits)
+        .def_readonly("misses", &mathllm::AlphaCacheStats::misses)
+        .def_readonly("entries", &mathllm::AlphaCacheStats::entries)
+        .def_readonly("capacity", &mathllm::AlphaCacheStats::capacity)
+        .def_readonly("hit_rate", &mathllm::AlphaCacheStats::hit_rate);
+    
+    m.def("alpha_cache_stats", &mathllm::alpha_cache_stats);
+    m.def("clear_alpha_cache", &mathllm::clear_alpha_cache);
+    m.def("set_alpha_cache_capacity", &mathllm::set_alpha_cache_capacity, py::arg("capacity"));
+    
     m.def("diff", &mathllm::diff,
           py::arg("expr"), py::arg("var"));
+    m.def("simplify", &mathllm::simplify,
+          py::arg("expr"), py::arg("budget_ms") = 100.0, py::arg("objective") = "ops",
+          py::call_guard<py::gil_scoped_release>());
+    
+    py::class_<mathllm::SaturationBudget>(m, "SaturationBudget")
+        .def(py::init<>())
+        .def_readwrite("time_ms", &mathllm::SaturationBudget::time_ms)
+        .def_readwrite("max_nodes", &mathllm::SaturationBudget::max_nodes)
+        .def_readwrite("max_iterations", &mathllm::SaturationBudget::max_iterations);
+    
+    py::class_<mathllm::SaturationStats>(m, "SaturationStats")
+        .def_readonly("iterations", &mathllm::SaturationStats::iterations)
+        .def_readonly("nodes", &mathllm::SaturationStats::nodes)
+        .def_readonly("classes", &mathllm::SaturationStats::classes)
+        .def_readonly("stop_reason", &mathllm::SaturationStats::stop_reason);
+    
+    py::class_<mathllm::EGraphSimplifyResult>(m, "EGraphSimplifyResult")
+        .def_readonly("expr", &mathllm::EGraphSimplifyResult::expr)
+        .def_readonly("cost", &mathllm::EGraphSimplifyResult::cost)
+        .def_readonly("stats", &mathllm::EGraphSimplifyResult::stats);
+    
+    py::class_<mathllm::EquivalenceResult>(m, "EquivalenceResult")
+        .def_readonly("equal", &mathllm::EquivalenceResult::equal)
+        .def_readonly("stats", &mathllm::EquivalenceResult::stats);
+    
+    m.def("egraph_simplify", &mathllm::egraph_simplify,
+          py::arg("expr"), py::arg("objective") = "ops", py::arg("budget") = mathllm::SaturationBudget(),
+          py::call_guard<py::gil_scoped_release>());
+    m.def("egraph_equivalent",
+          py::overload_cast<const std::string&, const std::string&, const mathllm::SaturationBudget&>(&mathllm::egraph_equivalent),
+          py::arg("lhs"), py::arg("rhs"), py::arg("budget") = mathllm::SaturationBudget(),
+          py::call_guard<py::gil_scoped_release>());
+    
+    py::class_<mathllm::RationalForm>(m, "RationalForm")
+        .def_readonly("numerator", &mathllm::RationalForm::numerator)
+        .def_readonly("denominator", &mathllm::RationalForm::denominator)
+        .def_readonly("generators", &mathllm::RationalForm::generators)
+        .def_readonly("reduced", &mathllm::RationalForm::reduced);
+    
+    m.def("rational_form", py::overload_cast<const std::string&>(&mathllm::rational_form),
+          py::arg("expr"), py::call_guard<py::gil_scoped_release>());
+    m.def("cancel", &mathllm::cancel,
+          py::arg("expr"), py::call_guard<py::gil_scoped_release>());
+    m.def("trig_canonical", &mathllm::trig_canonical,
+          py::arg("expr"), py::call_guard<py::gil_scoped_release>());
+    
+    py::class_<mathllm::DerivativeMatrix>(m, "DerivativeMatrix")
+        .def_property_readonly("rows", &mathllm::DerivativeMatrix::rows)
+        .def_property_readonly("cols", &mathllm::DerivativeMatrix::cols)
+        .def_property_readonly("vars", &mathllm::DerivativeMatrix::vars)
+        .def("__getitem__", [](const mathllm::DerivativeMatrix& matrix, std::pair<std::size_t, std::size_t> index) {
+            return matrix.at(index.first, index.second);
+        })
+        .def("to_strings", &mathllm::DerivativeMatrix::to_strings)
+        .def("evaluate",
+             py::overload_cast<const std::vector<double>&>(&mathllm::DerivativeMatrix::evaluate, py::const_),
+             py::arg("point"), py::call_guard<py::gil_scoped_release>());
+    
+    m.def("gradient", &mathllm::gradient, py::arg("expr"), py::arg("vars"));
+    m.def("jacobian", &mathllm::jacobian, py::arg("exprs"), py::arg("vars"));
+    m.def("hessian", &mathllm::hessian, py::arg("expr"), py::arg("vars"));
+    
+    py::class_<mathllm::SeriesResult>(m, "SeriesResult")
+        .def_readonly("expansion", &mathllm::SeriesResult::expansion)
+        .def_readonly("coefficients", &mathllm::SeriesResult::coefficients)
+        .def_readonly("valuation", &mathllm::SeriesResult::valuation)
+        .def_readonly("order", &mathllm::SeriesResult::order);
+    
+    m.def("series", &mathllm::series,
+          py::arg("expr"), py::arg("var"), py::arg("x0") = "0", py::arg("order") = 6);
+    
+    py::class_<mathllm::LimitResult>(m, "LimitResult")
+        .def_readonly("value", &mathllm::LimitResult::value)
+        .def_readonly("method", &mathllm::LimitResult::method)
+        .def_readonly("confidence", &mathllm::LimitResult::confidence)
+        .def_readonly("error_estimate", &mathllm::LimitResult::error_estimate);
+    
+    m.def("limit", &mathllm::limit,
+          py::arg("expr"), py::arg("var"), py::arg("point") = "0", py::arg("dir") = "+-");
     m.def("solve_equation", &mathllm::solve_equation,
           py::arg("lhs"), py::arg("rhs"), py::arg("var"));
+    
+    py::class_<mathllm::Expression>(m, "Expression")
+        .def_property_readonly("kind", &mathllm::Expression::kind)
+        .def_property_readonly("name", &mathllm::Expression::name)
+        .def_property_readonly("args", &mathllm::Expression::args)
+        .def_property_readonly("approximation", &mathllm::Expression::approximation)
+        .def("__str__", &mathllm::Expression::str)
+        .def("__repr__", [](const mathllm::Expression& expr) {
+            return "Expression(" + expr.str() + ")";
+        });
+    
+    py::class_<mathllm::SolutionElement>(m, "SolutionElement")
+        .def_readonly("value", &mathllm::SolutionElement::value)
+        .def_readonly("multiplicity", &mathllm::SolutionElement::multiplicity)
+        .def_readonly("approximation", &mathllm::SolutionElement::approximation);
+    
+    py::class_<mathllm::SolutionInterval>(m, "SolutionInterval")
+        .def_readonly("start", &mathllm::SolutionInterval::start)
+        .def_readonly("end", &mathllm::SolutionInterval::end)
+        .def_readonly("left_open", &mathllm::SolutionInterval::left_open)
+        .def_readonly("right_open", &mathllm::SolutionInterval::right_open);
+    
+    py::class_<mathllm::SolutionSet>(m, "SolutionSet")
+        .def_readonly("elements", &mathllm::SolutionSet::elements)
+        .def_readonly("intervals", &mathllm::SolutionSet::intervals)
+        .def_readonly("conditions", &mathllm::SolutionSet::conditions)
+        .def_readonly("method", &mathllm::SolutionSet::method)
+        .def("__str__", [](const mathllm::SolutionSet& set) { return set.str; });
+    
+    m.def("solve_equation_set", &mathllm::solve_equation_set,
+          py::arg("lhs"), py::arg("rhs"), py::arg("var"));
     m.def("verify_equal", 
           py::overload_cast<const std::string&, const std::string&, double>(&mathllm::verify_equal),
           py::arg("lhs"), py::arg("rhs"), py::arg("timeout_ms") = 1000.0);
     
+    py::class_<mathllm::CheckResult>(m, "CheckResult")
+        .def_readonly("ok", &mathllm::CheckResult::ok)
+        .def_readonly("method", &mathllm::CheckResult::method)
+        .def_readonly("residual", &mathllm::CheckResult::residual)
+        .def_readonly("max_error", &mathllm::CheckResult::max_error)
+        .def_readonly("trials", &mathllm::CheckResult::trials);
+    
+    py::class_<mathllm::RootCheckResult>(m, "RootCheckResult")
+        .def_readonly("ok", &mathllm::RootCheckResult::ok)
+        .def_readonly("roots", &mathllm::RootCheckResult::roots);
+    
+    m.def("check_antiderivative", &mathllm::check_antiderivative,
+          py::arg("F"), py::arg("f"), py::arg("var"));
+    m.def("check_roots", &mathllm::check_roots,
+          py::arg("expr"), py::arg("var"), py::arg("roots"));
+    m.def("check_ode_solution", &mathllm::check_ode_solution,
+          py::arg("y_expr"), py::arg("rhs"), py::arg("t"), py::arg("y") = "y");
+    
     py::class_<mathllm::ProbeResult>(m, "ProbeResult")
         .def_readonly("equal", &mathllm::ProbeResult::equal)
         .def_readonly("trials_executed", &mathllm::ProbeResult::trials_executed)
@@ -43,6 +257,95 @@ PYBIND11_MODULE(mathcore, m) {
           py::arg("domain_max") = 2.0,
           py::arg("threshold") = 1e-6);
     
+    py::class_<mathllm::PolynomialRoot>(m, "PolynomialRoot")
+        .def_readonly("value", &mathllm::PolynomialRoot::value)
+        .def_readonly("multiplicity", &mathllm::PolynomialRoot::multiplicity)
+        .def_readonly("error_estimate", &mathllm::PolynomialRoot::error_estimate);
+    
+    py::class_<mathllm::RootFinderResult>(m, "RootFinderResult")
+        .def_readonly("roots", &mathllm::RootFinderResult::roots)
+        .def_readonly("iterations", &mathllm::RootFinderResult::iterations)
+        .def_readonly("converged", &mathllm::RootFinderResult::converged)
+        .def_readonly("method", &mathllm::RootFinderResult::method);
+    
+    m.def("find_polynomial_roots", &mathllm::find_polynomial_roots,
+          py::arg("coeffs"), py::arg("tol") = 1e-14, py::arg("max_iterations") = 200);
+    py::class_<mathllm::RealRoot>(m, "RealRoot")
+        .def_readonly("value", &mathllm::RealRoot::value)
+        .def_readonly("error_bound", &mathllm::RealRoot::error_bound)
+        .def_readonly("verified", &mathllm::RealRoot::verified);
+    
+    py::class_<mathllm::RealRootsResult>(m, "RealRootsResult")
+        .def_readonly("roots", &mathllm::RealRootsResult::roots)
+        .def_readonly("complete", &mathllm::RealRootsResult::complete)
+        .def_readonly("evaluations", &mathllm::RealRootsResult::evaluations);
+    
+    m.def("find_real_roots",
+          py::overload_cast<const std::string&, const std::string&, const std::string&, double, double, double>(
+              &mathllm::find_real_roots),
+          py::arg("lhs"), py::arg("rhs"), py::arg("var"), py::arg("lower"), py::arg("upper"),
+          py::arg("tol") = 1e-12);
+    py::class_<mathllm::SystemSolveResult>(m, "SystemSolveResult")
+        .def_readonly("solution", &mathllm::SystemSolveResult::solution)
+        .def_readonly("residual_norm", &mathllm::SystemSolveResult::residual_norm)
+        .def_readonly("iterations", &mathllm::SystemSolveResult::iterations)
+        .def_readonly("converged", &mathllm::SystemSolveResult::converged)
+        .def_readonly("start_index", &mathllm::SystemSolveResult::start_index);
+    
+    m.def("solve_system", &mathllm::solve_system,
+          py::arg("equations"), py::arg("vars"), py::arg("x0"),
+          py::arg("tol") = 1e-10, py::arg("max_iterations") = 100);
+    m.def("solve_system_multistart", &mathllm::solve_system_multistart,
+          py::arg("equations"), py::arg("vars"), py::arg("starts"),
+          py::arg("tol") = 1e-10, py::arg("max_iterations") = 100);
+    py::class_<mathllm::LinearSolveResult>(m, "LinearSolveResult")
+        .def_readonly("status", &mathllm::LinearSolveResult::status)
+        .def_readonly("rank", &mathllm::LinearSolveResult::rank)
+        .def_readonly("solution", &mathllm::LinearSolveResult::solution)
+        .def_readonly("values", &mathllm::LinearSolveResult::values)
+        .def_readonly("nullspace", &mathllm::LinearSolveResult::nullspace)
+        .def_readonly("method", &mathllm::LinearSolveResult::method);
+    
+    m.def("solve_linear_system", &mathllm::solve_linear_system,
+          py::arg("equations"), py::arg("vars"));
+    py::class_<mathllm::ParametricCase>(m, "ParametricCase")
+        .def_readonly("condition", &mathllm::ParametricCase::condition)
+        .def_readonly("solutions", &mathllm::ParametricCase::solutions);
+    
+    py::class_<mathllm::ParametricSolution>(m, "ParametricSolution")
+        .def_property_readonly("cases", &mathllm::ParametricSolution::cases)
+        .def_property_readonly("width", &mathllm::ParametricSolution::width)
+        .def("evaluate", &mathllm::ParametricSolution::evaluate, py::arg("points"),
+             py::call_guard<py::gil_scoped_release>());
+    
+    m.def("solve_parametric", &mathllm::solve_parametric,
+          py::arg("lhs"), py::arg("rhs"), py::arg("var"), py::arg("params"));
+    py::class_<mathllm::GroebnerBudget>(m, "GroebnerBudget")
+        .def(py::init<>())
+        .def_readwrite("time_ms", &mathllm::GroebnerBudget::time_ms)
+        .def_readwrite("max_terms", &mathllm::GroebnerBudget::max_terms);
+    
+    py::class_<mathllm::GroebnerResult>(m, "GroebnerResult")
+        .def_readonly("basis", &mathllm::GroebnerResult::basis)
+        .def_readonly("complete", &mathllm::GroebnerResult::complete)
+        .def_readonly("pairs_processed", &mathllm::GroebnerResult::pairs_processed)
+        .def_readonly("zero_reductions", &mathllm::GroebnerResult::zero_reductions);
+    
+    py::class_<mathllm::PolynomialSystemResult>(m, "PolynomialSystemResult")
+        .def_readonly("status", &mathllm::PolynomialSystemResult::status)
+        .def_readonly("solutions", &mathllm::PolynomialSystemResult::solutions)
+        .def_readonly("triangular_sets", &mathllm::PolynomialSystemResult::triangular_sets)
+        .def_readonly("exact", &mathllm::PolynomialSystemResult::exact);
+    
+    m.def("groebner_basis", &mathllm::groebner_basis,
+          py::arg("polys"), py::arg("vars"), py::arg("order") = "grevlex", py::arg("modulus") = 0,
+          py::arg("budget") = mathllm::GroebnerBudget());
+    m.def("solve_polynomial_system", &mathllm::solve_polynomial_system,
+          py::arg("equations"), py::arg("vars"), py::arg("budget") = mathllm::GroebnerBudget());
+    m.def("find_polynomial_roots_batch", &mathllm::find_polynomial_roots_batch,
+          py::arg("polys"), py::arg("tol") = 1e-14, py::arg("max_iterations") = 200,
+          py::call_guard<py::gil_scoped_release>());
+    
     py::class_<mathllm::Dimension>(m, "Dimension")
         .def(py::init<>())
         .def(py::init<int, int, int, int, int, int, int>(),
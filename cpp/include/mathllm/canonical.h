@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <symengine/basic.h>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+// Two 64-bit FNV-1a digests of a canonical serialization, read forwards
+// and backwards; the same on every run against one SymEngine build.
+struct CanonicalKey {
+    std::uint64_t high;
+    std::uint64_t low;
+
+    bool operator==(const CanonicalKey& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const CanonicalKey& other) const { return !(*this == other); }
+    // 32 lowercase hex digits, high word first.
+    std::string hex() const;
+};
+
+struct AlphaCanonical {
+    // The inputs with every free symbol renamed to _0, _1, ...
+    std::vector<Expression> exprs;
+    CanonicalKey key;
+    // (caller's name, canonical name) in the order the names were given.
+    std::vector<std::pair<std::string, std::string>> renaming;
+
+    SymEngine::RCP<const SymEngine::Basic> to_canonical(const SymEngine::RCP<const SymEngine::Basic>& expr) const;
+    SymEngine::RCP<const SymEngine::Basic> to_caller(const SymEngine::RCP<const SymEngine::Basic>& expr) const;
+};
+
+// Renames the free symbols of exprs so that problems differing only in
+// variable names share one key: the bound names (an integration or
+// solve variable, in the given order) come first, then the remaining
+// symbols by first occurrence in a traversal that visits the operands of
+// sums and products in an order that does not depend on names. The key
+// hashes the renamed inputs with operands of sums and products sorted,
+// so it ignores operand order too. Renamings that only tie-breaking
+// could tell apart may still give different keys; equal keys always mean
+// equal renamed inputs.
+AlphaCanonical alpha_canonicalize(
+    const std::vector<SymEngine::RCP<const SymEngine::Basic>>& exprs,
+    const std::vector<std::string>& bound = {}
+);
+AlphaCanonical alpha_canonicalize(const std::string& expr, const std::vector<std::string>& bound = {});
+
+struct AlphaCacheStats {
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t entries;
+    std::size_t capacity;
+    double hit_rate;
+};
+
+// A result stored in canonical names: an antiderivative or derivative in
+// values[0], the finite solutions of an equation with their
+// multiplicities and method, or a verification verdict.
+struct AlphaCachedResult {
+    SymEngine::vec_basic values;
+    std::vector<int> multiplicities;
+    std::string method;
+    bool verdict = false;
+};
+
+// Process-wide LRU of results keyed by operation name and canonical key;
+// integrate, diff, solve_equation and verify_equal consult it. Safe to
+// share between threads. Capacity 0 disables it.
+bool alpha_cache_lookup(const std::string& operation, const CanonicalKey& key, AlphaCachedResult& out);
+void alpha_cache_store(const std::string& operation, const CanonicalKey& key, const AlphaCachedResult& result);
+AlphaCacheStats alpha_cache_stats();
+void clear_alpha_cache();
+void set_alpha_cache_capacity(std::size_t capacity);
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "errors.hpp"
+#include "expression.h"
+#include "numeric.h"
+
+namespace mathllm {
+
+// Matrix of derivatives, kept as expression handles. All entries are
+// compiled into one tape, so evaluating the matrix at a point costs one pass
+// over the subexpressions the entries share.
+class DerivativeMatrix {
+public:
+    DerivativeMatrix(
+        std::size_t rows,
+        std::size_t cols,
+        std::vector<Expression> entries,
+        const std::vector<std::string>& vars
+    );
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    const Expression& at(std::size_t row, std::size_t col) const;
+    std::vector<std::vector<std::string>> to_strings() const;
+    const std::vector<std::string>& vars() const { return vars_; }
+
+    // point holds one value per variable; out receives rows() x cols()
+    // values, row-major. Throws NumericError if some entry uses a function
+    // the tape cannot evaluate.
+    void evaluate(const double* point, double* out) const;
+    std::vector<std::vector<double>> evaluate(const std::vector<double>& point) const;
+    // points is row-major (count x vars().size()); out receives count
+    // matrices back to back.
+    void evaluate_batch(const double* points, std::size_t count, double* out) const;
+
+private:
+    const CompiledExpr& compiled() const;
+
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<Expression> entries_;
+    std::vector<std::string> vars_;
+    std::shared_ptr<const CompiledExpr> compiled_;
+    std::string compile_error_;
+};
+
+// The expressions are parsed once and differentiated with one memoizing
+// differentiator per variable, so subexpressions shared between entries are
+// differentiated once. Throw SymbolicError for unparsable input.
+
+// 1 x n matrix of the partial derivatives of expr.
+DerivativeMatrix gradient(const std::string& expr, const std::vector<std::string>& vars);
+// m x n matrix: row i is the gradient of exprs[i].
+DerivativeMatrix jacobian(const std::vector<std::string>& exprs, const std::vector<std::string>& vars);
+// n x n matrix of second partial derivatives. Only the upper triangle is
+// differentiated; the lower one is its mirror.
+DerivativeMatrix hessian(const std::string& expr, const std::vector<std::string>& vars);
+
+}
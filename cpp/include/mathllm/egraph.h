@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <symengine/basic.h>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+struct SaturationBudget {
+    double time_ms = 200.0;
+    // Saturation stops once the graph holds this many e-nodes.
+    std::size_t max_nodes = 10000;
+    int max_iterations = 16;
+};
+
+struct SaturationStats {
+    int iterations;
+    std::size_t nodes;
+    std::size_t classes;
+    // "saturated" when no rule adds anything new, "goal" when the caller's
+    // goal was reached, or "time", "nodes" or "iterations" for the budget
+    // limit that ended the run.
+    std::string stop_reason;
+};
+
+// E-graph over SymEngine nodes. Each e-node is an operator (Add, Mul, Pow,
+// a function, or a leaf such as a number or symbol) applied to e-classes;
+// sums and products keep their operand classes sorted, so operand order
+// does not matter. Merging two classes restores congruence closure on
+// rebuild(), so an equality proved for a subterm is shared by every term
+// containing it.
+class EGraph {
+public:
+    using ClassId = std::size_t;
+
+    struct ENode {
+        // The node this e-node was made from. Its type selects the
+        // operator; a leaf is the node itself.
+        SymEngine::RCP<const SymEngine::Basic> head;
+        std::vector<ClassId> children;
+    };
+
+    // Class of expr, inserting expr and its subterms as needed.
+    ClassId add(const SymEngine::RCP<const SymEngine::Basic>& expr);
+    ClassId find(ClassId id) const;
+    // Returns false if a and b already were in one class. Call rebuild()
+    // before querying the graph again.
+    bool merge(ClassId a, ClassId b);
+    void rebuild();
+    bool equivalent(ClassId a, ClassId b) const { return find(a) == find(b); }
+
+    // Applies the rule library until nothing new is added, goal (when
+    // given) returns true, or the budget runs out. Rules cover the
+    // Pythagorean identities (circular and hyperbolic), angle addition and
+    // multiple angles, tan/cot/sec/csc/tanh as quotients, sinh and cosh as
+    // exponentials, exp/log contraction, expansion and common factors, and
+    // sums and products re-collected by SymEngine across classes.
+    SaturationStats saturate(
+        const SaturationBudget& budget,
+        const std::function<bool(const EGraph&)>& goal = nullptr
+    );
+
+    // Cheapest term of the class under a simplify() objective ("ops" or
+    // "nodes").
+    SymEngine::RCP<const SymEngine::Basic> extract(ClassId id, const std::string& objective) const;
+    // Cheapest term of every class, indexed by canonical class id; null for
+    // classes that are not canonical.
+    std::vector<SymEngine::RCP<const SymEngine::Basic>> extract_all(const std::string& objective) const;
+
+    const std::vector<ENode>& nodes(ClassId id) const { return classes_[find(id)]; }
+    std::size_t node_count() const;
+    std::size_t class_count() const;
+
+private:
+    struct NodeHash {
+        std::size_t operator()(const ENode& node) const;
+    };
+    struct NodeEqual {
+        bool operator()(const ENode& a, const ENode& b) const;
+    };
+
+    ENode canonical(const ENode& node) const;
+    ClassId insert(ENode node);
+
+    mutable std::vector<ClassId> parent_;
+    std::vector<std::vector<ENode>> classes_;
+    std::unordered_map<ENode, ClassId, NodeHash, NodeEqual> memo_;
+};
+
+struct EGraphSimplifyResult {
+    Expression expr;
+    double cost;
+    SaturationStats stats;
+};
+
+struct EquivalenceResult {
+    bool equal;
+    SaturationStats stats;
+};
+
+// Saturates the graph of expr and extracts its cheapest term under a
+// simplify() objective. Throws SymbolicError for unparsable input or an
+// unknown objective.
+EGraphSimplifyResult egraph_simplify(
+    const std::string& expr,
+    const std::string& objective = "ops",
+    const SaturationBudget& budget = SaturationBudget()
+);
+
+// True when lhs and rhs end up in one class, or their cheapest terms
+// differ by something that expands to zero. False means not proved, not
+// proved different.
+EquivalenceResult egraph_equivalent(
+    const SymEngine::RCP<const SymEngine::Basic>& lhs,
+    const SymEngine::RCP<const SymEngine::Basic>& rhs,
+    const SaturationBudget& budget = SaturationBudget()
+);
+EquivalenceResult egraph_equivalent(
+    const std::string& lhs,
+    const std::string& rhs,
+    const SaturationBudget& budget = SaturationBudget()
+);
+
+}
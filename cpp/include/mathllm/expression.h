@@ -0,0 +1,36 @@
+#pragma once
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <symengine/basic.h>
+
+namespace mathllm {
+
+// Immutable handle to a SymEngine expression. Bindings walk it through
+// kind(), name() and args() instead of reparsing its printed form.
+class Expression {
+public:
+    explicit Expression(SymEngine::RCP<const SymEngine::Basic> expr) : expr_(std::move(expr)) {}
+
+    const SymEngine::RCP<const SymEngine::Basic>& get() const { return expr_; }
+    std::string str() const { return expr_->__str__(); }
+
+    // "Integer", "Rational", "Float", "Complex", "Symbol", "Constant",
+    // "Infinity", "Add", "Mul", "Pow", "Function" or "Other".
+    std::string kind() const;
+    // Decimal digits of an Integer; the name of a Symbol, Constant or
+    // Function; "oo", "-oo" or "zoo" for Infinity; empty otherwise.
+    std::string name() const;
+    // Numerator and denominator of a Rational, real and imaginary parts of
+    // a Complex, the operands of anything else.
+    std::vector<Expression> args() const;
+    // NaN when the expression has free symbols or cannot be evaluated.
+    std::complex<double> approximation() const;
+
+private:
+    SymEngine::RCP<const SymEngine::Basic> expr_;
+};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "errors.hpp"
+
+namespace mathllm {
+
+struct GroebnerBudget {
+    double time_ms = 5000.0;
+    // Cap on the terms held by basis polynomials and reductions in flight.
+    std::size_t max_terms = 1000000;
+};
+
+struct GroebnerResult {
+    // Reduced basis: monic, sorted by decreasing leading monomial. When the
+    // budget ran out this is the partial, unreduced basis.
+    std::vector<std::string> basis;
+    bool complete;
+    int pairs_processed;
+    int zero_reductions;
+};
+
+struct PolynomialSystemResult {
+    // "finite", "infinite", "inconsistent" or "budget_exceeded".
+    std::string status;
+    // One value per variable for each solution. Values are exact
+    // (rationals, radicals) where the triangular sets allow it.
+    std::vector<std::vector<std::string>> solutions;
+    // Lex Groebner bases of the components the system splits into, each
+    // triangular for a zero-dimensional system.
+    std::vector<std::vector<std::string>> triangular_sets;
+    // False when some component was completed numerically; only its real
+    // solutions are reported then.
+    bool exact;
+};
+
+// Groebner basis of the ideal generated by polys (expressions or
+// "lhs = rhs" equations with rational coefficients) by Buchberger's
+// algorithm with the sugar selection strategy and the Gebauer-Moeller
+// criteria. order is "lex" or "grevlex" with vars[0] > vars[1] > ...;
+// modulus 0 works over the rationals, a prime below 2^31 over GF(p).
+// Throws SymbolicError for non-polynomial input and NumericError for an
+// invalid order or modulus.
+GroebnerResult groebner_basis(
+    const std::vector<std::string>& polys,
+    const std::vector<std::string>& vars,
+    const std::string& order = "grevlex",
+    std::uint32_t modulus = 0,
+    const GroebnerBudget& budget = GroebnerBudget()
+);
+
+// Solves a polynomial system over the complex numbers. The lex basis is
+// split along the factors of its univariate polynomial in the last
+// variable: rational roots are substituted exactly and the system is
+// solved recursively; the remaining factor is solved in radicals when its
+// component is in shape position (every other variable a polynomial in the
+// last one) and numerically otherwise. The budget covers the whole solve.
+PolynomialSystemResult solve_polynomial_system(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const GroebnerBudget& budget = GroebnerBudget()
+);
+
+}
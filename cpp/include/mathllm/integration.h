@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <symengine/basic.h>
+#include <symengine/symbol.h>
+
+#include "errors.hpp"
+
+namespace mathllm {
+
+struct IntegrationContext {
+    int step_budget = 512;
+    int steps_used = 0;
+    int parts_depth = 0;
+    int max_parts_depth = 4;
+    // Consult and fill the process-wide antiderivative memo.
+    bool use_memo = true;
+    std::vector<std::string> rules_fired;
+};
+
+struct IntegrationResult {
+    std::string antiderivative;
+    std::vector<std::string> rules_fired;
+    int steps_used;
+};
+
+struct DefiniteIntegralResult {
+    double value;
+    double error_estimate;
+    int evaluations;
+    bool converged;
+    // "symbolic", "gauss_kronrod", "tanh_sinh", "cubature" or "qmc".
+    std::string method;
+    // Antiderivative used on the symbolic path, empty otherwise.
+    std::string antiderivative;
+};
+
+struct IntegrationMemoStats {
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t entries;
+    std::size_t capacity;
+    double hit_rate;
+};
+
+// Rule-engine entry point shared by integrate() and the other calculus
+// modules. Throws SymbolicError when no rule matches or the step budget
+// in ctx is exhausted. Every sub-integral goes through the antiderivative
+// memo unless ctx.use_memo is false; a hit is traced as "memo".
+SymEngine::RCP<const SymEngine::Basic> integrate_expr(
+    const SymEngine::RCP<const SymEngine::Basic>& expr,
+    const SymEngine::RCP<const SymEngine::Symbol>& var,
+    IntegrationContext& ctx
+);
+
+// Bypasses the memo so the trace lists every rule behind the result.
+IntegrationResult integrate_traced(
+    const std::string& expr,
+    const std::string& var,
+    int step_budget = 512
+);
+
+// Integral of expr over [a, b]; either limit may be infinite. For finite
+// limits the antiderivative is evaluated at the limits, provided it and the
+// integrand pass a finiteness and jump screen on a grid over [a, b].
+// Otherwise adaptive G7K15 runs on the compiled integrand, with tanh-sinh
+// taking over for endpoint singularities or when G7K15 does not converge.
+// Throws SymbolicError on parse errors and NumericError when the integrand
+// cannot be evaluated.
+DefiniteIntegralResult integrate_definite(
+    const std::string& expr,
+    const std::string& var,
+    double a,
+    double b,
+    double tol = 1e-10
+);
+
+// Integral of expr over the box bounds[i] = (lower, upper) for vars[i].
+// One variable goes through integrate_definite; up to six use adaptive
+// Genz-Malik cubature and more use randomized QMC seeded by seed. Both
+// run on the compiled integrand in batches. Bounds must be finite.
+DefiniteIntegralResult integrate_nd(
+    const std::string& expr,
+    const std::vector<std::string>& vars,
+    const std::vector<std::pair<double, double>>& bounds,
+    double tol = 1e-8,
+    unsigned int seed = 42
+);
+
+// Process-wide LRU memo of successful antiderivatives keyed by the
+// integrand's structural hash and the variable; safe to share between
+// threads. Capacity 0 disables it.
+IntegrationMemoStats integration_memo_stats();
+void clear_integration_memo();
+void set_integration_memo_capacity(std::size_t capacity);
+
+// Warm-start files hold one "var<TAB>integrand<TAB>antiderivative" entry
+// per line; blank lines and lines starting with '#' are skipped. Loaded
+// entries are kept only if check_antiderivative accepts them. Both return
+// the number of entries transferred and throw SymbolicError on I/O or
+// parse failures.
+std::size_t load_integration_memo(const std::string& path);
+std::size_t save_integration_memo(const std::string& path);
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <symengine/basic.h>
+
+namespace mathllm {
+
+struct InternStats {
+    std::size_t entries;
+    std::size_t capacity;
+    std::size_t hits;
+    std::size_t misses;
+    // Nodes inserted past capacity when nothing could be reclaimed are
+    // returned uninterned.
+    std::size_t rejected;
+    // Entries retired because only the table still held them, and the
+    // retired nodes since released.
+    std::size_t retired;
+    std::size_t reclaimed;
+    std::uint64_t epoch;
+};
+
+// Canonical node for expr from a process-wide hash-cons table keyed by
+// structural hash: structurally equal expressions intern to the same
+// pointer, and interned subterms are shared by every node built on them,
+// so equality of interned nodes is pointer comparison. Safe to call from
+// several threads; the table is split into independently locked shards.
+SymEngine::RCP<const SymEngine::Basic> intern(const SymEngine::RCP<const SymEngine::Basic>& expr);
+
+// Whether expr is the canonical node of its structure.
+bool is_interned(const SymEngine::RCP<const SymEngine::Basic>& expr);
+
+// While a pin is alive, no node retired from the table is released, so a
+// cache keyed on raw node addresses cannot see an address reused for a
+// different expression. Retired nodes are released once every pin taken
+// before their retirement has ended.
+class InternPin {
+public:
+    InternPin();
+    ~InternPin();
+    InternPin(const InternPin&) = delete;
+    InternPin& operator=(const InternPin&) = delete;
+
+    std::uint64_t epoch() const { return epoch_; }
+
+private:
+    std::uint64_t epoch_;
+};
+
+// Capacity is the maximum number of entries. Reaching it retires entries
+// that only the table references; a capacity of 0 disables interning.
+InternStats intern_stats();
+void set_intern_capacity(std::size_t capacity);
+// Retires every unreferenced entry and releases what no pin protects.
+// Returns the number of entries retired.
+std::size_t reclaim_interned();
+void clear_intern_table();
+
+}
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
+
+#include <symengine/basic.h>
+
 #include "errors.hpp"
 
 namespace mathllm {
@@ -25,4 +30,64 @@ ProbeResult probe_equal(
     double threshold = 1e-6
 );
 
+// Expression compiled to a flat instruction tape. Symbol-free subtrees are
+// folded to constants and repeated subexpressions share one slot, so
+// evaluation is a single pass with no map lookups. evaluate_batch runs each
+// instruction over a block of points at a time. Several expressions can be
+// compiled into one tape, sharing the subexpressions they have in common.
+class CompiledExpr {
+public:
+    CompiledExpr(const SymEngine::RCP<const SymEngine::Basic>& expr, const std::vector<std::string>& symbols);
+    CompiledExpr(const std::string& expr, const std::vector<std::string>& symbols);
+    CompiledExpr(const SymEngine::vec_basic& exprs, const std::vector<std::string>& symbols);
+
+    // point holds one value per symbol, in constructor order. Returns the
+    // first output.
+    double evaluate(const double* point) const;
+    double evaluate(const std::vector<double>& point) const;
+    // out receives num_outputs() values.
+    void evaluate_all(const double* point, double* out) const;
+    // points is row-major (count x num_symbols()); out is row-major
+    // (count x num_outputs()).
+    void evaluate_batch(const double* points, std::size_t count, double* out) const;
+    // Interval extension over the box lower[i] <= x_i <= upper[i]: [lo, hi]
+    // encloses every value the expression takes there, with each step
+    // widened by one ulp to cover rounding. lo > hi means the expression is
+    // undefined on the whole box. Covers the first output.
+    void evaluate_interval(const double* lower, const double* upper, double& lo, double& hi) const;
+
+    std::size_t num_symbols() const { return num_symbols_; }
+    std::size_t num_outputs() const { return outputs_.size(); }
+    std::size_t size() const { return tape_.size(); }
+
+private:
+    enum class Op {
+        Const, Var, Add, Mul, Pow, Square, Sqrt, Recip,
+        Exp, Log, Sin, Cos, Tan, Cot, Sec, Csc, Asin, Acos, Atan,
+        Sinh, Cosh, Tanh, Abs
+    };
+
+    struct Instr {
+        Op op;
+        int lhs;
+        int rhs;
+        double value;
+    };
+
+    void init(const SymEngine::vec_basic& exprs, const std::vector<std::string>& symbols);
+    int compile(const SymEngine::RCP<const SymEngine::Basic>& expr);
+    int emit(Op op, int lhs, int rhs = -1, double value = 0.0);
+    static void execute(Op op, double* dst, const double* lhs, const double* rhs, std::size_t n);
+    // Runs the tape over n <= stride points; regs holds size() * stride values.
+    void run(const double* points, std::size_t n, std::size_t stride, double* regs, double* out) const;
+
+    std::vector<Instr> tape_;
+    // Slot of each output.
+    std::vector<int> outputs_;
+    std::map<std::string, int> symbol_index_;
+    std::unordered_map<SymEngine::RCP<const SymEngine::Basic>, int,
+                       SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq> slots_;
+    std::size_t num_symbols_ = 0;
+};
+
 }
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+#include <symengine/basic.h>
+#include <symengine/number.h>
+#include <symengine/symbol.h>
+
+#include "errors.hpp"
+
+namespace mathllm {
+
+// Dense univariate polynomial with exact rational coefficients;
+// coeffs()[i] multiplies var^i. The zero polynomial has degree -1.
+class DensePoly {
+public:
+    using Coeff = SymEngine::RCP<const SymEngine::Number>;
+    // Largest degree the conversions accept. Higher exponents are left to
+    // SymEngine instead of allocating a dense coefficient vector.
+    static constexpr int kMaxDegree = 4096;
+
+    DensePoly() = default;
+    explicit DensePoly(std::vector<Coeff> coeffs);
+
+    static DensePoly constant(const Coeff& value);
+    static DensePoly monomial(const Coeff& value, int degree);
+
+    // Returns false if expr is not a polynomial in var with exact rational
+    // coefficients and degree at most kMaxDegree. Non-polynomial trees are
+    // rejected before expanding.
+    static bool from_basic(
+        const SymEngine::RCP<const SymEngine::Basic>& expr,
+        const SymEngine::RCP<const SymEngine::Symbol>& var,
+        DensePoly& out
+    );
+    // Like from_basic but never expands: succeeds only when expr already is
+    // a sum of c*var^k terms, so its tree maps directly onto coefficients.
+    static bool from_expanded(
+        const SymEngine::RCP<const SymEngine::Basic>& expr,
+        const SymEngine::RCP<const SymEngine::Symbol>& var,
+        DensePoly& out
+    );
+    SymEngine::RCP<const SymEngine::Basic> to_basic(const SymEngine::RCP<const SymEngine::Symbol>& var) const;
+
+    int degree() const { return static_cast<int>(coeffs_.size()) - 1; }
+    bool is_zero() const { return coeffs_.empty(); }
+    const std::vector<Coeff>& coeffs() const { return coeffs_; }
+    Coeff coeff(int i) const;
+    Coeff leading_coeff() const;
+
+    DensePoly operator+(const DensePoly& other) const;
+    DensePoly operator-(const DensePoly& other) const;
+    DensePoly operator*(const DensePoly& other) const;
+    DensePoly scale(const Coeff& factor) const;
+    DensePoly monic() const;
+    DensePoly derivative() const;
+    DensePoly antiderivative() const;
+    Coeff evaluate(const Coeff& x) const;
+
+    static void divmod(const DensePoly& a, const DensePoly& b, DensePoly& quotient, DensePoly& remainder);
+    // Monic gcd; s*a + t*b == gcd on return.
+    static DensePoly extended_gcd(const DensePoly& a, const DensePoly& b, DensePoly& s, DensePoly& t);
+    static DensePoly gcd(const DensePoly& a, const DensePoly& b);
+
+    // Yun's algorithm: result[i] is the monic product of the irreducible
+    // factors of multiplicity i + 1.
+    std::vector<DensePoly> square_free() const;
+    // Distinct rational roots via the rational root theorem. Gives up on
+    // candidates once the integerised end coefficients exceed 10^6.
+    std::vector<Coeff> rational_roots() const;
+    // Product of the distinct irreducible factors (p / gcd(p, p')), monic.
+    DensePoly square_free_part() const;
+
+private:
+    void trim();
+
+    std::vector<Coeff> coeffs_;
+};
+
+// Distinct complex roots. Rational roots are split off exactly, a
+// remaining factor of degree <= 4 is solved in radicals, and anything of
+// higher degree is solved numerically.
+SymEngine::vec_basic polynomial_roots(const DensePoly& poly);
+
+// All complex roots, each repeated by its multiplicity, from
+// find_polynomial_roots on the coefficients rounded to double.
+std::vector<std::complex<double>> numeric_roots(const DensePoly& poly);
+
+// Distinct roots of expr as a polynomial in var whose coefficients are
+// numbers of any kind (floats included), as RealDouble or ComplexDouble.
+// Returns false if expr is not such a polynomial of degree >= 1. When
+// multiplicities is given it receives the multiplicity of each root.
+bool numeric_polynomial_roots(
+    const SymEngine::RCP<const SymEngine::Basic>& expr,
+    const SymEngine::RCP<const SymEngine::Symbol>& var,
+    SymEngine::vec_basic& roots,
+    std::vector<int>* multiplicities = nullptr
+);
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "errors.hpp"
+
+namespace mathllm {
+
+// Vectorized integrand: writes f(x[i]) to out[i] for i < count. For
+// multi-dimensional rules x holds count points row-major (count x dim).
+using BatchFunction = std::function<void(const double* x, std::size_t count, double* out)>;
+
+struct QuadratureResult {
+    double value;
+    double error_estimate;
+    int evaluations;
+    bool converged;
+};
+
+// Globally adaptive Gauss-Kronrod (G7K15): the interval with the largest
+// |K15 - G7| is bisected until the summed estimate meets the tolerance.
+// Infinite limits are mapped onto a finite interval. Throws NumericError if
+// the integrand is not finite at a sample point.
+QuadratureResult gauss_kronrod(
+    const BatchFunction& f,
+    double a,
+    double b,
+    double abs_tol = 1e-10,
+    double rel_tol = 1e-10,
+    int max_intervals = 500
+);
+
+// Tanh-sinh (double exponential) quadrature, halving the step each level.
+// Nodes cluster at the endpoints without touching them, so integrable
+// endpoint singularities converge; non-finite values right at an endpoint
+// are dropped, anywhere else they raise NumericError.
+QuadratureResult tanh_sinh(
+    const BatchFunction& f,
+    double a,
+    double b,
+    double abs_tol = 1e-10,
+    double rel_tol = 1e-10,
+    int max_levels = 10
+);
+
+// Adaptive Genz-Malik cubature (degree 7 with an embedded degree 5 error
+// estimate) over the box [lower, upper], for 2 <= dim <= 10. Each round
+// bisects the regions with the largest errors along their roughest axis;
+// the new regions are evaluated in parallel when built with OpenMP.
+QuadratureResult adaptive_cubature(
+    const BatchFunction& f,
+    const std::vector<double>& lower,
+    const std::vector<double>& upper,
+    double abs_tol = 1e-8,
+    double rel_tol = 1e-8,
+    int max_evaluations = 2000000
+);
+
+// Randomized quasi-Monte Carlo over the box [lower, upper]: `replicas`
+// independent random shifts of a Kronecker (R_d) lattice with `samples`
+// points each, folded with the baker's transform. The error estimate is the standard error across replicas.
+// Replicas run in parallel when built with OpenMP; the shifts come from
+// seed alone, so results do not depend on the thread count.
+QuadratureResult qmc_integrate(
+    const BatchFunction& f,
+    const std::vector<double>& lower,
+    const std::vector<double>& upper,
+    double abs_tol = 1e-6,
+    double rel_tol = 1e-6,
+    int samples = 1 << 16,
+    int replicas = 16,
+    unsigned int seed = 42
+);
+
+}
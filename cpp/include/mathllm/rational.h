@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <symengine/basic.h>
+#include <symengine/tribool.h>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+struct RationalForm {
+    // Coprime polynomials with integer coefficients; the denominator's
+    // leading coefficient is positive. Two expressions whose forms have the
+    // same generators are equal as rational functions iff the forms match.
+    Expression numerator;
+    Expression denominator;
+    // Subterms taken as independent variables: symbols and every
+    // non-rational subterm (sin(x), x^(1/2), floats, ...). Function
+    // arguments are put in normal form first, so sin((x^2 - 1)/(x - 1)) and
+    // sin(x + 1) are one generator.
+    std::vector<Expression> generators;
+    // False when the heuristic gcd gave up and a common factor may be left.
+    bool reduced;
+};
+
+// Combines expr into one fraction over the generators and cancels the gcd
+// of numerator and denominator, computed by the heuristic gcd (GCDHEU):
+// the polynomials are evaluated at a large integer variable by variable,
+// the integer gcd is interpolated back, and the result is checked by exact
+// division. Throws SymbolicError for unparsable input and division by zero.
+RationalForm rational_form(const SymEngine::RCP<const SymEngine::Basic>& expr);
+RationalForm rational_form(const std::string& expr);
+
+// numerator/denominator of rational_form(expr), expanded.
+std::string cancel(const std::string& expr);
+
+// Whether lhs - rhs is zero as a rational function of its generators: true
+// when the combined numerator vanishes, false when it does not and every
+// generator is a symbol (the test is complete there), indeterminate
+// otherwise.
+SymEngine::tribool rational_equal(
+    const SymEngine::RCP<const SymEngine::Basic>& lhs,
+    const SymEngine::RCP<const SymEngine::Basic>& rhs
+);
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "errors.hpp"
+
+namespace mathllm {
+
+struct PolynomialRoot {
+    std::complex<double> value;
+    int multiplicity;
+    // Estimated |value - exact root|: the Newton inclusion radius for simple
+    // roots, the cluster spread for multiple ones.
+    double error_estimate;
+};
+
+struct RootFinderResult {
+    // Distinct roots ordered by real then imaginary part.
+    std::vector<PolynomialRoot> roots;
+    int iterations;
+    bool converged;
+    // "aberth" or "companion".
+    std::string method;
+};
+
+// All complex roots of the real polynomial sum coeffs[k] * x^k. Aberth-
+// Ehrlich iteration runs first; if it stalls or leaves the finite range the
+// eigenvalues of the companion matrix are used instead. Roots whose Newton
+// inclusion disks overlap are merged into one root of that multiplicity and
+// re-polished on the matching derivative; simple roots get a final Newton
+// step on the original coefficients. Throws NumericError on non-finite
+// coefficients.
+RootFinderResult find_polynomial_roots(
+    const std::vector<double>& coeffs,
+    double tol = 1e-14,
+    int max_iterations = 200
+);
+
+// find_polynomial_roots over many polynomials, in parallel when built with
+// OpenMP. Results are in input order.
+std::vector<RootFinderResult> find_polynomial_roots_batch(
+    const std::vector<std::vector<double>>& polys,
+    double tol = 1e-14,
+    int max_iterations = 200
+);
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+struct SeriesResult {
+    // sum of coefficients[k] * t^(valuation + k) with t = var - x0, or
+    // t = 1/var and t = -1/var at oo and -oo. The O(t^order) term is left out.
+    Expression expansion;
+    // coefficients[0] is non-zero unless the expansion is zero to order.
+    std::vector<Expression> coefficients;
+    int valuation;
+    int order;
+};
+
+// Laurent expansion of expr about x0 ("oo" and "-oo" included) up to, not
+// including, t^order. Built by truncated power-series arithmetic with
+// symbolic coefficients: products are convolutions, and elementary
+// functions are composed term by term from the differential equations they
+// satisfy. Throws SymbolicError for unparsable input and for expansions
+// that are not Laurent series (essential singularities, logarithmic or
+// fractional-power terms).
+SeriesResult series(const std::string& expr, const std::string& var, const std::string& x0 = "0", int order = 6);
+
+struct LimitResult {
+    // The limit, oo or -oo; nan when the one-sided limits differ or the
+    // numeric estimate did not converge.
+    Expression value;
+    // "substitution", "series" or "richardson".
+    std::string method;
+    // 1 for substitution and series. For Richardson extrapolation, the
+    // digits on which the two best extrapolants agree, over 12, in [0, 1].
+    double confidence;
+    // Difference of those extrapolants; 0 for the exact methods.
+    double error_estimate;
+};
+
+// Limit of expr as var tends to point ("oo" and "-oo" included) from dir:
+// "+", "-" or "+-" for both sides, which must agree. dir is ignored at
+// infinity. Direct substitution is tried first, then the leading term of the
+// one-sided series expansion, then Richardson extrapolation of compiled
+// evaluations at point +- h for h = 2^-k / 8. Throws SymbolicError when no
+// method applies and NumericError for an invalid dir.
+LimitResult limit(const std::string& expr, const std::string& var, const std::string& point = "0", const std::string& dir = "+-");
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+struct SolutionElement {
+    Expression value;
+    // 1 unless the solver split the equation by multiplicity.
+    int multiplicity;
+    std::complex<double> approximation;
+};
+
+struct SolutionInterval {
+    Expression start;
+    Expression end;
+    bool left_open;
+    bool right_open;
+};
+
+struct SolutionSet {
+    std::vector<SolutionElement> elements;
+    std::vector<SolutionInterval> intervals;
+    // What is neither an element nor an interval: the condition of a
+    // ConditionSet, or the set itself for image sets and complements. Empty
+    // when the solution is fully explicit.
+    std::vector<Expression> conditions;
+    // "polynomial", "symengine", "numeric_polynomial" or
+    // "interval_bisection".
+    std::string method;
+    // The printed form that solve_equation returns.
+    std::string str;
+};
+
+// solve_equation with the result kept structured. Throws SymbolicError like
+// solve_equation.
+SolutionSet solve_equation_set(const std::string& lhs, const std::string& rhs, const std::string& var);
+
+}
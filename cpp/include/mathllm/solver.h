@@ -0,0 +1,198 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <symengine/basic.h>
+#include <symengine/symbol.h>
+
+#include "errors.hpp"
+#include "numeric.h"
+
+namespace mathllm {
+
+struct RealRoot {
+    double value;
+    // |value - root| <= error_bound.
+    double error_bound;
+    // True when a sign change and a derivative enclosure excluding zero
+    // prove exactly one root within the bound; false for roots found as a
+    // cluster of boxes that could not be separated (even multiplicity,
+    // tangencies or roots closer than tol) and on which |f| at the
+    // midpoint is below 1e-8. Clusters around poles are dropped.
+    bool verified;
+};
+
+struct SystemSolveResult {
+    std::vector<double> solution;
+    // Max-norm of the residuals at solution.
+    double residual_norm;
+    int iterations;
+    bool converged;
+    // Index of the starting point that led to solution.
+    int start_index;
+};
+
+struct LinearSolveResult {
+    // "unique", "infinite" or "inconsistent".
+    std::string status;
+    int rank;
+    // One entry per variable. For rank-deficient systems this is the
+    // particular solution with every free variable set to zero; the general
+    // solution adds any combination of the nullspace vectors. Empty when
+    // inconsistent.
+    std::vector<std::string> solution;
+    // solution as doubles when every entry is numeric, empty otherwise.
+    std::vector<double> values;
+    // Basis of the nullspace of the coefficient matrix, one entry per
+    // variable in each vector.
+    std::vector<std::vector<std::string>> nullspace;
+    // "fraction_free", "dense_lu" or "sparse_lu".
+    std::string method;
+};
+
+struct ParametricCase {
+    // Conjunction of "c == 0" and "c != 0" tests on the coefficients of the
+    // equation as a polynomial in var, or of "var != p" for the poles of a
+    // rational equation; empty when the case always applies.
+    std::string condition;
+    // Closed-form solutions in the parameters. Empty when the case is
+    // solved numerically at each point instead.
+    std::vector<std::string> solutions;
+};
+
+// An equation solved once for var in terms of parameters, with its
+// solutions compiled for fast evaluation at many parameter values.
+// Polynomial equations split into cases by their leading coefficient
+// (a*x^2 + b*x + c: a != 0, then a == 0 and b != 0); cases of degree up to
+// two compile the closed form, higher ones run the polynomial root finder
+// on the compiled coefficients. Other equations compile the FiniteSet that
+// SymEngine::solve returns.
+class ParametricSolution {
+public:
+    // Throws SymbolicError on parse errors or when the equation has no
+    // closed-form solution, NumericError when a solution involves symbols
+    // other than params.
+    ParametricSolution(
+        const std::string& lhs,
+        const std::string& rhs,
+        const std::string& var,
+        const std::vector<std::string>& params
+    );
+
+    const std::vector<ParametricCase>& cases() const { return cases_; }
+    // Solution slots per parameter point: the degree of a polynomial
+    // equation, the number of closed-form solutions otherwise.
+    std::size_t width() const { return width_; }
+
+    // points is row-major (count x params.size()); out receives count x
+    // width() real solutions, each row ascending with repeated roots
+    // repeated. Slots that are unused, not real or undefined at a point hold
+    // NaN after the solutions, as does every slot of a point no case
+    // applies to.
+    void evaluate_batch(const double* points, std::size_t count, double* out) const;
+    std::vector<std::vector<double>> evaluate(const std::vector<std::vector<double>>& points) const;
+
+private:
+    struct CompiledCase {
+        int degree;
+        std::vector<CompiledExpr> solutions;
+    };
+
+    std::vector<ParametricCase> cases_;
+    std::vector<CompiledCase> compiled_;
+    // Coefficients of var^k; empty for non-polynomial equations.
+    std::vector<CompiledExpr> coeffs_;
+    // Points where a rational equation's denominator vanishes.
+    std::vector<CompiledExpr> excluded_;
+    std::size_t num_params_;
+    std::size_t width_ = 0;
+};
+
+// Solves lhs = rhs for var once; evaluate the result at each parameter point.
+ParametricSolution solve_parametric(
+    const std::string& lhs,
+    const std::string& rhs,
+    const std::string& var,
+    const std::vector<std::string>& params
+);
+
+struct RealRootsResult {
+    // Sorted by value.
+    std::vector<RealRoot> roots;
+    // False when the box budget ran out before every part of the interval
+    // was either excluded or resolved.
+    bool complete;
+    int evaluations;
+};
+
+// Parses an expression, or "lhs = rhs" as lhs - rhs. Throws SymbolicError on
+// parse errors and on more than one '='.
+SymEngine::RCP<const SymEngine::Basic> parse_equation(const std::string& equation);
+
+// Real roots of f = 0 on [lower, upper], where f and f' (from
+// SymEngine::diff) run on compiled tapes. Bisection with interval
+// arithmetic discards boxes on which f cannot vanish; boxes where f' is
+// bounded away from zero and f changes sign hold exactly one root, which
+// Brent's method refines to tol. Throws NumericError if f cannot be
+// compiled or the interval is invalid.
+RealRootsResult find_real_roots(
+    const SymEngine::RCP<const SymEngine::Basic>& f,
+    const SymEngine::RCP<const SymEngine::Symbol>& var,
+    double lower,
+    double upper,
+    double tol = 1e-12
+);
+
+// As above for lhs = rhs; throws SymbolicError on parse errors.
+RealRootsResult find_real_roots(
+    const std::string& lhs,
+    const std::string& rhs,
+    const std::string& var,
+    double lower,
+    double upper,
+    double tol = 1e-12
+);
+
+// Damped Newton on the system equations[i] = 0, where each equation is an
+// expression or "lhs = rhs". The Jacobian is differentiated symbolically
+// and compiled once; each step solves J dx = -F by complete orthogonal
+// decomposition, so over-determined systems get Gauss-Newton steps and
+// singular Jacobians a minimum-norm step. Steps are halved until
+// |F|^2 decreases (Armijo). Converged means max |F_i| <= tol, or a step
+// below tol with residuals below sqrt(tol). Throws SymbolicError on parse
+// errors and NumericError on malformed input or uncompilable equations.
+SystemSolveResult solve_system(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const std::vector<double>& x0,
+    double tol = 1e-10,
+    int max_iterations = 100
+);
+
+// Runs solve_system from every point in starts, in parallel when built with
+// OpenMP, and returns the distinct converged solutions in order of the
+// first start reaching each. Empty when no start converges.
+std::vector<SystemSolveResult> solve_system_multistart(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const std::vector<std::vector<double>>& starts,
+    double tol = 1e-10,
+    int max_iterations = 100
+);
+
+// Solves a system of equations linear in vars (expressions or "lhs = rhs";
+// coefficients may involve other symbols). The coefficient matrix is read
+// straight off the expanded Add/Mul trees. Small systems with exact
+// rational or symbolic coefficients go through fraction-free (Bareiss)
+// elimination with exact results; systems with floating-point
+// coefficients, or larger than 24 unknowns with numeric coefficients, use
+// Eigen: sparse LU for large square sparse systems, full-pivot dense LU
+// otherwise. Throws SymbolicError on parse errors or equations that are
+// not linear in vars.
+LinearSolveResult solve_linear_system(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars
+);
+
+}
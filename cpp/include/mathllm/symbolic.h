@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <symengine/basic.h>
 #include "errors.hpp"
 
 namespace mathllm {
@@ -9,6 +10,17 @@ std::string integrate(const std::string& expr, const std::string& var);
 std::string diff(const std::string& expr, const std::string& var);
 std::string solve_equation(const std::string& lhs, const std::string& rhs, const std::string& var);
 bool verify_equal(const std::string& lhs, const std::string& rhs, double timeout_ms = 1000.0);
+// Cheapest equivalent form of expr reachable by expansion, rational
+// cancellation, trigonometric rewriting (tan/cot/sec/csc to sin/cos,
+// sin^2 + cos^2 = 1, sin/cos to tan) and exp/log contraction. objective
+// selects the cost: "ops" counts arithmetic operations and function calls,
+// divisions and non-integer powers twice; "nodes" counts tree nodes. The
+// budget is checked between rewrites, so a single rewrite can overrun it;
+// the best form found so far is returned when it runs out.
+std::string simplify(const std::string& expr, double budget_ms = 100.0, const std::string& objective = "ops");
+// Cost of expr under a simplify() objective. Throws SymbolicError for an
+// unknown objective.
+double expression_cost(const SymEngine::Basic& expr, const std::string& objective);
 
 }
 
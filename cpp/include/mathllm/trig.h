@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include <symengine/basic.h>
+#include <symengine/tribool.h>
+
+#include "errors.hpp"
+#include "expression.h"
+
+namespace mathllm {
+
+// Rewrites sin, cos, tan, cot, sec, csc and exp(I*u) as Laurent
+// polynomials in z = exp(I*u), where each argument u is split into a
+// linear combination of monomials with rational coefficients, and writes
+// the result back as sums of sin and cos of multiple angles:
+// sin(x)^2*cos(x) becomes cos(x)/4 - cos(3*x)/4. Constant phases that are
+// multiples of pi/2 are folded into the coefficients. Without tan, cot,
+// sec and csc the result is canonical; with them it is a quotient of two
+// such sums. Throws SymbolicError for unparsable input, division by zero,
+// or when an expansion grows past the term limit.
+Expression trig_normal_form(const SymEngine::RCP<const SymEngine::Basic>& expr);
+std::string trig_canonical(const std::string& expr);
+
+// Compares lhs and rhs coefficient by coefficient in the exponential
+// form, after cross-multiplying any denominators: true when every
+// coefficient of the difference expands to zero, false when one is a
+// nonzero number and every angle is a rational combination of symbols
+// (distinct frequencies are linearly independent there), indeterminate
+// otherwise.
+SymEngine::tribool trig_equal(
+    const SymEngine::RCP<const SymEngine::Basic>& lhs,
+    const SymEngine::RCP<const SymEngine::Basic>& rhs
+);
+
+}
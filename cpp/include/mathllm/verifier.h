@@ -1,9 +1,45 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include "errors.hpp"
 
 namespace mathllm {
 
 bool verify_equal(const std::string& lhs, const std::string& rhs);
 
+struct CheckResult {
+    bool ok;
+    // "symbolic" when the expanded residual is identically zero, "numeric"
+    // when only the probe confirmed it, "failed" otherwise.
+    std::string method;
+    std::string residual;
+    // Largest relative residual seen by the probe; 0 on the symbolic path.
+    double max_error;
+    int trials;
+};
+
+struct RootCheckResult {
+    bool ok;
+    std::vector<CheckResult> roots;
+};
+
+// Each check builds a residual with SymEngine (differentiation or
+// substitution), tries the expand/is_zero test, and falls back to a seeded
+// probe of the compiled residual on [0.5, 2] for every free symbol.
+// Parse failures throw VerifierError.
+
+// d/dvar F == f.
+CheckResult check_antiderivative(const std::string& F, const std::string& f, const std::string& var);
+// expr == 0 at var = root, for each root.
+RootCheckResult check_roots(const std::string& expr, const std::string& var, const std::vector<std::string>& roots);
+// y' == rhs(t, y) for y = y_expr(t).
+CheckResult check_ode_solution(
+    const std::string& y_expr,
+    const std::string& rhs,
+    const std::string& t,
+    const std::string& y = "y"
+);
+
 }
@@ -0,0 +1,306 @@
+#include "mathllm/canonical.h"
+
+#include <symengine/add.h>
+#include <symengine/complex_double.h>
+#include <symengine/functions.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/real_double.h>
+#include <symengine/symbol.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+
+const std::size_t kDefaultAlphaCacheCapacity = 4096;
+const std::uint64_t kFnvOffset = 0xcbf29ce484222325ULL;
+const std::uint64_t kFnvPrime = 0x100000001b3ULL;
+
+RCP<const Basic> parse_expression(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+std::string canonical_name(std::size_t index) {
+    return "_" + std::to_string(index);
+}
+
+// The exact value of a double; printing rounds to 15 significant digits.
+std::string exact_double(double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%a", value);
+    return std::string(buffer);
+}
+
+// Text of an atom that determines it: doubles are written out exactly.
+std::string leaf_text(const RCP<const Basic>& expr) {
+    if (SymEngine::is_a<SymEngine::RealDouble>(*expr)) {
+        return exact_double(SymEngine::down_cast<const SymEngine::RealDouble&>(*expr).as_double());
+    }
+    if (SymEngine::is_a<SymEngine::ComplexDouble>(*expr)) {
+        const auto& value = SymEngine::down_cast<const SymEngine::ComplexDouble&>(*expr).i;
+        return exact_double(value.real()) + "," + exact_double(value.imag());
+    }
+    return expr->__str__();
+}
+
+// Symbol names already given a canonical index.
+using Index = std::unordered_map<std::string, std::size_t>;
+
+// An expression tree with the operands of sums and products sorted by
+// their shape. A symbol's shape is its index, or "s" before it has one.
+struct Node {
+    RCP<const Basic> expr;
+    std::string shape;
+    std::vector<Node> children;
+};
+
+Node build(const RCP<const Basic>& expr, const Index& index) {
+    Node node{expr, std::string(), {}};
+    if (SymEngine::is_a<SymEngine::Symbol>(*expr)) {
+        const auto it = index.find(SymEngine::down_cast<const SymEngine::Symbol&>(*expr).get_name());
+        node.shape = it == index.end() ? "s" : "v" + std::to_string(it->second);
+        return node;
+    }
+    const std::string type = std::to_string(static_cast<int>(expr->get_type_code()));
+    const auto args = expr->get_args();
+    if (args.empty()) {
+        // Numbers, constants and other atoms print without variable names.
+        node.shape = "L" + type + ":" + leaf_text(expr);
+        return node;
+    }
+    for (const auto& arg : args) {
+        node.children.push_back(build(arg, index));
+    }
+    if (SymEngine::is_a<SymEngine::Add>(*expr) || SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        std::stable_sort(node.children.begin(), node.children.end(),
+            [](const Node& a, const Node& b) { return a.shape < b.shape; });
+    }
+    node.shape = "N" + type;
+    if (SymEngine::is_a<SymEngine::FunctionSymbol>(*expr)) {
+        node.shape += ":" + SymEngine::down_cast<const SymEngine::FunctionSymbol&>(*expr).get_name();
+    }
+    node.shape += "(";
+    for (std::size_t i = 0; i < node.children.size(); ++i) {
+        node.shape += (i == 0 ? "" : ",") + node.children[i].shape;
+    }
+    node.shape += ")";
+    return node;
+}
+
+void assign(const Node& node, Index& index, std::vector<std::string>& order) {
+    if (SymEngine::is_a<SymEngine::Symbol>(*node.expr)) {
+        const auto& name = SymEngine::down_cast<const SymEngine::Symbol&>(*node.expr).get_name();
+        if (index.emplace(name, order.size()).second) {
+            order.push_back(name);
+        }
+        return;
+    }
+    for (const auto& child : node.children) {
+        assign(child, index, order);
+    }
+}
+
+std::uint64_t fnv1a(std::uint64_t hash, unsigned char byte) {
+    return (hash ^ byte) * kFnvPrime;
+}
+
+SymEngine::map_basic_basic substitution(
+    const std::vector<std::pair<std::string, std::string>>& renaming,
+    bool forward
+) {
+    SymEngine::map_basic_basic map;
+    for (const auto& names : renaming) {
+        const auto from = SymEngine::symbol(forward ? names.first : names.second);
+        const auto to = SymEngine::symbol(forward ? names.second : names.first);
+        map[from] = to;
+    }
+    return map;
+}
+
+// LRU table of results, laid out like the antiderivative memo.
+class AlphaCache {
+public:
+    bool lookup(const std::string& operation, const CanonicalKey& key, AlphaCachedResult& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ == 0) {
+            return false;
+        }
+        auto it = index_.find(Key{operation, key});
+        if (it == index_.end()) {
+            ++misses_;
+            return false;
+        }
+        ++hits_;
+        order_.splice(order_.begin(), order_, it->second);
+        out = it->second->second;
+        return true;
+    }
+
+    void store(const std::string& operation, const CanonicalKey& key, const AlphaCachedResult& result) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ == 0) {
+            return;
+        }
+        const Key entry{operation, key};
+        auto it = index_.find(entry);
+        if (it != index_.end()) {
+            it->second->second = result;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        order_.emplace_front(entry, result);
+        index_.emplace(entry, order_.begin());
+        evict();
+    }
+
+    AlphaCacheStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::size_t lookups = hits_ + misses_;
+        const double rate = lookups == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(lookups);
+        return AlphaCacheStats{hits_, misses_, order_.size(), capacity_, rate};
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        order_.clear();
+        index_.clear();
+        hits_ = misses_ = 0;
+    }
+
+    void set_capacity(std::size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        evict();
+    }
+
+private:
+    struct Key {
+        std::string operation;
+        CanonicalKey key;
+
+        bool operator==(const Key& other) const { return operation == other.operation && key == other.key; }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            std::size_t seed = static_cast<std::size_t>(key.key.low ^ (key.key.high << 1));
+            seed ^= std::hash<std::string>()(key.operation) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    using Entry = std::pair<Key, AlphaCachedResult>;
+
+    void evict() {
+        while (order_.size() > capacity_) {
+            index_.erase(order_.back().first);
+            order_.pop_back();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::list<Entry> order_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    std::size_t capacity_ = kDefaultAlphaCacheCapacity;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+AlphaCache& alpha_cache() {
+    static AlphaCache cache;
+    return cache;
+}
+
+}
+
+std::string CanonicalKey::hex() const {
+    char buffer[33];
+    std::snprintf(buffer, sizeof(buffer), "%016llx%016llx",
+        static_cast<unsigned long long>(high), static_cast<unsigned long long>(low));
+    return std::string(buffer);
+}
+
+RCP<const Basic> AlphaCanonical::to_canonical(const RCP<const Basic>& expr) const {
+    return expr->subs(substitution(renaming, true));
+}
+
+RCP<const Basic> AlphaCanonical::to_caller(const RCP<const Basic>& expr) const {
+    return expr->subs(substitution(renaming, false));
+}
+
+AlphaCanonical alpha_canonicalize(const std::vector<RCP<const Basic>>& exprs, const std::vector<std::string>& bound) {
+    Index index;
+    std::vector<std::string> order;
+    for (const auto& name : bound) {
+        if (index.emplace(name, order.size()).second) {
+            order.push_back(name);
+        }
+    }
+    // The traversal sees bound symbols by index and free ones only as
+    // "s", so the order it numbers them in does not depend on their names.
+    for (const auto& expr : exprs) {
+        assign(build(expr, index), index, order);
+    }
+
+    std::string serialized = "b" + std::to_string(bound.size());
+    for (const auto& expr : exprs) {
+        serialized += ";" + build(expr, index).shape;
+    }
+    // The same FNV-1a over the serialization read forwards and backwards.
+    std::uint64_t low = kFnvOffset;
+    std::uint64_t high = kFnvOffset;
+    for (std::size_t i = 0; i < serialized.size(); ++i) {
+        low = fnv1a(low, static_cast<unsigned char>(serialized[i]));
+        high = fnv1a(high, static_cast<unsigned char>(serialized[serialized.size() - 1 - i]));
+    }
+
+    AlphaCanonical result{{}, CanonicalKey{high, low}, {}};
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        result.renaming.emplace_back(order[i], canonical_name(i));
+    }
+    const auto forward = substitution(result.renaming, true);
+    for (const auto& expr : exprs) {
+        result.exprs.emplace_back(expr->subs(forward));
+    }
+    return result;
+}
+
+AlphaCanonical alpha_canonicalize(const std::string& expr, const std::vector<std::string>& bound) {
+    return alpha_canonicalize(std::vector<RCP<const Basic>>{parse_expression(expr)}, bound);
+}
+
+bool alpha_cache_lookup(const std::string& operation, const CanonicalKey& key, AlphaCachedResult& out) {
+    return alpha_cache().lookup(operation, key, out);
+}
+
+void alpha_cache_store(const std::string& operation, const CanonicalKey& key, const AlphaCachedResult& result) {
+    alpha_cache().store(operation, key, result);
+}
+
+AlphaCacheStats alpha_cache_stats() {
+    return alpha_cache().stats();
+}
+
+void clear_alpha_cache() {
+    alpha_cache().clear();
+}
+
+void set_alpha_cache_capacity(std::size_t capacity) {
+    alpha_cache().set_capacity(capacity);
+}
+
+}
@@ -0,0 +1,176 @@
+#include "mathllm/derivatives.h"
+
+#include <symengine/basic.h>
+#include <symengine/derivative.h>
+#include <symengine/parser.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+
+RCP<const Basic> parse_expression(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+// One DiffVisitor per variable. Each keeps its cache across calls, so a
+// subexpression that appears in several entries is differentiated once per
+// variable.
+class Differentiator {
+public:
+    explicit Differentiator(const std::vector<std::string>& vars) {
+        if (vars.empty()) {
+            throw SymbolicError("No variables to differentiate with respect to");
+        }
+        if (std::set<std::string>(vars.begin(), vars.end()).size() != vars.size()) {
+            throw SymbolicError("Duplicate differentiation variable");
+        }
+        visitors_.reserve(vars.size());
+        for (const auto& var : vars) {
+            visitors_.emplace_back(new SymEngine::DiffVisitor(SymEngine::symbol(var)));
+        }
+    }
+
+    RCP<const Basic> diff(const RCP<const Basic>& expr, std::size_t var) {
+        try {
+            return visitors_[var]->apply(expr);
+        } catch (const SymEngine::SymEngineException& ex) {
+            throw SymbolicError(ex.what());
+        }
+    }
+
+    std::size_t size() const { return visitors_.size(); }
+
+private:
+    std::vector<std::unique_ptr<SymEngine::DiffVisitor>> visitors_;
+};
+
+}
+
+DerivativeMatrix::DerivativeMatrix(
+    std::size_t rows,
+    std::size_t cols,
+    std::vector<Expression> entries,
+    const std::vector<std::string>& vars
+) : rows_(rows), cols_(cols), entries_(std::move(entries)), vars_(vars) {
+    if (entries_.size() != rows_ * cols_) {
+        throw SymbolicError("Derivative matrix entries do not match its shape");
+    }
+    SymEngine::vec_basic exprs;
+    exprs.reserve(entries_.size());
+    for (const auto& entry : entries_) {
+        exprs.push_back(entry.get());
+    }
+    // Entries with functions the tape cannot evaluate stay usable
+    // symbolically; evaluation reports the error.
+    try {
+        compiled_ = std::make_shared<const CompiledExpr>(exprs, vars_);
+    } catch (const NumericError& ex) {
+        compile_error_ = ex.what();
+    }
+}
+
+const Expression& DerivativeMatrix::at(std::size_t row, std::size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+        throw SymbolicError("Derivative matrix index out of range");
+    }
+    return entries_[row * cols_ + col];
+}
+
+std::vector<std::vector<std::string>> DerivativeMatrix::to_strings() const {
+    std::vector<std::vector<std::string>> result(rows_);
+    for (std::size_t i = 0; i < rows_; ++i) {
+        for (std::size_t j = 0; j < cols_; ++j) {
+            result[i].push_back(entries_[i * cols_ + j].str());
+        }
+    }
+    return result;
+}
+
+const CompiledExpr& DerivativeMatrix::compiled() const {
+    if (!compiled_) {
+        throw NumericError(compile_error_);
+    }
+    return *compiled_;
+}
+
+void DerivativeMatrix::evaluate(const double* point, double* out) const {
+    compiled().evaluate_all(point, out);
+}
+
+std::vector<std::vector<double>> DerivativeMatrix::evaluate(const std::vector<double>& point) const {
+    if (point.size() != vars_.size()) {
+        throw NumericError("Point dimension does not match derivative variables");
+    }
+    std::vector<double> values(rows_ * cols_);
+    evaluate(point.data(), values.data());
+    std::vector<std::vector<double>> result(rows_);
+    for (std::size_t i = 0; i < rows_; ++i) {
+        result[i].assign(values.begin() + i * cols_, values.begin() + (i + 1) * cols_);
+    }
+    return result;
+}
+
+void DerivativeMatrix::evaluate_batch(const double* points, std::size_t count, double* out) const {
+    compiled().evaluate_batch(points, count, out);
+}
+
+DerivativeMatrix gradient(const std::string& expr, const std::vector<std::string>& vars) {
+    return jacobian({expr}, vars);
+}
+
+DerivativeMatrix jacobian(const std::vector<std::string>& exprs, const std::vector<std::string>& vars) {
+    if (exprs.empty()) {
+        throw SymbolicError("No expressions to differentiate");
+    }
+    Differentiator differentiator(vars);
+    std::vector<Expression> entries;
+    entries.reserve(exprs.size() * vars.size());
+    for (const auto& expr : exprs) {
+        const auto parsed = parse_expression(expr);
+        for (std::size_t j = 0; j < vars.size(); ++j) {
+            entries.emplace_back(differentiator.diff(parsed, j));
+        }
+    }
+    return DerivativeMatrix(exprs.size(), vars.size(), std::move(entries), vars);
+}
+
+DerivativeMatrix hessian(const std::string& expr, const std::vector<std::string>& vars) {
+    Differentiator differentiator(vars);
+    const auto parsed = parse_expression(expr);
+    const std::size_t n = vars.size();
+    std::vector<RCP<const Basic>> gradient;
+    gradient.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        gradient.push_back(differentiator.diff(parsed, i));
+    }
+    std::vector<RCP<const Basic>> upper(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i; j < n; ++j) {
+            upper[i * n + j] = differentiator.diff(gradient[i], j);
+        }
+    }
+    std::vector<Expression> entries;
+    entries.reserve(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            entries.emplace_back(i <= j ? upper[i * n + j] : upper[j * n + i]);
+        }
+    }
+    return DerivativeMatrix(n, n, std::move(entries), vars);
+}
+
+}
@@ -0,0 +1,694 @@
+#include "mathllm/egraph.h"
+#include "mathllm/symbolic.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/constants.h>
+#include <symengine/functions.h>
+#include <symengine/integer.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using Clock = std::chrono::steady_clock;
+using ClassId = EGraph::ClassId;
+
+RCP<const Basic> parse_expression(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+// Nodes the graph looks inside; anything else is an opaque leaf.
+bool is_operator(const Basic& expr) {
+    if (expr.get_args().empty()) {
+        return false;
+    }
+    return SymEngine::is_a<SymEngine::Add>(expr) || SymEngine::is_a<SymEngine::Mul>(expr)
+        || SymEngine::is_a<SymEngine::Pow>(expr) || SymEngine::is_a_sub<SymEngine::OneArgFunction>(expr)
+        || SymEngine::is_a_sub<SymEngine::TwoArgFunction>(expr)
+        || SymEngine::is_a_sub<SymEngine::MultiArgFunction>(expr);
+}
+
+bool is_commutative(const Basic& expr) {
+    return SymEngine::is_a<SymEngine::Add>(expr) || SymEngine::is_a<SymEngine::Mul>(expr);
+}
+
+// The operator of head applied to args.
+RCP<const Basic> build(const RCP<const Basic>& head, const SymEngine::vec_basic& args) {
+    if (!is_operator(*head)) {
+        return head;
+    }
+    if (SymEngine::is_a<SymEngine::Add>(*head)) {
+        return SymEngine::add(args);
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(*head)) {
+        return SymEngine::mul(args);
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*head)) {
+        return SymEngine::pow(args[0], args[1]);
+    }
+    if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*head)) {
+        return SymEngine::down_cast<const SymEngine::OneArgFunction&>(*head).create(args[0]);
+    }
+    if (SymEngine::is_a_sub<SymEngine::TwoArgFunction>(*head)) {
+        return SymEngine::down_cast<const SymEngine::TwoArgFunction&>(*head).create(args[0], args[1]);
+    }
+    return SymEngine::down_cast<const SymEngine::MultiArgFunction&>(*head).create(args);
+}
+
+bool is_integer_at_least(const RCP<const Basic>& expr, long bound) {
+    return SymEngine::is_a<SymEngine::Integer>(*expr)
+        && SymEngine::down_cast<const SymEngine::Integer&>(*expr).as_int() >= bound;
+}
+
+// A node matched by a rule. terms holds the cheapest term of every class at
+// the start of the pass. For sums, products and powers, variants holds the
+// node rebuilt from those terms, then rebuilt once for each other member of
+// each operand class standing in for that operand; SymEngine collects like
+// terms and powers across the substituted member as it rebuilds.
+struct Match {
+    const EGraph& graph;
+    const std::vector<RCP<const Basic>>& terms;
+    const EGraph::ENode& node;
+    SymEngine::vec_basic variants;
+
+    RCP<const Basic> term(ClassId id) const { return terms[graph.find(id)]; }
+
+    SymEngine::vec_basic args() const {
+        SymEngine::vec_basic result;
+        result.reserve(node.children.size());
+        for (const auto child : node.children) {
+            result.push_back(term(child));
+        }
+        return result;
+    }
+};
+
+SymEngine::vec_basic variants_of(const Match& match) {
+    const auto& head = match.node.head;
+    if (!is_commutative(*head) && !SymEngine::is_a<SymEngine::Pow>(*head)) {
+        return {};
+    }
+    const auto args = match.args();
+    SymEngine::vec_basic result{build(head, args)};
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        for (const auto& member : match.graph.nodes(match.node.children[i])) {
+            SymEngine::vec_basic member_args;
+            for (const auto child : member.children) {
+                member_args.push_back(match.term(child));
+            }
+            const auto substitute = build(member.head, member_args);
+            if (SymEngine::eq(*substitute, *args[i])) {
+                continue;
+            }
+            auto replaced = args;
+            replaced[i] = substitute;
+            result.push_back(build(head, replaced));
+        }
+    }
+    return result;
+}
+
+using Rule = void (*)(const Match&, SymEngine::vec_basic&);
+
+void recollect(const Match& match, SymEngine::vec_basic& out) {
+    out.insert(out.end(), match.variants.begin(), match.variants.end());
+}
+
+void expand_product(const Match& match, SymEngine::vec_basic& out) {
+    if (!SymEngine::is_a<SymEngine::Mul>(*match.node.head) && !SymEngine::is_a<SymEngine::Pow>(*match.node.head)) {
+        return;
+    }
+    for (const auto& term : match.variants) {
+        const auto expanded = SymEngine::expand(term);
+        if (SymEngine::neq(*expanded, *term)) {
+            out.push_back(expanded);
+        }
+    }
+}
+
+// (base, exponent) factors of a term, its numeric coefficient left out.
+std::vector<std::pair<RCP<const Basic>, RCP<const Basic>>> factors_of(const RCP<const Basic>& term) {
+    std::vector<std::pair<RCP<const Basic>, RCP<const Basic>>> result;
+    if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+        for (const auto& entry : SymEngine::down_cast<const SymEngine::Mul&>(*term).get_dict()) {
+            result.emplace_back(entry.first, entry.second);
+        }
+    } else if (SymEngine::is_a<SymEngine::Pow>(*term)) {
+        const auto& power = SymEngine::down_cast<const SymEngine::Pow&>(*term);
+        result.emplace_back(power.get_base(), power.get_exp());
+    } else if (!SymEngine::is_a_Number(*term)) {
+        result.emplace_back(term, SymEngine::one);
+    }
+    return result;
+}
+
+// Positive integer power of base in term; 0 when there is none.
+long power_of(const RCP<const Basic>& term, const RCP<const Basic>& base) {
+    for (const auto& factor : factors_of(term)) {
+        if (SymEngine::eq(*factor.first, *base) && is_integer_at_least(factor.second, 1)) {
+            return SymEngine::down_cast<const SymEngine::Integer&>(*factor.second).as_int();
+        }
+    }
+    return 0;
+}
+
+// a*b + a*c -> a*(b + c) for the factors every term shares.
+void common_factor(const Match& match, SymEngine::vec_basic& out) {
+    if (!SymEngine::is_a<SymEngine::Add>(*match.node.head)) {
+        return;
+    }
+    const auto args = match.args();
+    SymEngine::vec_basic shared;
+    for (const auto& factor : factors_of(args[0])) {
+        long power = power_of(args[0], factor.first);
+        for (std::size_t i = 1; i < args.size() && power > 0; ++i) {
+            power = std::min(power, power_of(args[i], factor.first));
+        }
+        if (power > 0) {
+            shared.push_back(SymEngine::pow(factor.first, SymEngine::integer(power)));
+        }
+    }
+    if (shared.empty()) {
+        return;
+    }
+    const auto common = SymEngine::mul(shared);
+    SymEngine::vec_basic quotients;
+    for (const auto& arg : args) {
+        quotients.push_back(SymEngine::div(arg, common));
+    }
+    out.push_back(SymEngine::mul(common, SymEngine::add(quotients)));
+}
+
+// f(t)^n -> f(t)^(n-2) * f(t)^2 with f(t)^2 written through
+// sin^2 + cos^2 = 1 or cosh^2 - sinh^2 = 1.
+void pythagorean(const Match& match, SymEngine::vec_basic& out) {
+    if (!SymEngine::is_a<SymEngine::Pow>(*match.node.head)) {
+        return;
+    }
+    const auto exponent = match.term(match.node.children[1]);
+    if (!is_integer_at_least(exponent, 2)) {
+        return;
+    }
+    const long n = SymEngine::down_cast<const SymEngine::Integer&>(*exponent).as_int();
+    for (const auto& base : match.graph.nodes(match.node.children[0])) {
+        RCP<const Basic> square;
+        if (SymEngine::is_a<SymEngine::Sin>(*base.head)) {
+            square = SymEngine::sub(SymEngine::one, SymEngine::pow(SymEngine::cos(match.term(base.children[0])), SymEngine::two));
+        } else if (SymEngine::is_a<SymEngine::Cos>(*base.head)) {
+            square = SymEngine::sub(SymEngine::one, SymEngine::pow(SymEngine::sin(match.term(base.children[0])), SymEngine::two));
+        } else if (SymEngine::is_a<SymEngine::Sinh>(*base.head)) {
+            square = SymEngine::sub(SymEngine::pow(SymEngine::cosh(match.term(base.children[0])), SymEngine::two), SymEngine::one);
+        } else if (SymEngine::is_a<SymEngine::Cosh>(*base.head)) {
+            square = SymEngine::add(SymEngine::one, SymEngine::pow(SymEngine::sinh(match.term(base.children[0])), SymEngine::two));
+        } else {
+            continue;
+        }
+        const auto rest = build(base.head, {match.term(base.children[0])});
+        out.push_back(SymEngine::mul(SymEngine::pow(rest, SymEngine::integer(n - 2)), square));
+    }
+}
+
+// tan, cot, sec, csc and tanh as quotients, and sin(a)^k * cos(a)^-k back
+// to tan(a)^k for integer k.
+void quotient(const Match& match, SymEngine::vec_basic& out) {
+    const auto& head = match.node.head;
+    if (SymEngine::is_a<SymEngine::Mul>(*head)) {
+        for (const auto& term : match.variants) {
+            if (!SymEngine::is_a<SymEngine::Mul>(*term)) {
+                continue;
+            }
+            const auto& dict = SymEngine::down_cast<const SymEngine::Mul&>(*term).get_dict();
+            for (const auto& entry : dict) {
+                if (!SymEngine::is_a<SymEngine::Sin>(*entry.first) || !SymEngine::is_a<SymEngine::Integer>(*entry.second)) {
+                    continue;
+                }
+                const auto arg = SymEngine::down_cast<const SymEngine::Sin&>(*entry.first).get_arg();
+                const auto cosine = dict.find(SymEngine::cos(arg));
+                if (cosine != dict.end() && SymEngine::eq(*cosine->second, *SymEngine::neg(entry.second))) {
+                    const auto ratio = SymEngine::pow(SymEngine::div(entry.first, cosine->first), entry.second);
+                    out.push_back(SymEngine::mul(SymEngine::div(term, ratio), SymEngine::pow(SymEngine::tan(arg), entry.second)));
+                }
+            }
+        }
+        return;
+    }
+    if (match.node.children.size() != 1) {
+        return;
+    }
+    const auto arg = match.term(match.node.children[0]);
+    if (SymEngine::is_a<SymEngine::Tan>(*head)) {
+        out.push_back(SymEngine::div(SymEngine::sin(arg), SymEngine::cos(arg)));
+    } else if (SymEngine::is_a<SymEngine::Cot>(*head)) {
+        out.push_back(SymEngine::div(SymEngine::cos(arg), SymEngine::sin(arg)));
+    } else if (SymEngine::is_a<SymEngine::Sec>(*head)) {
+        out.push_back(SymEngine::div(SymEngine::one, SymEngine::cos(arg)));
+    } else if (SymEngine::is_a<SymEngine::Csc>(*head)) {
+        out.push_back(SymEngine::div(SymEngine::one, SymEngine::sin(arg)));
+    } else if (SymEngine::is_a<SymEngine::Tanh>(*head)) {
+        out.push_back(SymEngine::div(SymEngine::sinh(arg), SymEngine::cosh(arg)));
+    }
+}
+
+// sin(a + b) and cos(a + b) by the addition formulas, splitting off one
+// term of a sum or one multiple of n*u for an integer n >= 2; and
+// sin(u)*cos(u) -> sin(2*u)/2.
+void angle(const Match& match, SymEngine::vec_basic& out) {
+    const auto& head = match.node.head;
+    if (SymEngine::is_a<SymEngine::Mul>(*head)) {
+        for (const auto& term : match.variants) {
+            if (!SymEngine::is_a<SymEngine::Mul>(*term)) {
+                continue;
+            }
+            const auto& dict = SymEngine::down_cast<const SymEngine::Mul&>(*term).get_dict();
+            for (const auto& entry : dict) {
+                if (!SymEngine::is_a<SymEngine::Sin>(*entry.first) || !SymEngine::eq(*entry.second, *SymEngine::one)) {
+                    continue;
+                }
+                const auto arg = SymEngine::down_cast<const SymEngine::Sin&>(*entry.first).get_arg();
+                const auto cosine = dict.find(SymEngine::cos(arg));
+                if (cosine != dict.end() && SymEngine::eq(*cosine->second, *SymEngine::one)) {
+                    const auto rest = SymEngine::div(term, SymEngine::mul(entry.first, cosine->first));
+                    out.push_back(SymEngine::mul(rest, SymEngine::div(SymEngine::sin(SymEngine::mul(SymEngine::two, arg)), SymEngine::two)));
+                }
+            }
+        }
+        return;
+    }
+    const bool sine = SymEngine::is_a<SymEngine::Sin>(*head);
+    if (!sine && !SymEngine::is_a<SymEngine::Cos>(*head)) {
+        return;
+    }
+    const auto arg = match.term(match.node.children[0]);
+    RCP<const Basic> a;
+    if (SymEngine::is_a<SymEngine::Add>(*arg)) {
+        a = arg->get_args()[0];
+    } else if (SymEngine::is_a<SymEngine::Mul>(*arg)) {
+        const auto& coef = SymEngine::down_cast<const SymEngine::Mul&>(*arg).get_coef();
+        if (!SymEngine::is_a<SymEngine::Integer>(*coef)
+            || std::abs(SymEngine::down_cast<const SymEngine::Integer&>(*coef).as_int()) < 2) {
+            return;
+        }
+        a = SymEngine::div(arg, coef);
+    } else {
+        return;
+    }
+    const auto b = SymEngine::sub(arg, a);
+    if (sine) {
+        out.push_back(SymEngine::add(
+            SymEngine::mul(SymEngine::sin(a), SymEngine::cos(b)),
+            SymEngine::mul(SymEngine::cos(a), SymEngine::sin(b))
+        ));
+    } else {
+        out.push_back(SymEngine::sub(
+            SymEngine::mul(SymEngine::cos(a), SymEngine::cos(b)),
+            SymEngine::mul(SymEngine::sin(a), SymEngine::sin(b))
+        ));
+    }
+}
+
+void hyperbolic_exp(const Match& match, SymEngine::vec_basic& out) {
+    const auto& head = match.node.head;
+    const bool sine = SymEngine::is_a<SymEngine::Sinh>(*head);
+    if (!sine && !SymEngine::is_a<SymEngine::Cosh>(*head)) {
+        return;
+    }
+    const auto arg = match.term(match.node.children[0]);
+    const auto up = SymEngine::exp(arg);
+    const auto down = SymEngine::exp(SymEngine::neg(arg));
+    out.push_back(SymEngine::div(sine ? SymEngine::sub(up, down) : SymEngine::add(up, down), SymEngine::two));
+}
+
+// exp(c*log(a) + r) -> a^c * exp(r), and log(c*r) -> log(c) + log(r) for a
+// positive rational c. Both hold on the principal branch.
+void exp_log(const Match& match, SymEngine::vec_basic& out) {
+    const auto& head = match.node.head;
+    if (SymEngine::is_a<SymEngine::Log>(*head)) {
+        const auto arg = match.term(match.node.children[0]);
+        if (!SymEngine::is_a<SymEngine::Mul>(*arg)) {
+            return;
+        }
+        const auto& coef = SymEngine::down_cast<const SymEngine::Mul&>(*arg).get_coef();
+        if (coef->is_exact() && coef->is_positive() && !coef->is_one()) {
+            out.push_back(SymEngine::add(SymEngine::log(coef), SymEngine::log(SymEngine::div(arg, coef))));
+        }
+        return;
+    }
+    if (!SymEngine::is_a<SymEngine::Pow>(*head) || SymEngine::neq(*match.term(match.node.children[0]), *SymEngine::E)) {
+        return;
+    }
+    const auto exponent = match.term(match.node.children[1]);
+    const auto terms = SymEngine::is_a<SymEngine::Add>(*exponent) ? exponent->get_args() : SymEngine::vec_basic{exponent};
+    SymEngine::vec_basic factors;
+    SymEngine::vec_basic rest;
+    for (const auto& term : terms) {
+        RCP<const Basic> logarithm;
+        for (const auto& factor : factors_of(term)) {
+            if (SymEngine::is_a<SymEngine::Log>(*factor.first) && SymEngine::eq(*factor.second, *SymEngine::one)) {
+                logarithm = factor.first;
+                break;
+            }
+        }
+        if (logarithm.is_null()) {
+            rest.push_back(term);
+        } else {
+            const auto base = SymEngine::down_cast<const SymEngine::Log&>(*logarithm).get_arg();
+            factors.push_back(SymEngine::pow(base, SymEngine::div(term, logarithm)));
+        }
+    }
+    if (!factors.empty()) {
+        factors.push_back(SymEngine::exp(SymEngine::add(rest)));
+        out.push_back(SymEngine::mul(factors));
+    }
+}
+
+const Rule kRules[] = {
+    recollect,
+    expand_product,
+    common_factor,
+    pythagorean,
+    quotient,
+    angle,
+    hyperbolic_exp,
+    exp_log,
+};
+
+}
+
+std::size_t EGraph::NodeHash::operator()(const ENode& node) const {
+    if (node.children.empty()) {
+        return node.head->hash();
+    }
+    std::size_t seed = node.head->get_type_code();
+    if (SymEngine::is_a<SymEngine::FunctionSymbol>(*node.head)) {
+        seed ^= std::hash<std::string>()(SymEngine::down_cast<const SymEngine::FunctionSymbol&>(*node.head).get_name());
+    }
+    for (const auto child : node.children) {
+        seed ^= std::hash<ClassId>()(child) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+bool EGraph::NodeEqual::operator()(const ENode& a, const ENode& b) const {
+    if (a.children.empty() || b.children.empty()) {
+        return a.children.empty() && b.children.empty() && SymEngine::eq(*a.head, *b.head);
+    }
+    if (a.head->get_type_code() != b.head->get_type_code() || a.children != b.children) {
+        return false;
+    }
+    if (SymEngine::is_a<SymEngine::FunctionSymbol>(*a.head)) {
+        return SymEngine::down_cast<const SymEngine::FunctionSymbol&>(*a.head).get_name()
+            == SymEngine::down_cast<const SymEngine::FunctionSymbol&>(*b.head).get_name();
+    }
+    return true;
+}
+
+EGraph::ENode EGraph::canonical(const ENode& node) const {
+    ENode result{node.head, node.children};
+    for (auto& child : result.children) {
+        child = find(child);
+    }
+    if (is_commutative(*result.head)) {
+        std::sort(result.children.begin(), result.children.end());
+    }
+    return result;
+}
+
+EGraph::ClassId EGraph::insert(ENode node) {
+    node = canonical(node);
+    const auto found = memo_.find(node);
+    if (found != memo_.end()) {
+        return find(found->second);
+    }
+    const ClassId id = classes_.size();
+    parent_.push_back(id);
+    classes_.push_back({node});
+    memo_.emplace(std::move(node), id);
+    return id;
+}
+
+EGraph::ClassId EGraph::add(const RCP<const Basic>& expr) {
+    ENode node{expr, {}};
+    if (is_operator(*expr)) {
+        for (const auto& arg : expr->get_args()) {
+            node.children.push_back(add(arg));
+        }
+    }
+    return insert(std::move(node));
+}
+
+EGraph::ClassId EGraph::find(ClassId id) const {
+    ClassId root = id;
+    while (parent_[root] != root) {
+        root = parent_[root];
+    }
+    while (parent_[id] != root) {
+        const ClassId next = parent_[id];
+        parent_[id] = root;
+        id = next;
+    }
+    return root;
+}
+
+bool EGraph::merge(ClassId a, ClassId b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return false;
+    }
+    if (classes_[a].size() < classes_[b].size()) {
+        std::swap(a, b);
+    }
+    parent_[b] = a;
+    auto& target = classes_[a];
+    target.insert(target.end(), classes_[b].begin(), classes_[b].end());
+    classes_[b].clear();
+    return true;
+}
+
+void EGraph::rebuild() {
+    for (;;) {
+        std::vector<std::pair<ClassId, ClassId>> congruent;
+        memo_.clear();
+        for (ClassId id = 0; id < classes_.size(); ++id) {
+            if (parent_[id] != id) {
+                continue;
+            }
+            std::vector<ENode> unique;
+            for (const auto& node : classes_[id]) {
+                auto key = canonical(node);
+                const auto found = memo_.find(key);
+                if (found == memo_.end()) {
+                    memo_.emplace(key, id);
+                    unique.push_back(std::move(key));
+                } else if (found->second != id) {
+                    // The same node in two classes: they are equal.
+                    congruent.emplace_back(found->second, id);
+                }
+            }
+            classes_[id] = std::move(unique);
+        }
+        if (congruent.empty()) {
+            return;
+        }
+        for (const auto& pair : congruent) {
+            merge(pair.first, pair.second);
+        }
+    }
+}
+
+std::size_t EGraph::node_count() const {
+    std::size_t count = 0;
+    for (const auto& nodes : classes_) {
+        count += nodes.size();
+    }
+    return count;
+}
+
+std::size_t EGraph::class_count() const {
+    std::size_t count = 0;
+    for (ClassId id = 0; id < parent_.size(); ++id) {
+        count += parent_[id] == id ? 1 : 0;
+    }
+    return count;
+}
+
+std::vector<RCP<const Basic>> EGraph::extract_all(const std::string& objective) const {
+    // Validates the objective before any work is done.
+    expression_cost(*SymEngine::zero, objective);
+    std::vector<RCP<const Basic>> best(classes_.size());
+    std::vector<double> cost(classes_.size(), std::numeric_limits<double>::infinity());
+    // Costs only decrease and are whole numbers, so this terminates.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (ClassId id = 0; id < classes_.size(); ++id) {
+            if (parent_[id] != id) {
+                continue;
+            }
+            for (const auto& node : classes_[id]) {
+                SymEngine::vec_basic args;
+                bool ready = true;
+                for (const auto child : node.children) {
+                    const auto& term = best[find(child)];
+                    if (term.is_null()) {
+                        ready = false;
+                        break;
+                    }
+                    args.push_back(term);
+                }
+                if (!ready) {
+                    continue;
+                }
+                const auto term = build(node.head, args);
+                const double term_cost = expression_cost(*term, objective);
+                if (term_cost < cost[id]) {
+                    cost[id] = term_cost;
+                    best[id] = term;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+RCP<const Basic> EGraph::extract(ClassId id, const std::string& objective) const {
+    return extract_all(objective)[find(id)];
+}
+
+SaturationStats EGraph::saturate(const SaturationBudget& budget, const std::function<bool(const EGraph&)>& goal) {
+    const auto start = Clock::now();
+    const auto out_of_time = [&start, &budget]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= budget.time_ms;
+    };
+    SaturationStats stats{0, 0, 0, "saturated"};
+    const auto finish = [this, &stats](const char* reason) {
+        stats.nodes = node_count();
+        stats.classes = class_count();
+        stats.stop_reason = reason;
+        return stats;
+    };
+    rebuild();
+    if (goal && goal(*this)) {
+        return finish("goal");
+    }
+    for (;;) {
+        if (stats.iterations >= budget.max_iterations) {
+            return finish("iterations");
+        }
+        if (out_of_time()) {
+            return finish("time");
+        }
+        ++stats.iterations;
+        // Match every rule against the graph as it is now, then apply.
+        const auto terms = extract_all("nodes");
+        std::vector<std::pair<ClassId, RCP<const Basic>>> rewrites;
+        for (ClassId id = 0; id < classes_.size(); ++id) {
+            if (parent_[id] != id) {
+                continue;
+            }
+            for (const auto& node : classes_[id]) {
+                Match match{*this, terms, node, {}};
+                match.variants = variants_of(match);
+                SymEngine::vec_basic found;
+                for (const auto rule : kRules) {
+                    rule(match, found);
+                }
+                for (const auto& expr : found) {
+                    rewrites.emplace_back(id, expr);
+                }
+            }
+        }
+        bool grew = false;
+        for (const auto& rewrite : rewrites) {
+            // Every insertion creates one class, so classes_ counts the
+            // e-nodes added so far.
+            if (classes_.size() >= budget.max_nodes) {
+                rebuild();
+                return finish("nodes");
+            }
+            if (out_of_time()) {
+                rebuild();
+                return finish("time");
+            }
+            const std::size_t before = classes_.size();
+            const ClassId id = add(rewrite.second);
+            const bool merged = merge(rewrite.first, id);
+            grew = grew || merged || classes_.size() != before;
+        }
+        rebuild();
+        if (goal && goal(*this)) {
+            return finish("goal");
+        }
+        if (!grew) {
+            return finish("saturated");
+        }
+    }
+}
+
+EGraphSimplifyResult egraph_simplify(const std::string& expr, const std::string& objective, const SaturationBudget& budget) {
+    const auto parsed = parse_expression(expr);
+    try {
+        expression_cost(*parsed, objective);
+        EGraph graph;
+        const auto root = graph.add(parsed);
+        const auto stats = graph.saturate(budget);
+        const auto best = graph.extract(root, objective);
+        return EGraphSimplifyResult{Expression(best), expression_cost(*best, objective), stats};
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+EquivalenceResult egraph_equivalent(const RCP<const Basic>& lhs, const RCP<const Basic>& rhs, const SaturationBudget& budget) {
+    try {
+        EGraph graph;
+        const auto a = graph.add(lhs);
+        const auto b = graph.add(rhs);
+        // The difference reaching 0 proves the identity as well, often
+        // sooner: its terms cancel across the two sides.
+        const auto difference = graph.add(SymEngine::sub(lhs, rhs));
+        const auto zero = graph.add(SymEngine::zero);
+        const auto proved = [a, b, difference, zero](const EGraph& g) {
+            return g.equivalent(a, b) || g.equivalent(difference, zero);
+        };
+        const auto stats = graph.saturate(budget, proved);
+        if (stats.stop_reason == "goal") {
+            return EquivalenceResult{true, stats};
+        }
+        const auto terms = graph.extract_all("nodes");
+        const auto residual = SymEngine::expand(terms[graph.find(difference)]);
+        const auto gap = SymEngine::expand(SymEngine::sub(terms[graph.find(a)], terms[graph.find(b)]));
+        const bool equal = SymEngine::is_zero(*residual) == SymEngine::tribool::tritrue
+            || SymEngine::is_zero(*gap) == SymEngine::tribool::tritrue;
+        return EquivalenceResult{equal, stats};
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+EquivalenceResult egraph_equivalent(const std::string& lhs, const std::string& rhs, const SaturationBudget& budget) {
+    return egraph_equivalent(parse_expression(lhs), parse_expression(rhs), budget);
+}
+
+}
@@ -0,0 +1,130 @@
+#include "mathllm/expression.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/complex.h>
+#include <symengine/complex_double.h>
+#include <symengine/constants.h>
+#include <symengine/eval_double.h>
+#include <symengine/functions.h>
+#include <symengine/infinity.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mathllm {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+
+std::string Expression::kind() const {
+    const Basic& expr = *expr_;
+    if (SymEngine::is_a<SymEngine::Integer>(expr)) {
+        return "Integer";
+    }
+    if (SymEngine::is_a<SymEngine::Rational>(expr)) {
+        return "Rational";
+    }
+    if (SymEngine::is_a<SymEngine::RealDouble>(expr)) {
+        return "Float";
+    }
+    if (SymEngine::is_a<SymEngine::Complex>(expr) || SymEngine::is_a<SymEngine::ComplexDouble>(expr)) {
+        return "Complex";
+    }
+    if (SymEngine::is_a<SymEngine::Symbol>(expr)) {
+        return "Symbol";
+    }
+    if (SymEngine::is_a<SymEngine::Constant>(expr)) {
+        return "Constant";
+    }
+    if (SymEngine::is_a<SymEngine::Infty>(expr)) {
+        return "Infinity";
+    }
+    if (SymEngine::is_a<SymEngine::Add>(expr)) {
+        return "Add";
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(expr)) {
+        return "Mul";
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(expr)) {
+        return "Pow";
+    }
+    if (SymEngine::is_a_sub<SymEngine::Function>(expr)) {
+        return "Function";
+    }
+    return "Other";
+}
+
+std::string Expression::name() const {
+    const Basic& expr = *expr_;
+    if (SymEngine::is_a<SymEngine::Integer>(expr)) {
+        return expr.__str__();
+    }
+    if (SymEngine::is_a<SymEngine::Symbol>(expr)) {
+        return SymEngine::down_cast<const SymEngine::Symbol&>(expr).get_name();
+    }
+    if (SymEngine::is_a<SymEngine::Constant>(expr)) {
+        return SymEngine::down_cast<const SymEngine::Constant&>(expr).get_name();
+    }
+    if (SymEngine::is_a<SymEngine::Infty>(expr)) {
+        const auto& infinity = SymEngine::down_cast<const SymEngine::Infty&>(expr);
+        if (infinity.is_positive_infinity()) {
+            return "oo";
+        }
+        return infinity.is_negative_infinity() ? "-oo" : "zoo";
+    }
+    if (SymEngine::is_a_sub<SymEngine::Function>(expr)) {
+        // The printer writes functions as name(args).
+        const std::string printed = expr.__str__();
+        return printed.substr(0, printed.find('('));
+    }
+    return "";
+}
+
+std::vector<Expression> Expression::args() const {
+    std::vector<Expression> result;
+    const Basic& expr = *expr_;
+    if (SymEngine::is_a<SymEngine::Rational>(expr)) {
+        const auto& rational = SymEngine::down_cast<const SymEngine::Rational&>(expr);
+        result.emplace_back(rational.get_num());
+        result.emplace_back(rational.get_den());
+        return result;
+    }
+    if (SymEngine::is_a<SymEngine::Complex>(expr)) {
+        const auto& complex = SymEngine::down_cast<const SymEngine::Complex&>(expr);
+        result.emplace_back(complex.real_part());
+        result.emplace_back(complex.imaginary_part());
+        return result;
+    }
+    if (SymEngine::is_a<SymEngine::ComplexDouble>(expr)) {
+        const auto value = SymEngine::down_cast<const SymEngine::ComplexDouble&>(expr).i;
+        result.emplace_back(SymEngine::real_double(value.real()));
+        result.emplace_back(SymEngine::real_double(value.imag()));
+        return result;
+    }
+    for (const auto& arg : expr.get_args()) {
+        result.emplace_back(arg);
+    }
+    return result;
+}
+
+std::complex<double> Expression::approximation() const {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (!SymEngine::free_symbols(*expr_).empty()) {
+        return {nan, nan};
+    }
+    try {
+        return SymEngine::eval_complex_double(*expr_);
+    } catch (const SymEngine::SymEngineException&) {
+        return {nan, nan};
+    }
+}
+
+}
@@ -0,0 +1,1063 @@
+#include "mathllm/groebner.h"
+#include "mathllm/polynomial.h"
+#include "mathllm/roots.h"
+#include "mathllm/solver.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/eval_double.h>
+#include <symengine/integer.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/subs.h>
+#include <symengine/symbol.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::Symbol;
+using Clock = std::chrono::steady_clock;
+
+// Reductions check the clock once per this many steps.
+const int kClockInterval = 64;
+// Numerically completed solutions must satisfy every basis polynomial to
+// this tolerance, relative to the magnitude of its terms.
+const double kResidualTolerance = 1e-8;
+
+// Exponent of each variable, in the order the variables were given.
+using Exponents = std::vector<int>;
+
+enum class MonomialOrder { Lex, Grevlex };
+
+int total_degree(const Exponents& e) {
+    return std::accumulate(e.begin(), e.end(), 0);
+}
+
+// Negative, zero or positive as a is below, equal to or above b.
+int compare(const Exponents& a, const Exponents& b, MonomialOrder order) {
+    if (order == MonomialOrder::Grevlex) {
+        const int da = total_degree(a);
+        const int db = total_degree(b);
+        if (da != db) {
+            return da < db ? -1 : 1;
+        }
+        for (std::size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) {
+                return a[i] > b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+struct MonomialGreater {
+    MonomialOrder order;
+    bool operator()(const Exponents& a, const Exponents& b) const {
+        return compare(a, b, order) > 0;
+    }
+};
+
+bool divides(const Exponents& a, const Exponents& b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] > b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool coprime(const Exponents& a, const Exponents& b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i] > 0 && b[i] > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Exponents lcm(const Exponents& a, const Exponents& b) {
+    Exponents out(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        out[i] = std::max(a[i], b[i]);
+    }
+    return out;
+}
+
+Exponents quotient(const Exponents& a, const Exponents& b) {
+    Exponents out(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        out[i] = a[i] - b[i];
+    }
+    return out;
+}
+
+Exponents product(const Exponents& a, const Exponents& b) {
+    Exponents out(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        out[i] = a[i] + b[i];
+    }
+    return out;
+}
+
+struct RationalField {
+    using Value = SymEngine::rational_class;
+
+    static bool is_zero(const Value& a) { return a == 0; }
+    Value from_rational(const SymEngine::rational_class& q) const { return q; }
+    Value add(const Value& a, const Value& b) const { return a + b; }
+    Value sub(const Value& a, const Value& b) const { return a - b; }
+    Value mul(const Value& a, const Value& b) const { return a * b; }
+    Value div(const Value& a, const Value& b) const { return a / b; }
+    Value neg(const Value& a) const { return -a; }
+};
+
+// GF(p) for a prime p < 2^31, so products fit in 64 bits.
+struct ModularField {
+    using Value = std::uint64_t;
+
+    std::uint64_t p;
+
+    static bool is_zero(Value a) { return a == 0; }
+    Value from_rational(const SymEngine::rational_class& q) const {
+        const SymEngine::integer_class modulus(static_cast<unsigned long>(p));
+        SymEngine::integer_class num;
+        SymEngine::integer_class den;
+        SymEngine::mp_fdiv_r(num, SymEngine::get_num(q), modulus);
+        SymEngine::mp_fdiv_r(den, SymEngine::get_den(q), modulus);
+        if (den == 0) {
+            throw NumericError("Coefficient denominator is divisible by the modulus");
+        }
+        return div(SymEngine::mp_get_ui(num), SymEngine::mp_get_ui(den));
+    }
+    Value add(Value a, Value b) const { return (a + b) % p; }
+    Value sub(Value a, Value b) const { return (a + p - b) % p; }
+    Value mul(Value a, Value b) const { return a * b % p; }
+    Value neg(Value a) const { return a == 0 ? 0 : p - a; }
+    Value div(Value a, Value b) const {
+        // Fermat: b^(p - 2) is the inverse of b.
+        Value inverse = 1;
+        Value base = b;
+        for (std::uint64_t e = p - 2; e > 0; e >>= 1) {
+            if (e & 1) {
+                inverse = mul(inverse, base);
+            }
+            base = mul(base, base);
+        }
+        return mul(a, inverse);
+    }
+};
+
+template <typename Field>
+struct Polynomial {
+    using Term = std::pair<Exponents, typename Field::Value>;
+
+    // Strictly decreasing monomials, no zero coefficients.
+    std::vector<Term> terms;
+    // Degree the polynomial would have if the input were homogenised.
+    int sugar = 0;
+
+    bool is_zero() const { return terms.empty(); }
+    bool is_constant() const { return terms.size() == 1 && total_degree(terms.front().first) == 0; }
+    const Exponents& lead() const { return terms.front().first; }
+};
+
+struct BudgetExceeded {};
+
+class Budget {
+public:
+    explicit Budget(const GroebnerBudget& limits)
+        : deadline_(Clock::now() + std::chrono::microseconds(static_cast<long long>(limits.time_ms * 1000.0))),
+          max_terms_(limits.max_terms) {}
+
+    void check(std::size_t terms) {
+        if (terms > max_terms_) {
+            throw BudgetExceeded();
+        }
+        if (++steps_ % kClockInterval == 0 && Clock::now() > deadline_) {
+            throw BudgetExceeded();
+        }
+    }
+
+private:
+    Clock::time_point deadline_;
+    std::size_t max_terms_;
+    int steps_ = 0;
+};
+
+template <typename Field>
+Polynomial<Field> monic(const Field& field, Polynomial<Field> f) {
+    if (f.is_zero()) {
+        return f;
+    }
+    const auto lc = f.terms.front().second;
+    for (auto& term : f.terms) {
+        term.second = field.div(term.second, lc);
+    }
+    return f;
+}
+
+template <typename Field>
+Polynomial<Field> from_map(std::map<Exponents, typename Field::Value, MonomialGreater>&& terms, int sugar) {
+    Polynomial<Field> out;
+    out.sugar = sugar;
+    for (auto& term : terms) {
+        if (!Field::is_zero(term.second)) {
+            out.terms.emplace_back(term.first, std::move(term.second));
+        }
+    }
+    return out;
+}
+
+// Buchberger's algorithm over Field. Pairs are selected by lowest sugar,
+// then lowest lcm; the Gebauer-Moeller update drops pairs whose S-polynomial
+// reduces to zero by the product or chain criterion. Polynomials are kept
+// monic and reduced against the basis before they join it.
+template <typename Field>
+class GroebnerEngine {
+public:
+    using Poly = Polynomial<Field>;
+
+    GroebnerEngine(const Field& field, MonomialOrder order, Budget& budget)
+        : field_(field), order_(order), budget_(budget) {}
+
+    // False when the budget ran out; the basis then still generates the
+    // ideal but need not be a Groebner basis.
+    bool run(const std::vector<Poly>& generators) {
+        try {
+            for (const auto& f : generators) {
+                if (!f.is_zero()) {
+                    insert(normal_form(f));
+                }
+            }
+            while (!pairs_.empty()) {
+                budget_.check(terms_);
+                auto best = pairs_.begin();
+                for (auto it = pairs_.begin(); it != pairs_.end(); ++it) {
+                    if (it->sugar < best->sugar || (it->sugar == best->sugar && compare(it->lcm, best->lcm, order_) < 0)) {
+                        best = it;
+                    }
+                }
+                const Pair pair = *best;
+                *best = pairs_.back();
+                pairs_.pop_back();
+                ++pairs_processed;
+                Poly h = normal_form(s_polynomial(pair));
+                if (h.is_zero()) {
+                    ++zero_reductions;
+                    continue;
+                }
+                insert(std::move(h));
+            }
+        } catch (const BudgetExceeded&) {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<Poly> basis() const {
+        std::vector<Poly> out;
+        for (std::size_t i = 0; i < polys_.size(); ++i) {
+            if (active_[i]) {
+                out.push_back(polys_[i]);
+            }
+        }
+        return out;
+    }
+
+    // The active polynomials already have pairwise non-dividing leading
+    // monomials; reducing each tail against the others leaves the unique
+    // reduced basis.
+    std::vector<Poly> reduced_basis() {
+        std::vector<Poly> out;
+        const std::vector<Poly> minimal = basis();
+        for (std::size_t i = 0; i < minimal.size(); ++i) {
+            std::vector<const Poly*> others;
+            for (std::size_t j = 0; j < minimal.size(); ++j) {
+                if (j != i) {
+                    others.push_back(&minimal[j]);
+                }
+            }
+            out.push_back(monic(field_, reduce(minimal[i], others)));
+        }
+        std::sort(out.begin(), out.end(), [this](const Poly& lhs, const Poly& rhs) {
+            return compare(lhs.lead(), rhs.lead(), order_) > 0;
+        });
+        return out;
+    }
+
+    int pairs_processed = 0;
+    int zero_reductions = 0;
+
+private:
+    struct Pair {
+        std::size_t i;
+        std::size_t j;
+        Exponents lcm;
+        int sugar;
+    };
+
+    Pair make_pair(std::size_t i, std::size_t j) const {
+        const Poly& f = polys_[i];
+        const Poly& g = polys_[j];
+        Pair pair{i, j, lcm(f.lead(), g.lead()), 0};
+        const int degree = total_degree(pair.lcm);
+        pair.sugar = std::max(f.sugar - total_degree(f.lead()), g.sugar - total_degree(g.lead())) + degree;
+        return pair;
+    }
+
+    Poly s_polynomial(const Pair& pair) const {
+        const Poly& f = polys_[pair.i];
+        const Poly& g = polys_[pair.j];
+        const Exponents uf = quotient(pair.lcm, f.lead());
+        const Exponents ug = quotient(pair.lcm, g.lead());
+        std::map<Exponents, typename Field::Value, MonomialGreater> work(MonomialGreater{order_});
+        for (const auto& term : f.terms) {
+            work.emplace(product(term.first, uf), term.second);
+        }
+        for (const auto& term : g.terms) {
+            auto it = work.emplace(product(term.first, ug), field_.neg(term.second));
+            if (!it.second) {
+                it.first->second = field_.sub(it.first->second, term.second);
+            }
+        }
+        return from_map<Field>(std::move(work), pair.sugar);
+    }
+
+    Poly normal_form(const Poly& f) {
+        std::vector<const Poly*> divisors;
+        for (std::size_t i = 0; i < polys_.size(); ++i) {
+            if (active_[i]) {
+                divisors.push_back(&polys_[i]);
+            }
+        }
+        return monic(field_, reduce(f, divisors));
+    }
+
+    // Full reduction of f by the divisors, which are monic.
+    Poly reduce(const Poly& f, const std::vector<const Poly*>& divisors) {
+        std::map<Exponents, typename Field::Value, MonomialGreater> work(
+            f.terms.begin(), f.terms.end(), MonomialGreater{order_});
+        Poly out;
+        out.sugar = f.sugar;
+        while (!work.empty()) {
+            budget_.check(terms_ + work.size() + out.terms.size());
+            auto lead = work.begin();
+            const Poly* divisor = nullptr;
+            for (const Poly* g : divisors) {
+                if (divides(g->lead(), lead->first)) {
+                    divisor = g;
+                    break;
+                }
+            }
+            if (divisor == nullptr) {
+                out.terms.emplace_back(lead->first, std::move(lead->second));
+                work.erase(lead);
+                continue;
+            }
+            const Exponents shift = quotient(lead->first, divisor->lead());
+            const auto factor = lead->second;
+            out.sugar = std::max(out.sugar, divisor->sugar + total_degree(shift));
+            work.erase(lead);
+            for (auto term = divisor->terms.begin() + 1; term != divisor->terms.end(); ++term) {
+                const auto delta = field_.mul(factor, term->second);
+                auto it = work.emplace(product(term->first, shift), field_.neg(delta));
+                if (!it.second) {
+                    it.first->second = field_.sub(it.first->second, delta);
+                    if (Field::is_zero(it.first->second)) {
+                        work.erase(it.first);
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // Gebauer-Moeller update for the new basis element polys_[t].
+    void insert(Poly h) {
+        if (h.is_zero()) {
+            return;
+        }
+        const std::size_t t = polys_.size();
+        terms_ += h.terms.size();
+        polys_.push_back(std::move(h));
+        active_.push_back(false);
+        const Exponents& lt = polys_[t].lead();
+
+        std::vector<Pair> candidates;
+        for (std::size_t i = 0; i < t; ++i) {
+            if (active_[i]) {
+                candidates.push_back(make_pair(i, t));
+            }
+        }
+        // Chain criterion among the new pairs: keep a pair only if no other
+        // pair with the new element has an lcm dividing its lcm.
+        std::vector<Pair> chained;
+        for (std::size_t k = 0; k < candidates.size(); ++k) {
+            const Pair& pair = candidates[k];
+            bool keep = coprime(polys_[pair.i].lead(), lt);
+            if (!keep) {
+                keep = true;
+                for (std::size_t m = k + 1; m < candidates.size() && keep; ++m) {
+                    keep = !divides(candidates[m].lcm, pair.lcm);
+                }
+                for (const auto& other : chained) {
+                    keep = keep && !divides(other.lcm, pair.lcm);
+                }
+            }
+            if (keep) {
+                chained.push_back(pair);
+            }
+        }
+        // Old pairs whose lcm the new leading monomial divides strictly are
+        // covered by the two new pairs.
+        std::vector<Pair> kept;
+        for (auto& pair : pairs_) {
+            if (!divides(lt, pair.lcm) || lcm(polys_[pair.i].lead(), lt) == pair.lcm
+                || lcm(polys_[pair.j].lead(), lt) == pair.lcm) {
+                kept.push_back(std::move(pair));
+            }
+        }
+        // Product criterion: coprime leading monomials reduce to zero.
+        for (auto& pair : chained) {
+            if (!coprime(polys_[pair.i].lead(), lt)) {
+                kept.push_back(std::move(pair));
+            }
+        }
+        pairs_ = std::move(kept);
+
+        for (std::size_t i = 0; i < t; ++i) {
+            if (active_[i] && divides(lt, polys_[i].lead())) {
+                active_[i] = false;
+            }
+        }
+        active_[t] = true;
+        if (polys_[t].is_constant()) {
+            // The ideal is the whole ring: {1} is its reduced basis.
+            std::fill(active_.begin(), active_.end(), false);
+            active_[t] = true;
+            pairs_.clear();
+        }
+    }
+
+    Field field_;
+    MonomialOrder order_;
+    Budget& budget_;
+    std::vector<Poly> polys_;
+    std::vector<bool> active_;
+    std::vector<Pair> pairs_;
+    std::size_t terms_ = 0;
+};
+
+// Conversion between SymEngine expressions and polynomials.
+
+SymEngine::rational_class to_rational(const RCP<const Basic>& number) {
+    if (SymEngine::is_a<SymEngine::Integer>(*number)) {
+        return SymEngine::rational_class(SymEngine::down_cast<const SymEngine::Integer&>(*number).as_integer_class());
+    }
+    if (SymEngine::is_a<SymEngine::Rational>(*number)) {
+        return SymEngine::down_cast<const SymEngine::Rational&>(*number).as_rational_class();
+    }
+    throw SymbolicError("Polynomial coefficients must be rational: " + number->__str__());
+}
+
+RCP<const SymEngine::Number> to_number(const SymEngine::rational_class& value) {
+    return SymEngine::Rational::from_mpq(value);
+}
+
+RCP<const SymEngine::Number> to_number(std::uint64_t value) {
+    return SymEngine::integer(SymEngine::integer_class(static_cast<unsigned long>(value)));
+}
+
+void add_factor(
+    const RCP<const Basic>& base,
+    const RCP<const Basic>& exp,
+    const std::vector<RCP<const Symbol>>& symbols,
+    Exponents& exponents
+) {
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        if (!SymEngine::eq(*base, *symbols[i])) {
+            continue;
+        }
+        if (!SymEngine::is_a<SymEngine::Integer>(*exp)
+            || !SymEngine::down_cast<const SymEngine::Integer&>(*exp).is_positive()) {
+            break;
+        }
+        exponents[i] += SymEngine::down_cast<const SymEngine::Integer&>(*exp).as_int();
+        return;
+    }
+    throw SymbolicError("Not a polynomial in the given variables: " + SymEngine::pow(base, exp)->__str__());
+}
+
+// Terms of the expanded expr, keyed by their exponents.
+std::map<Exponents, SymEngine::rational_class> collect_terms(
+    const RCP<const Basic>& expr,
+    const std::vector<RCP<const Symbol>>& symbols
+) {
+    std::map<Exponents, SymEngine::rational_class> terms;
+    const auto add_term = [&](const RCP<const Basic>& term) {
+        Exponents exponents(symbols.size(), 0);
+        SymEngine::rational_class coeff(1);
+        if (SymEngine::is_a_Number(*term)) {
+            coeff = to_rational(term);
+        } else if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+            const auto& mul = SymEngine::down_cast<const SymEngine::Mul&>(*term);
+            coeff = to_rational(mul.get_coef());
+            for (const auto& factor : mul.get_dict()) {
+                add_factor(factor.first, factor.second, symbols, exponents);
+            }
+        } else if (SymEngine::is_a<SymEngine::Pow>(*term)) {
+            const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*term);
+            add_factor(pow.get_base(), pow.get_exp(), symbols, exponents);
+        } else {
+            add_factor(term, SymEngine::one, symbols, exponents);
+        }
+        terms[exponents] += coeff;
+    };
+    try {
+        const auto expanded = SymEngine::expand(expr);
+        if (SymEngine::is_a<SymEngine::Add>(*expanded)) {
+            for (const auto& term : expanded->get_args()) {
+                add_term(term);
+            }
+        } else {
+            add_term(expanded);
+        }
+    } catch (const SymbolicError&) {
+        throw;
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+    return terms;
+}
+
+template <typename Field>
+Polynomial<Field> to_polynomial(
+    const Field& field,
+    MonomialOrder order,
+    const std::map<Exponents, SymEngine::rational_class>& terms
+) {
+    std::map<Exponents, typename Field::Value, MonomialGreater> sorted(MonomialGreater{order});
+    for (const auto& term : terms) {
+        sorted.emplace(term.first, field.from_rational(term.second));
+    }
+    Polynomial<Field> out = from_map<Field>(std::move(sorted), 0);
+    for (const auto& term : out.terms) {
+        out.sugar = std::max(out.sugar, total_degree(term.first));
+    }
+    return out;
+}
+
+template <typename Field>
+RCP<const Basic> to_basic(const Polynomial<Field>& f, const std::vector<RCP<const Symbol>>& symbols) {
+    SymEngine::vec_basic terms;
+    for (const auto& term : f.terms) {
+        SymEngine::vec_basic factors = {to_number(term.second)};
+        for (std::size_t i = 0; i < symbols.size(); ++i) {
+            if (term.first[i] > 0) {
+                factors.push_back(SymEngine::pow(symbols[i], SymEngine::integer(term.first[i])));
+            }
+        }
+        terms.push_back(SymEngine::mul(factors));
+    }
+    return SymEngine::add(terms);
+}
+
+template <typename Field>
+std::vector<std::string> to_strings(
+    const std::vector<Polynomial<Field>>& polys,
+    const std::vector<RCP<const Symbol>>& symbols
+) {
+    std::vector<std::string> out;
+    for (const auto& f : polys) {
+        out.push_back(to_basic(f, symbols)->__str__());
+    }
+    return out;
+}
+
+std::vector<RCP<const Symbol>> make_symbols(const std::vector<std::string>& vars) {
+    if (vars.empty()) {
+        throw NumericError("A polynomial system needs at least one variable");
+    }
+    std::vector<RCP<const Symbol>> symbols;
+    for (const auto& var : vars) {
+        symbols.push_back(SymEngine::symbol(var));
+    }
+    return symbols;
+}
+
+bool is_prime(std::uint32_t n) {
+    if (n < 2) {
+        return false;
+    }
+    for (std::uint32_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Field>
+GroebnerResult run_groebner(
+    const Field& field,
+    MonomialOrder order,
+    const std::vector<std::map<Exponents, SymEngine::rational_class>>& inputs,
+    const std::vector<RCP<const Symbol>>& symbols,
+    const GroebnerBudget& limits
+) {
+    std::vector<Polynomial<Field>> generators;
+    for (const auto& terms : inputs) {
+        generators.push_back(to_polynomial(field, order, terms));
+    }
+    Budget budget(limits);
+    GroebnerEngine<Field> engine(field, order, budget);
+    GroebnerResult result{{}, engine.run(generators), 0, 0};
+    result.pairs_processed = engine.pairs_processed;
+    result.zero_reductions = engine.zero_reductions;
+    if (result.complete) {
+        try {
+            result.basis = to_strings(engine.reduced_basis(), symbols);
+            return result;
+        } catch (const BudgetExceeded&) {
+            result.complete = false;
+        }
+    }
+    result.basis = to_strings(engine.basis(), symbols);
+    return result;
+}
+
+using RationalPoly = Polynomial<RationalField>;
+// Basis polynomial with coefficients rounded to double.
+using NumericPoly = std::vector<std::pair<Exponents, double>>;
+
+bool is_pure_power(const Exponents& e, std::size_t index) {
+    for (std::size_t i = 0; i < e.size(); ++i) {
+        if ((i == index) != (e[i] > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True when every term of f is free of the variables other than index,
+// skipping the leading term if skip_lead is set.
+bool only_in(const RationalPoly& f, std::size_t index, bool skip_lead) {
+    for (std::size_t t = skip_lead ? 1 : 0; t < f.terms.size(); ++t) {
+        const Exponents& e = f.terms[t].first;
+        for (std::size_t i = 0; i < e.size(); ++i) {
+            if (i != index && e[i] > 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// x_index - value.
+RationalPoly linear(std::size_t index, std::size_t n, const SymEngine::rational_class& value) {
+    RationalPoly out;
+    Exponents e(n, 0);
+    e[index] = 1;
+    out.terms.emplace_back(e, SymEngine::rational_class(1));
+    if (value != 0) {
+        out.terms.emplace_back(Exponents(n, 0), -value);
+    }
+    out.sugar = 1;
+    return out;
+}
+
+RationalPoly substitute(const RationalPoly& f, std::size_t index, const SymEngine::rational_class& value) {
+    std::map<Exponents, SymEngine::rational_class, MonomialGreater> terms(MonomialGreater{MonomialOrder::Lex});
+    int sugar = 0;
+    for (const auto& term : f.terms) {
+        SymEngine::rational_class coeff = term.second;
+        for (int k = 0; k < term.first[index]; ++k) {
+            coeff *= value;
+        }
+        Exponents e = term.first;
+        e[index] = 0;
+        sugar = std::max(sugar, total_degree(e));
+        terms[e] += coeff;
+    }
+    return from_map<RationalField>(std::move(terms), sugar);
+}
+
+DensePoly to_dense(const RationalPoly& f, std::size_t index) {
+    std::vector<DensePoly::Coeff> coeffs(f.lead()[index] + 1, SymEngine::zero);
+    for (const auto& term : f.terms) {
+        coeffs[term.first[index]] = to_number(term.second);
+    }
+    return DensePoly(coeffs);
+}
+
+RationalPoly from_dense(const DensePoly& p, std::size_t index, std::size_t n) {
+    RationalPoly out;
+    for (int k = p.degree(); k >= 0; --k) {
+        const auto coeff = to_rational(p.coeff(k));
+        if (coeff != 0) {
+            Exponents e(n, 0);
+            e[index] = k;
+            out.terms.emplace_back(e, coeff);
+        }
+    }
+    out.sugar = p.degree();
+    return out;
+}
+
+// Splits a system along the univariate polynomial of its lex basis and
+// collects solutions and components into result.
+class TriangularSolver {
+public:
+    TriangularSolver(
+        const std::vector<RCP<const Symbol>>& symbols,
+        const GroebnerBudget& limits,
+        PolynomialSystemResult& result
+    )
+        : symbols_(symbols), budget_(limits), result_(result) {}
+
+    bool positive_dimensional() const { return positive_dimensional_; }
+
+    // values holds the variables already fixed to rationals, fixed the
+    // matching x_i - r polynomials; polys no longer involve those variables.
+    void solve(
+        const std::vector<RationalPoly>& polys,
+        const std::vector<RCP<const Basic>>& values,
+        const std::vector<RationalPoly>& fixed
+    ) {
+        const auto basis = lex_basis(polys);
+        if (!basis.empty() && basis.front().is_constant()) {
+            return;
+        }
+        std::size_t last = symbols_.size();
+        for (std::size_t i = 0; i < symbols_.size(); ++i) {
+            if (!values[i].is_null()) {
+                continue;
+            }
+            const bool bounded = std::any_of(basis.begin(), basis.end(), [i](const RationalPoly& g) {
+                return is_pure_power(g.lead(), i);
+            });
+            if (!bounded) {
+                positive_dimensional_ = true;
+                record_component(basis, fixed);
+                return;
+            }
+            last = i;
+        }
+        if (last == symbols_.size()) {
+            record_component(basis, fixed);
+            record_solution(values);
+            return;
+        }
+
+        // The smallest element of a zero-dimensional lex basis is the
+        // univariate polynomial in the last variable.
+        if (!only_in(basis.back(), last, false)) {
+            positive_dimensional_ = true;
+            record_component(basis, fixed);
+            return;
+        }
+        const DensePoly univariate = to_dense(basis.back(), last).square_free_part();
+        DensePoly rest = univariate;
+        for (const auto& root : univariate.rational_roots()) {
+            DensePoly quotient;
+            DensePoly remainder;
+            DensePoly::divmod(rest, DensePoly({SymEngine::mulnum(SymEngine::minus_one, root), SymEngine::one}), quotient, remainder);
+            rest = quotient;
+
+            const auto value = to_rational(root);
+            std::vector<RationalPoly> substituted;
+            for (const auto& g : basis) {
+                substituted.push_back(substitute(g, last, value));
+            }
+            auto next_values = values;
+            next_values[last] = root;
+            auto next_fixed = fixed;
+            next_fixed.push_back(linear(last, symbols_.size(), value));
+            solve(substituted, next_values, next_fixed);
+        }
+        if (rest.degree() >= 1) {
+            solve_factor(basis, rest, last, values, fixed);
+        }
+    }
+
+private:
+    std::vector<RationalPoly> lex_basis(const std::vector<RationalPoly>& polys) {
+        GroebnerEngine<RationalField> engine(RationalField(), MonomialOrder::Lex, budget_);
+        if (!engine.run(polys)) {
+            throw BudgetExceeded();
+        }
+        return engine.reduced_basis();
+    }
+
+    // Component of the basis on which the last variable is a root of
+    // factor, which has no rational roots.
+    void solve_factor(
+        const std::vector<RationalPoly>& basis,
+        const DensePoly& factor,
+        std::size_t last,
+        const std::vector<RCP<const Basic>>& values,
+        const std::vector<RationalPoly>& fixed
+    ) {
+        std::vector<RationalPoly> polys = basis;
+        polys.push_back(from_dense(factor, last, symbols_.size()));
+        const auto component = lex_basis(polys);
+        record_component(component, fixed);
+
+        // Shape position: an element x_i - h_i(x_last) for every other
+        // unknown, so each root of factor fixes the whole solution.
+        std::vector<std::pair<std::size_t, RCP<const Basic>>> shape;
+        bool in_shape = true;
+        for (std::size_t i = 0; i < last && in_shape; ++i) {
+            if (!values[i].is_null()) {
+                continue;
+            }
+            const auto it = std::find_if(component.begin(), component.end(), [i, last](const RationalPoly& g) {
+                return is_pure_power(g.lead(), i) && g.lead()[i] == 1 && only_in(g, last, true);
+            });
+            in_shape = it != component.end();
+            if (in_shape) {
+                shape.emplace_back(i, SymEngine::sub(symbols_[i], to_basic(*it, symbols_)));
+            }
+        }
+
+        const auto roots = polynomial_roots(factor);
+        if (in_shape) {
+            for (const auto& root : roots) {
+                auto solution = values;
+                solution[last] = root;
+                SymEngine::map_basic_basic at_root = {{symbols_[last], root}};
+                for (const auto& entry : shape) {
+                    solution[entry.first] = SymEngine::expand(SymEngine::subs(entry.second, at_root));
+                }
+                record_solution(solution);
+            }
+            return;
+        }
+
+        result_.exact = false;
+        std::vector<NumericPoly> numeric;
+        for (const auto& g : component) {
+            NumericPoly terms;
+            for (const auto& term : g.terms) {
+                terms.emplace_back(term.first, SymEngine::mp_get_d(term.second));
+            }
+            numeric.push_back(std::move(terms));
+        }
+        for (const auto& root : roots) {
+            const std::complex<double> z = SymEngine::eval_complex_double(*root);
+            if (std::abs(z.imag()) > kResidualTolerance * std::max(1.0, std::abs(z))) {
+                continue;
+            }
+            std::vector<double> point(symbols_.size(), 0.0);
+            std::vector<bool> known(symbols_.size(), false);
+            for (std::size_t i = 0; i < symbols_.size(); ++i) {
+                if (!values[i].is_null()) {
+                    point[i] = SymEngine::eval_double(*values[i]);
+                    known[i] = true;
+                }
+            }
+            point[last] = z.real();
+            known[last] = true;
+            auto exact = values;
+            exact[last] = root;
+            complete_numeric(numeric, point, known, exact);
+        }
+    }
+
+    // Solves for the remaining unknowns from the last one up: each takes
+    // the real roots of the lowest-degree basis element in it and known
+    // variables. Candidates that do not satisfy the whole basis are dropped.
+    void complete_numeric(
+        const std::vector<NumericPoly>& basis,
+        std::vector<double>& point,
+        std::vector<bool>& known,
+        const std::vector<RCP<const Basic>>& exact
+    ) {
+        const std::size_t n = symbols_.size();
+        std::size_t next = n;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!known[i]) {
+                next = i;
+            }
+        }
+        if (next == n) {
+            for (const auto& g : basis) {
+                double value = 0.0;
+                double scale = 0.0;
+                for (const auto& term : g) {
+                    double t = term.second;
+                    for (std::size_t k = 0; k < n; ++k) {
+                        t *= std::pow(point[k], term.first[k]);
+                    }
+                    value += t;
+                    scale += std::abs(t);
+                }
+                if (std::abs(value) > kResidualTolerance * scale) {
+                    return;
+                }
+            }
+            std::vector<RCP<const Basic>> solution = exact;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (solution[i].is_null()) {
+                    solution[i] = SymEngine::real_double(point[i]);
+                }
+            }
+            record_solution(solution);
+            return;
+        }
+
+        std::vector<std::pair<int, const NumericPoly*>> candidates;
+        for (const auto& g : basis) {
+            int degree = 0;
+            bool usable = true;
+            for (const auto& term : g) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    usable = usable && (k == next || known[k] || term.first[k] == 0);
+                }
+                degree = std::max(degree, term.first[next]);
+            }
+            if (usable && degree > 0) {
+                candidates.emplace_back(degree, &g);
+            }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        for (const auto& candidate : candidates) {
+            std::vector<double> coeffs(candidate.first + 1, 0.0);
+            double scale = 0.0;
+            for (const auto& term : *candidate.second) {
+                double t = term.second;
+                for (std::size_t k = 0; k < n; ++k) {
+                    if (k != next) {
+                        t *= std::pow(point[k], term.first[k]);
+                    }
+                }
+                coeffs[term.first[next]] += t;
+                scale += std::abs(t);
+            }
+            // The leading coefficient vanishes at this point: the element
+            // says nothing about next here.
+            if (std::abs(coeffs.back()) <= kResidualTolerance * scale) {
+                continue;
+            }
+            known[next] = true;
+            for (const auto& root : find_polynomial_roots(coeffs).roots) {
+                if (root.value.imag() == 0.0) {
+                    point[next] = root.value.real();
+                    complete_numeric(basis, point, known, exact);
+                }
+            }
+            known[next] = false;
+            return;
+        }
+    }
+
+    void record_component(const std::vector<RationalPoly>& basis, const std::vector<RationalPoly>& fixed) {
+        std::vector<RationalPoly> component = basis;
+        component.insert(component.end(), fixed.begin(), fixed.end());
+        std::sort(component.begin(), component.end(), [](const RationalPoly& lhs, const RationalPoly& rhs) {
+            return compare(lhs.lead(), rhs.lead(), MonomialOrder::Lex) > 0;
+        });
+        result_.triangular_sets.push_back(to_strings(component, symbols_));
+    }
+
+    void record_solution(const std::vector<RCP<const Basic>>& values) {
+        std::vector<std::string> solution;
+        for (const auto& value : values) {
+            solution.push_back(value->__str__());
+        }
+        result_.solutions.push_back(std::move(solution));
+    }
+
+    const std::vector<RCP<const Symbol>>& symbols_;
+    Budget budget_;
+    PolynomialSystemResult& result_;
+    bool positive_dimensional_ = false;
+};
+
+}
+
+GroebnerResult groebner_basis(
+    const std::vector<std::string>& polys,
+    const std::vector<std::string>& vars,
+    const std::string& order,
+    std::uint32_t modulus,
+    const GroebnerBudget& budget
+) {
+    MonomialOrder monomial_order;
+    if (order == "lex") {
+        monomial_order = MonomialOrder::Lex;
+    } else if (order == "grevlex") {
+        monomial_order = MonomialOrder::Grevlex;
+    } else {
+        throw NumericError("Unknown monomial order: " + order);
+    }
+    if (modulus != 0 && (modulus >= (1u << 31) || !is_prime(modulus))) {
+        throw NumericError("Modulus must be 0 or a prime below 2^31");
+    }
+    const auto symbols = make_symbols(vars);
+    std::vector<std::map<Exponents, SymEngine::rational_class>> inputs;
+    for (const auto& poly : polys) {
+        inputs.push_back(collect_terms(parse_equation(poly), symbols));
+    }
+    if (modulus == 0) {
+        return run_groebner(RationalField(), monomial_order, inputs, symbols, budget);
+    }
+    return run_groebner(ModularField{modulus}, monomial_order, inputs, symbols, budget);
+}
+
+PolynomialSystemResult solve_polynomial_system(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const GroebnerBudget& budget
+) {
+    if (equations.empty()) {
+        throw NumericError("A polynomial system needs at least one equation");
+    }
+    const auto symbols = make_symbols(vars);
+    std::vector<RationalPoly> generators;
+    for (const auto& equation : equations) {
+        generators.push_back(
+            to_polynomial(RationalField(), MonomialOrder::Lex, collect_terms(parse_equation(equation), symbols)));
+    }
+
+    PolynomialSystemResult result{"finite", {}, {}, true};
+    TriangularSolver solver(symbols, budget, result);
+    try {
+        solver.solve(generators, std::vector<RCP<const Basic>>(symbols.size()), {});
+    } catch (const BudgetExceeded&) {
+        result.status = "budget_exceeded";
+        return result;
+    }
+    if (solver.positive_dimensional()) {
+        result.status = "infinite";
+    } else if (result.triangular_sets.empty()) {
+        result.status = "inconsistent";
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,1434 @@
+#include "mathllm/integration.h"
+#include "mathllm/intern.h"
+#include "mathllm/numeric.h"
+#include "mathllm/polynomial.h"
+#include "mathllm/quadrature.h"
+#include "mathllm/verifier.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/constants.h>
+#include <symengine/functions.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::Symbol;
+
+// Shape of a rule's primary argument (function argument or Pow base) and,
+// for Pow rules, of the exponent. Rules declare the shapes they accept as
+// a bitmask so the dispatcher can reject them without calling into them.
+enum ArgShape : unsigned {
+    SHAPE_CONSTANT = 1u << 0,
+    SHAPE_VARIABLE = 1u << 1,
+    SHAPE_LINEAR = 1u << 2,
+    SHAPE_OTHER = 1u << 3,
+    SHAPE_AFFINE = SHAPE_VARIABLE | SHAPE_LINEAR,
+    SHAPE_ANY = SHAPE_CONSTANT | SHAPE_VARIABLE | SHAPE_LINEAR | SHAPE_OTHER
+};
+
+struct Shape {
+    ArgShape kind;
+    RCP<const Basic> slope;
+};
+
+// slope is d(inner)/d(var) for affine inner arguments u = a*var + b, where
+// inner is the Pow exponent for constant-base powers and arg otherwise.
+// Table rules return F(u) / slope, which is the u-substitution.
+struct RuleMatch {
+    const RCP<const Basic>& expr;
+    const RCP<const Symbol>& var;
+    RCP<const Basic> arg;
+    RCP<const Basic> slope;
+};
+
+using RuleFn = RCP<const Basic> (*)(const RuleMatch& match, IntegrationContext& ctx);
+
+struct IntegrationRule {
+    const char* name;
+    SymEngine::TypeID type;
+    unsigned arg_shapes;
+    unsigned exp_shapes;
+    int priority;
+    RuleFn apply;
+};
+
+Shape classify(const RCP<const Basic>& arg, const RCP<const Symbol>& var) {
+    if (!SymEngine::has_symbol(*arg, *var)) {
+        return {SHAPE_CONSTANT, SymEngine::zero};
+    }
+    if (SymEngine::eq(*arg, *var)) {
+        return {SHAPE_VARIABLE, SymEngine::one};
+    }
+    const auto slope = SymEngine::diff(arg, var);
+    if (!SymEngine::has_symbol(*slope, *var) && !SymEngine::eq(*slope, *SymEngine::zero)) {
+        return {SHAPE_LINEAR, slope};
+    }
+    return {SHAPE_OTHER, RCP<const Basic>()};
+}
+
+RCP<const Basic> primary_arg(const RCP<const Basic>& expr) {
+    if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+        return SymEngine::rcp_static_cast<const SymEngine::Pow>(expr)->get_base();
+    }
+    if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*expr)) {
+        return SymEngine::rcp_static_cast<const SymEngine::OneArgFunction>(expr)->get_arg();
+    }
+    return expr;
+}
+
+const RCP<const Basic>& pow_exp(const RCP<const Basic>& expr) {
+    return SymEngine::rcp_static_cast<const SymEngine::Pow>(expr)->get_exp();
+}
+
+// True if base is a one-argument function of the given type applied to an
+// affine function of var; fills in that argument and its slope.
+bool affine_function_of(const RCP<const Basic>& base, SymEngine::TypeID type,
+                        const RCP<const Symbol>& var, RCP<const Basic>& arg, RCP<const Basic>& slope) {
+    if (base->get_type_code() != type) {
+        return false;
+    }
+    arg = SymEngine::rcp_static_cast<const SymEngine::OneArgFunction>(base)->get_arg();
+    const auto shape = classify(arg, var);
+    if (!(shape.kind & SHAPE_AFFINE)) {
+        return false;
+    }
+    slope = shape.slope;
+    return true;
+}
+
+bool exp_equals(const RCP<const Basic>& expr, long value) {
+    return SymEngine::eq(*pow_exp(expr), *SymEngine::integer(value));
+}
+
+RCP<const Basic> half(const RCP<const Basic>& expr) {
+    return SymEngine::div(expr, SymEngine::integer(2));
+}
+
+RCP<const Basic> chain(const RuleMatch& m, const RCP<const Basic>& antiderivative) {
+    return SymEngine::div(antiderivative, m.slope);
+}
+
+RCP<const Basic> rule_variable(const RuleMatch& m, IntegrationContext&) {
+    return half(SymEngine::pow(m.arg, SymEngine::integer(2)));
+}
+
+RCP<const Basic> rule_sum(const RuleMatch& m, IntegrationContext& ctx) {
+    RCP<const Basic> result = SymEngine::zero;
+    for (const auto& term : m.expr->get_args()) {
+        result = SymEngine::add(result, integrate_expr(term, m.var, ctx));
+    }
+    return result;
+}
+
+RCP<const Basic> rule_constant_multiple(const RuleMatch& m, IntegrationContext& ctx) {
+    RCP<const Basic> constant = SymEngine::one;
+    SymEngine::vec_basic dependent;
+    for (const auto& factor : m.expr->get_args()) {
+        if (SymEngine::has_symbol(*factor, *m.var)) {
+            dependent.push_back(factor);
+        } else {
+            constant = SymEngine::mul(constant, factor);
+        }
+    }
+    if (SymEngine::eq(*constant, *SymEngine::one)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::mul(constant, integrate_expr(SymEngine::mul(dependent), m.var, ctx));
+}
+
+RCP<const Basic> rule_expand(const RuleMatch& m, IntegrationContext& ctx) {
+    const auto expanded = SymEngine::expand(m.expr);
+    if (SymEngine::eq(*expanded, *m.expr)) {
+        return RCP<const Basic>();
+    }
+    return integrate_expr(expanded, m.var, ctx);
+}
+
+RCP<const Basic> rule_power(const RuleMatch& m, IntegrationContext&) {
+    const auto exponent_plus_one = SymEngine::add(pow_exp(m.expr), SymEngine::one);
+    if (SymEngine::eq(*exponent_plus_one, *SymEngine::zero)) {
+        return RCP<const Basic>();
+    }
+    return chain(m, SymEngine::div(SymEngine::pow(m.arg, exponent_plus_one), exponent_plus_one));
+}
+
+RCP<const Basic> rule_reciprocal(const RuleMatch& m, IntegrationContext&) {
+    if (!exp_equals(m.expr, -1)) {
+        return RCP<const Basic>();
+    }
+    return chain(m, SymEngine::log(m.arg));
+}
+
+RCP<const Basic> rule_exp(const RuleMatch& m, IntegrationContext&) {
+    if (!SymEngine::eq(*m.arg, *SymEngine::E)) {
+        return RCP<const Basic>();
+    }
+    return chain(m, m.expr);
+}
+
+RCP<const Basic> rule_exponential(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::div(m.expr, SymEngine::log(m.arg)));
+}
+
+RCP<const Basic> rule_sin(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::neg(SymEngine::cos(m.arg)));
+}
+
+RCP<const Basic> rule_cos(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::sin(m.arg));
+}
+
+RCP<const Basic> rule_tan(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::neg(SymEngine::log(SymEngine::cos(m.arg))));
+}
+
+RCP<const Basic> rule_cot(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::log(SymEngine::sin(m.arg)));
+}
+
+RCP<const Basic> rule_sec(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::log(SymEngine::add(SymEngine::sec(m.arg), SymEngine::tan(m.arg))));
+}
+
+RCP<const Basic> rule_csc(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::neg(SymEngine::log(SymEngine::add(SymEngine::csc(m.arg), SymEngine::cot(m.arg)))));
+}
+
+RCP<const Basic> rule_sinh(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::cosh(m.arg));
+}
+
+RCP<const Basic> rule_cosh(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::sinh(m.arg));
+}
+
+RCP<const Basic> rule_tanh(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::log(SymEngine::cosh(m.arg)));
+}
+
+RCP<const Basic> rule_log(const RuleMatch& m, IntegrationContext&) {
+    return chain(m, SymEngine::sub(SymEngine::mul(m.arg, SymEngine::log(m.arg)), m.arg));
+}
+
+RCP<const Basic> rule_asin(const RuleMatch& m, IntegrationContext&) {
+    const auto root = SymEngine::sqrt(SymEngine::sub(SymEngine::one, SymEngine::pow(m.arg, SymEngine::integer(2))));
+    return chain(m, SymEngine::add(SymEngine::mul(m.arg, SymEngine::asin(m.arg)), root));
+}
+
+RCP<const Basic> rule_acos(const RuleMatch& m, IntegrationContext&) {
+    const auto root = SymEngine::sqrt(SymEngine::sub(SymEngine::one, SymEngine::pow(m.arg, SymEngine::integer(2))));
+    return chain(m, SymEngine::sub(SymEngine::mul(m.arg, SymEngine::acos(m.arg)), root));
+}
+
+RCP<const Basic> rule_atan(const RuleMatch& m, IntegrationContext&) {
+    const auto log_term = half(SymEngine::log(SymEngine::add(SymEngine::one, SymEngine::pow(m.arg, SymEngine::integer(2)))));
+    return chain(m, SymEngine::sub(SymEngine::mul(m.arg, SymEngine::atan(m.arg)), log_term));
+}
+
+RCP<const Basic> rule_sin_squared(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_function_of(m.arg, SymEngine::SYMENGINE_SIN, m.var, u, slope) || !exp_equals(m.expr, 2)) {
+        return RCP<const Basic>();
+    }
+    const auto double_angle = SymEngine::sin(SymEngine::mul(SymEngine::integer(2), u));
+    return SymEngine::div(SymEngine::sub(half(u), SymEngine::div(double_angle, SymEngine::integer(4))), slope);
+}
+
+RCP<const Basic> rule_cos_squared(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_function_of(m.arg, SymEngine::SYMENGINE_COS, m.var, u, slope) || !exp_equals(m.expr, 2)) {
+        return RCP<const Basic>();
+    }
+    const auto double_angle = SymEngine::sin(SymEngine::mul(SymEngine::integer(2), u));
+    return SymEngine::div(SymEngine::add(half(u), SymEngine::div(double_angle, SymEngine::integer(4))), slope);
+}
+
+RCP<const Basic> rule_sec_squared(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_function_of(m.arg, SymEngine::SYMENGINE_SEC, m.var, u, slope) || !exp_equals(m.expr, 2)) {
+        if (!affine_function_of(m.arg, SymEngine::SYMENGINE_COS, m.var, u, slope) || !exp_equals(m.expr, -2)) {
+            return RCP<const Basic>();
+        }
+    }
+    return SymEngine::div(SymEngine::tan(u), slope);
+}
+
+RCP<const Basic> rule_csc_squared(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_function_of(m.arg, SymEngine::SYMENGINE_CSC, m.var, u, slope) || !exp_equals(m.expr, 2)) {
+        if (!affine_function_of(m.arg, SymEngine::SYMENGINE_SIN, m.var, u, slope) || !exp_equals(m.expr, -2)) {
+            return RCP<const Basic>();
+        }
+    }
+    return SymEngine::div(SymEngine::neg(SymEngine::cot(u)), slope);
+}
+
+RCP<const Basic> rule_tan_squared(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_function_of(m.arg, SymEngine::SYMENGINE_TAN, m.var, u, slope) || !exp_equals(m.expr, 2)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::div(SymEngine::sub(SymEngine::tan(u), u), slope);
+}
+
+// True if expr is u^2 for an affine u = a*var + b, read off its
+// derivatives as u = expr' / (2a) with a = sqrt(expr'' / 2); fills in u
+// and its slope a.
+bool affine_square(const RCP<const Basic>& expr, const RCP<const Symbol>& var,
+                   RCP<const Basic>& u, RCP<const Basic>& slope) {
+    const auto first = SymEngine::diff(expr, var);
+    const auto second = SymEngine::expand(SymEngine::diff(first, var));
+    if (SymEngine::has_symbol(*second, *var) || SymEngine::eq(*second, *SymEngine::zero)
+        || (SymEngine::is_a_Number(*second) && SymEngine::rcp_static_cast<const SymEngine::Number>(second)->is_negative())) {
+        return false;
+    }
+    slope = SymEngine::sqrt(half(second));
+    u = SymEngine::expand(SymEngine::div(first, SymEngine::mul(SymEngine::integer(2), slope)));
+    const auto residual = SymEngine::expand(SymEngine::sub(SymEngine::pow(u, SymEngine::integer(2)), expr));
+    return SymEngine::eq(*residual, *SymEngine::zero);
+}
+
+// True if expr is a product of a function of the given type and partner,
+// both at the same affine argument; fills in that argument and its slope.
+bool affine_product_of(const RuleMatch& m, SymEngine::TypeID type,
+                       RCP<const Basic> (*partner)(const RCP<const Basic>&),
+                       RCP<const Basic>& u, RCP<const Basic>& slope) {
+    for (const auto& factor : m.expr->get_args()) {
+        if (affine_function_of(factor, type, m.var, u, slope)) {
+            return SymEngine::eq(*m.expr, *SymEngine::mul(factor, partner(u)));
+        }
+    }
+    return false;
+}
+
+// 1/(1 + u^2) with u affine.
+RCP<const Basic> rule_arctan_form(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!exp_equals(m.expr, -1) || !affine_square(SymEngine::sub(m.arg, SymEngine::one), m.var, u, slope)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::div(SymEngine::atan(u), slope);
+}
+
+// 1/sqrt(1 - u^2) and 1/sqrt(1 + u^2) with u affine.
+RCP<const Basic> rule_arcsin_form(const RuleMatch& m, IntegrationContext&) {
+    if (!SymEngine::eq(*pow_exp(m.expr), *SymEngine::Rational::from_two_ints(-1, 2))) {
+        return RCP<const Basic>();
+    }
+    RCP<const Basic> u, slope;
+    if (affine_square(SymEngine::sub(SymEngine::one, m.arg), m.var, u, slope)) {
+        return SymEngine::div(SymEngine::asin(u), slope);
+    }
+    if (affine_square(SymEngine::sub(m.arg, SymEngine::one), m.var, u, slope)) {
+        return SymEngine::div(SymEngine::asinh(u), slope);
+    }
+    return RCP<const Basic>();
+}
+
+RCP<const Basic> rule_sec_tan(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_product_of(m, SymEngine::SYMENGINE_SEC, SymEngine::tan, u, slope)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::div(SymEngine::sec(u), slope);
+}
+
+RCP<const Basic> rule_csc_cot(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_product_of(m, SymEngine::SYMENGINE_CSC, SymEngine::cot, u, slope)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::div(SymEngine::neg(SymEngine::csc(u)), slope);
+}
+
+RCP<const Basic> rule_sin_cos(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> u, slope;
+    if (!affine_product_of(m, SymEngine::SYMENGINE_SIN, SymEngine::cos, u, slope)) {
+        return RCP<const Basic>();
+    }
+    return SymEngine::div(half(SymEngine::pow(SymEngine::sin(u), SymEngine::integer(2))), slope);
+}
+
+// Substitution candidates for a product: each dependent factor itself and
+// its inner argument (function argument, Pow base, or exponent of a
+// constant-base power).
+SymEngine::vec_basic substitution_candidates(const RCP<const Basic>& expr, const RCP<const Symbol>& var) {
+    SymEngine::vec_basic candidates;
+    for (const auto& factor : expr->get_args()) {
+        if (!SymEngine::has_symbol(*factor, *var)) {
+            continue;
+        }
+        candidates.push_back(factor);
+        if (SymEngine::is_a<SymEngine::Pow>(*factor)) {
+            const auto& base = SymEngine::rcp_static_cast<const SymEngine::Pow>(factor)->get_base();
+            candidates.push_back(SymEngine::has_symbol(*base, *var) ? base : pow_exp(factor));
+        } else if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*factor)) {
+            candidates.push_back(primary_arg(factor));
+        }
+    }
+    return candidates;
+}
+
+// Derivative-divides: find g(x) such that expr / g'(x) is f(g(x)) with no
+// other occurrence of x, then integrate f(u) du and substitute back.
+RCP<const Basic> rule_derivative_divides(const RuleMatch& m, IntegrationContext& ctx) {
+    // A dummy cannot collide with a symbol of the integrand.
+    const RCP<const Symbol> u = SymEngine::dummy("u");
+    for (const auto& g : substitution_candidates(m.expr, m.var)) {
+        // Affine substitutions are already handled by the table rules.
+        if (classify(g, m.var).kind != SHAPE_OTHER) {
+            continue;
+        }
+        const auto quotient = SymEngine::div(m.expr, SymEngine::diff(g, m.var));
+        const auto integrand = quotient->subs({{g, u}});
+        if (SymEngine::has_symbol(*integrand, *m.var)) {
+            continue;
+        }
+        const auto mark = ctx.rules_fired.size();
+        try {
+            return integrate_expr(integrand, u, ctx)->subs({{u, g}});
+        } catch (const SymbolicError&) {
+            if (ctx.steps_used > ctx.step_budget) {
+                throw;
+            }
+            ctx.rules_fired.resize(mark);
+        }
+    }
+    return RCP<const Basic>();
+}
+
+// Splits expr into numerator and denominator, moving negative integer
+// powers below the line.
+void split_fraction(const RCP<const Basic>& expr, RCP<const Basic>& numer, RCP<const Basic>& denom) {
+    SymEngine::vec_basic factors;
+    if (SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        factors = expr->get_args();
+    } else {
+        factors.push_back(expr);
+    }
+    SymEngine::vec_basic top, bottom;
+    for (const auto& factor : factors) {
+        if (SymEngine::is_a<SymEngine::Pow>(*factor)) {
+            const auto& exponent = pow_exp(factor);
+            if (SymEngine::is_a<SymEngine::Integer>(*exponent)
+                && SymEngine::rcp_static_cast<const SymEngine::Integer>(exponent)->is_negative()) {
+                bottom.push_back(SymEngine::pow(primary_arg(factor), SymEngine::neg(exponent)));
+                continue;
+            }
+        }
+        top.push_back(factor);
+    }
+    numer = SymEngine::mul(top);
+    denom = SymEngine::mul(bottom);
+}
+
+struct PartialFactor {
+    DensePoly poly;
+    int multiplicity;
+};
+
+struct PartialTerm {
+    DensePoly factor;
+    int power;
+    DensePoly numerator;
+};
+
+// Largest part from which quadratic factors are split, and the largest
+// denominator of their coefficients.
+const int kMaxQuadraticSplit = 8;
+const long kMaxFactorDenominator = 1L << 20;
+
+// The continued-fraction convergent of value within a relative 1e-9, if
+// one has denominator at most kMaxFactorDenominator.
+bool nearby_rational(double value, DensePoly::Coeff& out) {
+    if (!std::isfinite(value) || std::abs(value) > 1e12) {
+        return false;
+    }
+    long p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    double x = value;
+    for (int i = 0; i < 64; ++i) {
+        const double a = std::floor(x);
+        const long p2 = static_cast<long>(a) * p1 + p0;
+        const long q2 = static_cast<long>(a) * q1 + q0;
+        if (q2 > kMaxFactorDenominator) {
+            return false;
+        }
+        if (std::abs(static_cast<double>(p2) / static_cast<double>(q2) - value) <= 1e-9 * std::max(1.0, std::abs(value))) {
+            out = SymEngine::Rational::from_two_ints(p2, q2);
+            return true;
+        }
+        if (x == a) {
+            return false;
+        }
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+        x = 1.0 / (x - a);
+    }
+    return false;
+}
+
+// Divides a monic quadratic with rational coefficients out of rest. The
+// candidates pair up the numeric roots of rest; the division is exact.
+bool split_quadratic(DensePoly& rest, DensePoly& quadratic) {
+    std::vector<std::complex<double>> roots;
+    try {
+        roots = numeric_roots(rest);
+    } catch (const NumericError&) {
+        return false;
+    }
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        for (std::size_t j = i + 1; j < roots.size(); ++j) {
+            const auto sum = roots[i] + roots[j];
+            const auto product = roots[i] * roots[j];
+            if (std::abs(sum.imag()) > 1e-6 * (1.0 + std::abs(sum))
+                || std::abs(product.imag()) > 1e-6 * (1.0 + std::abs(product))) {
+                continue;
+            }
+            DensePoly::Coeff c1, c0;
+            if (!nearby_rational(-sum.real(), c1) || !nearby_rational(product.real(), c0)) {
+                continue;
+            }
+            const DensePoly candidate({c0, c1, SymEngine::one});
+            DensePoly quotient, remainder;
+            DensePoly::divmod(rest, candidate, quotient, remainder);
+            if (remainder.is_zero()) {
+                rest = quotient;
+                quadratic = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Factors each square-free part into monic linear factors (rational roots)
+// and monic quadratics with rational coefficients, such as the two of
+// (x^2 + 1)*(x^2 + 2). Returns false if an irreducible factor of degree
+// three or more is left over.
+bool factor_low_degree(const std::vector<DensePoly>& square_free, std::vector<PartialFactor>& factors) {
+    for (std::size_t i = 0; i < square_free.size(); ++i) {
+        DensePoly rest = square_free[i];
+        if (rest.degree() < 1) {
+            continue;
+        }
+        const int multiplicity = static_cast<int>(i) + 1;
+        for (const auto& root : rest.rational_roots()) {
+            DensePoly linear({SymEngine::mulnum(SymEngine::minus_one, root), SymEngine::one});
+            DensePoly quotient, remainder;
+            DensePoly::divmod(rest, linear, quotient, remainder);
+            rest = quotient;
+            factors.push_back({linear, multiplicity});
+        }
+        while (rest.degree() > 2 && rest.degree() <= kMaxQuadraticSplit) {
+            DensePoly quadratic;
+            if (!split_quadratic(rest, quadratic)) {
+                return false;
+            }
+            factors.push_back({quadratic, multiplicity});
+        }
+        if (rest.degree() == 2) {
+            factors.push_back({rest.monic(), multiplicity});
+        } else if (rest.degree() > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DensePoly power_of(const DensePoly& base, int exponent) {
+    DensePoly result = DensePoly::constant(SymEngine::one);
+    for (int i = 0; i < exponent; ++i) {
+        result = result * base;
+    }
+    return result;
+}
+
+// Solves numer/denom = sum_j sum_k A_jk / p_j^k for the unknown
+// coefficients of every A_jk by exact Gaussian elimination.
+std::vector<PartialTerm> partial_fractions(const DensePoly& numer, const DensePoly& denom,
+                                           const std::vector<PartialFactor>& factors) {
+    struct Column {
+        std::size_t term;
+        int shift;
+        DensePoly poly;
+    };
+    std::vector<PartialTerm> terms;
+    std::vector<Column> columns;
+    for (const auto& factor : factors) {
+        for (int k = 1; k <= factor.multiplicity; ++k) {
+            DensePoly cofactor, remainder;
+            DensePoly::divmod(denom, power_of(factor.poly, k), cofactor, remainder);
+            for (int shift = 0; shift < factor.poly.degree(); ++shift) {
+                columns.push_back({terms.size(), shift, cofactor * DensePoly::monomial(SymEngine::one, shift)});
+            }
+            terms.push_back({factor.poly, k, DensePoly()});
+        }
+    }
+
+    const std::size_t n = columns.size();
+    std::vector<std::vector<DensePoly::Coeff>> rows(n, std::vector<DensePoly::Coeff>(n + 1));
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c < n; ++c) {
+            rows[r][c] = columns[c].poly.coeff(static_cast<int>(r));
+        }
+        rows[r][n] = numer.coeff(static_cast<int>(r));
+    }
+    for (std::size_t c = 0; c < n; ++c) {
+        std::size_t pivot = c;
+        while (pivot < n && rows[pivot][c]->is_zero()) {
+            ++pivot;
+        }
+        if (pivot == n) {
+            throw SymbolicError("Singular partial fraction system");
+        }
+        std::swap(rows[c], rows[pivot]);
+        const auto inv = SymEngine::divnum(SymEngine::one, rows[c][c]);
+        for (auto& entry : rows[c]) {
+            entry = SymEngine::mulnum(entry, inv);
+        }
+        for (std::size_t r = 0; r < n; ++r) {
+            if (r == c || rows[r][c]->is_zero()) {
+                continue;
+            }
+            const auto factor = rows[r][c];
+            for (std::size_t k = c; k <= n; ++k) {
+                rows[r][k] = SymEngine::subnum(rows[r][k], SymEngine::mulnum(factor, rows[c][k]));
+            }
+        }
+    }
+    for (std::size_t c = 0; c < n; ++c) {
+        auto& term = terms[columns[c].term];
+        term.numerator = term.numerator + DensePoly::monomial(rows[c][n], columns[c].shift);
+    }
+    return terms;
+}
+
+// Integral of 1 / (t^2 + a2)^k dt by the standard reduction formula.
+RCP<const Basic> quadratic_power_integral(const RCP<const Basic>& t, const DensePoly::Coeff& a2, int k) {
+    if (k == 1) {
+        if (a2->is_positive()) {
+            const auto a = SymEngine::sqrt(a2);
+            return SymEngine::div(SymEngine::atan(SymEngine::div(t, a)), a);
+        }
+        const auto b = SymEngine::sqrt(SymEngine::neg(a2));
+        const auto ratio = SymEngine::div(SymEngine::sub(t, b), SymEngine::add(t, b));
+        return SymEngine::div(SymEngine::log(ratio), SymEngine::mul(SymEngine::integer(2), b));
+    }
+    const auto scale = SymEngine::mul(SymEngine::mul(SymEngine::integer(2), a2), SymEngine::integer(k - 1));
+    const auto base = SymEngine::add(SymEngine::pow(t, SymEngine::integer(2)), a2);
+    const auto first = SymEngine::div(t, SymEngine::mul(scale, SymEngine::pow(base, SymEngine::integer(k - 1))));
+    const auto second = SymEngine::mul(SymEngine::div(SymEngine::integer(2 * k - 3), scale),
+                                       quadratic_power_integral(t, a2, k - 1));
+    return SymEngine::add(first, second);
+}
+
+RCP<const Basic> integrate_partial_term(const PartialTerm& term, const RCP<const Symbol>& var,
+                                        IntegrationContext& ctx) {
+    const auto factor = term.factor.to_basic(var);
+    if (term.factor.degree() == 1) {
+        const auto summand = SymEngine::mul(term.numerator.to_basic(var),
+                                            SymEngine::pow(factor, SymEngine::integer(-term.power)));
+        return integrate_expr(summand, var, ctx);
+    }
+    // (c1 x + c0) / (x^2 + p x + q)^k with t = x + p/2 and a2 = q - p^2/4.
+    const auto two = SymEngine::integer(2);
+    const auto c0 = term.numerator.coeff(0);
+    const auto c1 = term.numerator.coeff(1);
+    const auto half_p = SymEngine::divnum(term.factor.coeff(1), two);
+    const auto a2 = SymEngine::subnum(term.factor.coeff(0), SymEngine::mulnum(half_p, half_p));
+    const auto t = SymEngine::add(var, half_p);
+    RCP<const Basic> log_part = term.power == 1
+        ? SymEngine::log(factor)
+        : SymEngine::div(SymEngine::pow(factor, SymEngine::integer(1 - term.power)), SymEngine::integer(1 - term.power));
+    const auto rest = SymEngine::subnum(c0, SymEngine::mulnum(c1, half_p));
+    return SymEngine::add(SymEngine::mul(SymEngine::divnum(c1, two), log_part),
+                          SymEngine::mul(rest, quadratic_power_integral(t, a2, term.power)));
+}
+
+// Hermite reduction (Bronstein, Symbolic Integration I, 2.2). Returns the
+// rational part of the integral of a/d and leaves a/d with d square-free.
+RCP<const Basic> hermite_reduce(DensePoly& a, DensePoly& d, const std::vector<DensePoly>& square_free,
+                                const RCP<const Symbol>& var) {
+    RCP<const Basic> rational_part = SymEngine::zero;
+    for (std::size_t i = 1; i < square_free.size(); ++i) {
+        const auto& v = square_free[i];
+        if (v.degree() < 1) {
+            continue;
+        }
+        const int multiplicity = static_cast<int>(i) + 1;
+        DensePoly u, unused;
+        DensePoly::divmod(d, power_of(v, multiplicity), u, unused);
+        const DensePoly uv_prime = u * v.derivative();
+        DensePoly s, t;
+        DensePoly::extended_gcd(uv_prime, v, s, t);
+        for (int j = multiplicity - 1; j >= 1; --j) {
+            // Solve b*u*v' + c*v = -a/j with deg b < deg v.
+            const auto rhs = a.scale(SymEngine::Rational::from_two_ints(-1, j));
+            DensePoly q, b, c;
+            DensePoly::divmod(s * rhs, v, q, b);
+            DensePoly::divmod(rhs - b * uv_prime, v, c, unused);
+            rational_part = SymEngine::add(rational_part,
+                SymEngine::div(b.to_basic(var), SymEngine::pow(v.to_basic(var), SymEngine::integer(j))));
+            a = c.scale(SymEngine::integer(-j)) - u * b.derivative();
+        }
+        d = u * v;
+    }
+    return rational_part;
+}
+
+// Rational functions P/Q with exact rational coefficients: polynomial
+// division, square-free factorisation, partial fractions over linear and
+// quadratic factors, with Hermite reduction when Q has an irreducible
+// repeated factor of higher degree.
+RCP<const Basic> rule_rational(const RuleMatch& m, IntegrationContext& ctx) {
+    RCP<const Basic> numer_expr, denom_expr;
+    split_fraction(m.expr, numer_expr, denom_expr);
+    DensePoly numer, denom;
+    if (!DensePoly::from_basic(denom_expr, m.var, denom) || denom.degree() < 1
+        || !DensePoly::from_basic(numer_expr, m.var, numer)) {
+        return RCP<const Basic>();
+    }
+    DensePoly quotient, remainder;
+    DensePoly::divmod(numer, denom, quotient, remainder);
+    RCP<const Basic> result = quotient.antiderivative().to_basic(m.var);
+    if (remainder.is_zero()) {
+        return result;
+    }
+    const auto square_free = denom.square_free();
+    std::vector<PartialFactor> factors;
+    const auto mark = ctx.rules_fired.size();
+    bool hermite = false;
+    if (!factor_low_degree(square_free, factors)) {
+        hermite = true;
+        result = SymEngine::add(result, hermite_reduce(remainder, denom, square_free, m.var));
+        factors.clear();
+        if (!remainder.is_zero() && !factor_low_degree({denom.monic()}, factors)) {
+            return RCP<const Basic>();
+        }
+    }
+    if (!remainder.is_zero()) {
+        for (const auto& term : partial_fractions(remainder, denom, factors)) {
+            if (!term.numerator.is_zero()) {
+                result = SymEngine::add(result, integrate_partial_term(term, m.var, ctx));
+            }
+        }
+    }
+    // Traced only once the rule has an answer, ahead of the sub-integrals
+    // it led to.
+    if (hermite) {
+        ctx.rules_fired.insert(ctx.rules_fired.begin() + mark, "hermite_reduction");
+    }
+    return result;
+}
+
+const int kMaxTabularDegree = 16;
+const std::size_t kMaxPartsGrowth = 4;
+
+std::size_t node_count(const RCP<const Basic>& expr) {
+    std::size_t count = 1;
+    for (const auto& arg : expr->get_args()) {
+        count += node_count(arg);
+    }
+    return count;
+}
+
+bool affine_arg(const RCP<const Basic>& expr, const RCP<const Symbol>& var) {
+    return (classify(expr, var).kind & SHAPE_AFFINE) != 0;
+}
+
+// exp(u), b^u, sin(u), cos(u), sinh(u), cosh(u) with u affine: factors whose
+// repeated antiderivatives stay the same size.
+bool is_tabular_factor(const RCP<const Basic>& factor, const RCP<const Symbol>& var) {
+    switch (factor->get_type_code()) {
+        case SymEngine::SYMENGINE_POW:
+            return !SymEngine::has_symbol(*primary_arg(factor), *var) && affine_arg(pow_exp(factor), var);
+        case SymEngine::SYMENGINE_SIN:
+        case SymEngine::SYMENGINE_COS:
+        case SymEngine::SYMENGINE_SINH:
+        case SymEngine::SYMENGINE_COSH:
+            return affine_arg(primary_arg(factor), var);
+        default:
+            return false;
+    }
+}
+
+// log(u)^n, atan(u), asin(u), acos(u) with u affine: factors that get
+// simpler under differentiation.
+bool is_log_type_factor(const RCP<const Basic>& factor, const RCP<const Symbol>& var) {
+    if (SymEngine::is_a<SymEngine::Pow>(*factor)) {
+        const auto& exponent = pow_exp(factor);
+        return SymEngine::is_a<SymEngine::Integer>(*exponent)
+            && SymEngine::rcp_static_cast<const SymEngine::Integer>(exponent)->is_positive()
+            && SymEngine::is_a<SymEngine::Log>(*primary_arg(factor))
+            && affine_arg(primary_arg(primary_arg(factor)), var);
+    }
+    switch (factor->get_type_code()) {
+        case SymEngine::SYMENGINE_LOG:
+        case SymEngine::SYMENGINE_ATAN:
+        case SymEngine::SYMENGINE_ASIN:
+        case SymEngine::SYMENGINE_ACOS:
+            return affine_arg(primary_arg(factor), var);
+        default:
+            return false;
+    }
+}
+
+// Splits a product into a polynomial part and a single other factor.
+bool split_parts(const RCP<const Basic>& expr, const RCP<const Symbol>& var,
+                 DensePoly& poly, RCP<const Basic>& other) {
+    SymEngine::vec_basic factors;
+    if (SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        factors = expr->get_args();
+    } else {
+        factors.push_back(expr);
+    }
+    SymEngine::vec_basic poly_factors;
+    for (const auto& factor : factors) {
+        DensePoly unused;
+        if (DensePoly::from_basic(factor, var, unused)) {
+            poly_factors.push_back(factor);
+        } else if (other.is_null()) {
+            other = factor;
+        } else {
+            return false;
+        }
+    }
+    return !other.is_null() && DensePoly::from_basic(SymEngine::mul(poly_factors), var, poly);
+}
+
+struct PartsDepthGuard {
+    explicit PartsDepthGuard(IntegrationContext& ctx) : ctx_(ctx) { ++ctx_.parts_depth; }
+    ~PartsDepthGuard() { --ctx_.parts_depth; }
+    IntegrationContext& ctx_;
+};
+
+// Tabular integration by parts for P(x) * T(x): sum_k (-1)^k P^(k) T_(k+1)
+// where T_(k+1) is the (k+1)-fold antiderivative of T.
+RCP<const Basic> rule_parts_tabular(const RuleMatch& m, IntegrationContext& ctx) {
+    DensePoly poly;
+    RCP<const Basic> factor;
+    if (!split_parts(m.expr, m.var, poly, factor) || !is_tabular_factor(factor, m.var)
+        || poly.degree() > kMaxTabularDegree) {
+        return RCP<const Basic>();
+    }
+    const std::size_t growth_limit = kMaxPartsGrowth * node_count(factor);
+    RCP<const Basic> result = SymEngine::zero;
+    RCP<const Basic> integral = factor;
+    bool negate = false;
+    for (DensePoly derivative = poly; !derivative.is_zero(); derivative = derivative.derivative()) {
+        integral = integrate_expr(integral, m.var, ctx);
+        if (node_count(integral) > growth_limit) {
+            return RCP<const Basic>();
+        }
+        const auto term = SymEngine::mul(derivative.to_basic(m.var), integral);
+        result = negate ? SymEngine::sub(result, term) : SymEngine::add(result, term);
+        negate = !negate;
+    }
+    return result;
+}
+
+// P(x) * L(x) with L log-type: Q L - integral(Q L') where Q' = P.
+RCP<const Basic> rule_parts_log(const RuleMatch& m, IntegrationContext& ctx) {
+    DensePoly poly;
+    RCP<const Basic> factor;
+    if (ctx.parts_depth >= ctx.max_parts_depth || !split_parts(m.expr, m.var, poly, factor)
+        || !is_log_type_factor(factor, m.var)) {
+        return RCP<const Basic>();
+    }
+    PartsDepthGuard guard(ctx);
+    const auto q = poly.antiderivative().to_basic(m.var);
+    const auto rest = integrate_expr(SymEngine::mul(q, SymEngine::diff(factor, m.var)), m.var, ctx);
+    return SymEngine::sub(SymEngine::mul(q, factor), rest);
+}
+
+// exp(u) * sin(v) and exp(u) * cos(v) with u = a x + b, v = c x + d. Two
+// rounds of parts return the original integral, giving the closed forms
+//   e^u (a sin v - c cos v) / (a^2 + c^2) and e^u (a cos v + c sin v) / (a^2 + c^2).
+RCP<const Basic> rule_parts_cyclic(const RuleMatch& m, IntegrationContext&) {
+    RCP<const Basic> exp_factor, trig_factor;
+    for (const auto& factor : m.expr->get_args()) {
+        if (SymEngine::is_a<SymEngine::Pow>(*factor) && SymEngine::eq(*primary_arg(factor), *SymEngine::E)
+            && exp_factor.is_null()) {
+            exp_factor = factor;
+        } else if ((SymEngine::is_a<SymEngine::Sin>(*factor) || SymEngine::is_a<SymEngine::Cos>(*factor))
+                   && trig_factor.is_null()) {
+            trig_factor = factor;
+        } else {
+            return RCP<const Basic>();
+        }
+    }
+    if (exp_factor.is_null() || trig_factor.is_null()) {
+        return RCP<const Basic>();
+    }
+    const auto u_shape = classify(pow_exp(exp_factor), m.var);
+    const auto v = primary_arg(trig_factor);
+    const auto v_shape = classify(v, m.var);
+    if (!(u_shape.kind & SHAPE_AFFINE) || !(v_shape.kind & SHAPE_AFFINE)) {
+        return RCP<const Basic>();
+    }
+    const auto& a = u_shape.slope;
+    const auto& c = v_shape.slope;
+    const auto norm = SymEngine::add(SymEngine::pow(a, SymEngine::integer(2)), SymEngine::pow(c, SymEngine::integer(2)));
+    const auto a_sin = SymEngine::mul(a, SymEngine::sin(v));
+    const auto a_cos = SymEngine::mul(a, SymEngine::cos(v));
+    const auto c_sin = SymEngine::mul(c, SymEngine::sin(v));
+    const auto c_cos = SymEngine::mul(c, SymEngine::cos(v));
+    const auto combination = SymEngine::is_a<SymEngine::Sin>(*trig_factor)
+        ? SymEngine::sub(a_sin, c_cos)
+        : SymEngine::add(a_cos, c_sin);
+    return SymEngine::div(SymEngine::mul(exp_factor, combination), norm);
+}
+
+// Initial calculus-table rule set. Within a TypeID bucket rules are tried
+// from highest to lowest priority; the first one that produces a result wins.
+const IntegrationRule kRules[] = {
+    {"variable", SymEngine::SYMENGINE_SYMBOL, SHAPE_VARIABLE, SHAPE_ANY, 100, rule_variable},
+    {"sum", SymEngine::SYMENGINE_ADD, SHAPE_ANY, SHAPE_ANY, 100, rule_sum},
+    {"constant_multiple", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 100, rule_constant_multiple},
+    {"sec_tan", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 50, rule_sec_tan},
+    {"csc_cot", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 50, rule_csc_cot},
+    {"sin_cos", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 50, rule_sin_cos},
+    {"rational", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 30, rule_rational},
+    {"derivative_divides", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 20, rule_derivative_divides},
+    {"parts_cyclic", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 15, rule_parts_cyclic},
+    {"parts_tabular", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 10, rule_parts_tabular},
+    {"parts_log", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 10, rule_parts_log},
+    {"expand", SymEngine::SYMENGINE_MUL, SHAPE_ANY, SHAPE_ANY, 0, rule_expand},
+    {"reciprocal", SymEngine::SYMENGINE_POW, SHAPE_AFFINE, SHAPE_CONSTANT, 110, rule_reciprocal},
+    {"power", SymEngine::SYMENGINE_POW, SHAPE_AFFINE, SHAPE_CONSTANT, 100, rule_power},
+    {"exp", SymEngine::SYMENGINE_POW, SHAPE_CONSTANT, SHAPE_AFFINE, 100, rule_exp},
+    {"exponential", SymEngine::SYMENGINE_POW, SHAPE_CONSTANT, SHAPE_AFFINE, 90, rule_exponential},
+    {"sin_squared", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 80, rule_sin_squared},
+    {"cos_squared", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 80, rule_cos_squared},
+    {"sec_squared", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 80, rule_sec_squared},
+    {"csc_squared", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 80, rule_csc_squared},
+    {"tan_squared", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 80, rule_tan_squared},
+    {"arctan_form", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 70, rule_arctan_form},
+    {"arcsin_form", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 70, rule_arcsin_form},
+    {"rational", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 60, rule_rational},
+    {"parts_log", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 10, rule_parts_log},
+    {"expand", SymEngine::SYMENGINE_POW, SHAPE_OTHER, SHAPE_CONSTANT, 0, rule_expand},
+    {"sin", SymEngine::SYMENGINE_SIN, SHAPE_AFFINE, SHAPE_ANY, 100, rule_sin},
+    {"cos", SymEngine::SYMENGINE_COS, SHAPE_AFFINE, SHAPE_ANY, 100, rule_cos},
+    {"tan", SymEngine::SYMENGINE_TAN, SHAPE_AFFINE, SHAPE_ANY, 100, rule_tan},
+    {"cot", SymEngine::SYMENGINE_COT, SHAPE_AFFINE, SHAPE_ANY, 100, rule_cot},
+    {"sec", SymEngine::SYMENGINE_SEC, SHAPE_AFFINE, SHAPE_ANY, 100, rule_sec},
+    {"csc", SymEngine::SYMENGINE_CSC, SHAPE_AFFINE, SHAPE_ANY, 100, rule_csc},
+    {"sinh", SymEngine::SYMENGINE_SINH, SHAPE_AFFINE, SHAPE_ANY, 100, rule_sinh},
+    {"cosh", SymEngine::SYMENGINE_COSH, SHAPE_AFFINE, SHAPE_ANY, 100, rule_cosh},
+    {"tanh", SymEngine::SYMENGINE_TANH, SHAPE_AFFINE, SHAPE_ANY, 100, rule_tanh},
+    {"log", SymEngine::SYMENGINE_LOG, SHAPE_AFFINE, SHAPE_ANY, 100, rule_log},
+    {"asin", SymEngine::SYMENGINE_ASIN, SHAPE_AFFINE, SHAPE_ANY, 100, rule_asin},
+    {"acos", SymEngine::SYMENGINE_ACOS, SHAPE_AFFINE, SHAPE_ANY, 100, rule_acos},
+    {"atan", SymEngine::SYMENGINE_ATAN, SHAPE_AFFINE, SHAPE_ANY, 100, rule_atan},
+};
+
+class RuleIndex {
+public:
+    RuleIndex() {
+        for (const auto& rule : kRules) {
+            buckets_[rule.type].push_back(&rule);
+        }
+        for (auto& bucket : buckets_) {
+            std::stable_sort(bucket.begin(), bucket.end(),
+                [](const IntegrationRule* a, const IntegrationRule* b) {
+                    return a->priority > b->priority;
+                });
+        }
+    }
+
+    const std::vector<const IntegrationRule*>& candidates(SymEngine::TypeID type) const {
+        return buckets_[type];
+    }
+
+private:
+    std::array<std::vector<const IntegrationRule*>, SymEngine::TypeID_Count> buckets_;
+};
+
+const RuleIndex& rule_index() {
+    static const RuleIndex index;
+    return index;
+}
+
+const std::size_t kDefaultMemoCapacity = 4096;
+
+// LRU table of antiderivatives. Lookups reorder the list, so every access
+// takes the lock.
+class AntiderivativeMemo {
+public:
+    bool lookup(const RCP<const Basic>& expr, const std::string& var, RCP<const Basic>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ == 0) {
+            return false;
+        }
+        auto it = index_.find(Key{expr, var});
+        if (it == index_.end()) {
+            ++misses_;
+            return false;
+        }
+        ++hits_;
+        order_.splice(order_.begin(), order_, it->second);
+        out = it->second->second;
+        return true;
+    }
+
+    // Keys and results are interned, so entries share their common
+    // subterms and an interned query matches its key by pointer.
+    void store(const RCP<const Basic>& expr, const std::string& var, const RCP<const Basic>& result) {
+        const auto key = intern(expr);
+        const auto value = intern(result);
+        std::lock_guard<std::mutex> lock(mutex_);
+        insert(Key{key, var}, value);
+    }
+
+    IntegrationMemoStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::size_t lookups = hits_ + misses_;
+        const double rate = lookups == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(lookups);
+        return IntegrationMemoStats{hits_, misses_, order_.size(), capacity_, rate};
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        order_.clear();
+        index_.clear();
+        hits_ = misses_ = 0;
+    }
+
+    void set_capacity(std::size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        evict();
+    }
+
+    // Entries from least to most recently used, so reloading them in order
+    // restores the recency ranking.
+    std::vector<std::pair<std::string, std::pair<RCP<const Basic>, RCP<const Basic>>>> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::pair<std::string, std::pair<RCP<const Basic>, RCP<const Basic>>>> entries;
+        for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+            entries.push_back({it->first.var, {it->first.expr, it->second}});
+        }
+        return entries;
+    }
+
+private:
+    struct Key {
+        RCP<const Basic> expr;
+        std::string var;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            std::size_t seed = static_cast<std::size_t>(key.expr->hash());
+            seed ^= std::hash<std::string>()(key.var) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    struct KeyEq {
+        bool operator()(const Key& lhs, const Key& rhs) const {
+            return lhs.var == rhs.var && SymEngine::eq(*lhs.expr, *rhs.expr);
+        }
+    };
+
+    using Entry = std::pair<Key, RCP<const Basic>>;
+
+    void insert(const Key& key, const RCP<const Basic>& result) {
+        if (capacity_ == 0) {
+            return;
+        }
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            it->second->second = result;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        order_.emplace_front(key, result);
+        index_.emplace(key, order_.begin());
+        evict();
+    }
+
+    void evict() {
+        while (order_.size() > capacity_) {
+            index_.erase(order_.back().first);
+            order_.pop_back();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::list<Entry> order_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEq> index_;
+    std::size_t capacity_ = kDefaultMemoCapacity;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+AntiderivativeMemo& antiderivative_memo() {
+    static AntiderivativeMemo memo;
+    return memo;
+}
+
+// Memo keys carry the variable by name, which a substitution dummy shares
+// with any user symbol of that name, so sub-integrals in a dummy stay out.
+bool memoizable(const RCP<const Basic>& expr, const RCP<const Symbol>& var) {
+    if (SymEngine::is_a<SymEngine::Dummy>(*var)) {
+        return false;
+    }
+    for (const auto& symbol : SymEngine::free_symbols(*expr)) {
+        if (SymEngine::is_a<SymEngine::Dummy>(*symbol)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const int kScreenCells = 32;
+// Relative mismatch between an antiderivative increment and Simpson's rule
+// on the same cell that is taken to signal a pole or branch jump.
+const double kJumpTolerance = 0.25;
+
+// F(b) - F(a) when the antiderivative exists and is continuous on [a, b] as
+// far as a sample grid can tell: F and f must be finite on the grid and each
+// increment of F must roughly agree with Simpson's rule for f on its cell.
+bool symbolic_definite(const RCP<const Basic>& integrand, const RCP<const Symbol>& var,
+                       double a, double b, DefiniteIntegralResult& out) {
+    if (!std::isfinite(a) || !std::isfinite(b)) {
+        return false;
+    }
+    RCP<const Basic> antiderivative;
+    try {
+        IntegrationContext ctx;
+        antiderivative = integrate_expr(integrand, var, ctx);
+    } catch (const SymbolicError&) {
+        return false;
+    }
+
+    // f on the cell ends and midpoints, F on the cell ends.
+    std::vector<double> grid(2 * kScreenCells + 1);
+    for (std::size_t i = 0; i < grid.size(); ++i) {
+        grid[i] = a + (b - a) * i / (2 * kScreenCells);
+    }
+    std::vector<double> ends(kScreenCells + 1);
+    for (int i = 0; i <= kScreenCells; ++i) {
+        ends[i] = grid[2 * i];
+    }
+    std::vector<double> f_values(grid.size());
+    std::vector<double> F_values(ends.size());
+    try {
+        CompiledExpr(integrand, {var->get_name()}).evaluate_batch(grid.data(), grid.size(), f_values.data());
+        CompiledExpr(antiderivative, {var->get_name()}).evaluate_batch(ends.data(), ends.size(), F_values.data());
+    } catch (const NumericError&) {
+        return false;
+    }
+    for (double value : f_values) {
+        if (!std::isfinite(value)) {
+            return false;
+        }
+    }
+    for (double value : F_values) {
+        if (!std::isfinite(value)) {
+            return false;
+        }
+    }
+
+    const double h = (b - a) / kScreenCells;
+    std::vector<double> simpson(kScreenCells);
+    double scale = 0.0;
+    for (int i = 0; i < kScreenCells; ++i) {
+        simpson[i] = h / 6.0 * (f_values[2 * i] + 4.0 * f_values[2 * i + 1] + f_values[2 * i + 2]);
+        scale += std::abs(simpson[i]);
+    }
+    for (int i = 0; i < kScreenCells; ++i) {
+        const double increment = F_values[i + 1] - F_values[i];
+        const double allowed = kJumpTolerance * (std::abs(increment) + std::abs(simpson[i])) + 1e-6 * scale;
+        if (std::abs(increment - simpson[i]) > allowed) {
+            return false;
+        }
+    }
+
+    const double lower = F_values.front();
+    const double upper = F_values.back();
+    out.value = upper - lower;
+    out.error_estimate = std::numeric_limits<double>::epsilon() * (std::abs(upper) + std::abs(lower));
+    out.evaluations = static_cast<int>(grid.size() + ends.size());
+    out.converged = true;
+    out.method = "symbolic";
+    out.antiderivative = antiderivative->__str__();
+    return true;
+}
+
+// Beyond six variables the 2^n corner points of each Genz-Malik region make
+// cubature more expensive than QMC.
+const std::size_t kMaxCubatureVars = 6;
+const int kQmcSamples = 1 << 16;
+const int kQmcReplicas = 16;
+
+DefiniteIntegralResult numeric_definite(const RCP<const Basic>& integrand, const RCP<const Symbol>& var,
+                                        double a, double b, double tol) {
+    const CompiledExpr f(integrand, {var->get_name()});
+    const BatchFunction batch = [&f](const double* x, std::size_t count, double* out) {
+        f.evaluate_batch(x, count, out);
+    };
+
+    bool endpoint_singular = false;
+    int evaluations = 0;
+    for (double limit : {a, b}) {
+        if (std::isfinite(limit)) {
+            endpoint_singular = endpoint_singular || !std::isfinite(f.evaluate(&limit));
+            ++evaluations;
+        }
+    }
+
+    QuadratureResult kronrod{0.0, std::numeric_limits<double>::infinity(), 0, false};
+    if (!endpoint_singular) {
+        try {
+            kronrod = gauss_kronrod(batch, a, b, tol, tol);
+        } catch (const NumericError&) {
+            kronrod.converged = false;
+        }
+        evaluations += kronrod.evaluations;
+        if (kronrod.converged) {
+            return DefiniteIntegralResult{kronrod.value, kronrod.error_estimate, evaluations, true, "gauss_kronrod", ""};
+        }
+    }
+
+    const QuadratureResult tanh = tanh_sinh(batch, a, b, tol, tol);
+    evaluations += tanh.evaluations;
+    if (!tanh.converged && kronrod.error_estimate < tanh.error_estimate) {
+        return DefiniteIntegralResult{kronrod.value, kronrod.error_estimate, evaluations, false, "gauss_kronrod", ""};
+    }
+    return DefiniteIntegralResult{tanh.value, tanh.error_estimate, evaluations, tanh.converged, "tanh_sinh", ""};
+}
+
+}
+
+RCP<const Basic> integrate_expr(
+    const RCP<const Basic>& expr,
+    const RCP<const Symbol>& var,
+    IntegrationContext& ctx
+) {
+    if (++ctx.steps_used > ctx.step_budget) {
+        throw SymbolicError("Integration step budget exceeded");
+    }
+    if (!SymEngine::has_symbol(*expr, *var)) {
+        ctx.rules_fired.push_back("constant");
+        return SymEngine::mul(expr, var);
+    }
+
+    const bool use_memo = ctx.use_memo && memoizable(expr, var);
+    RCP<const Basic> memoized;
+    if (use_memo && antiderivative_memo().lookup(expr, var->get_name(), memoized)) {
+        ctx.rules_fired.push_back("memo");
+        return memoized;
+    }
+
+    const auto arg = primary_arg(expr);
+    const auto arg_shape = classify(arg, var);
+    const bool is_pow = SymEngine::is_a<SymEngine::Pow>(*expr);
+    const auto exp_shape = is_pow ? classify(pow_exp(expr), var) : Shape{SHAPE_ANY, RCP<const Basic>()};
+    const auto& slope = (is_pow && arg_shape.kind == SHAPE_CONSTANT) ? exp_shape.slope : arg_shape.slope;
+    const RuleMatch match{expr, var, arg, slope};
+
+    for (const auto* rule : rule_index().candidates(expr->get_type_code())) {
+        if (!(rule->arg_shapes & arg_shape.kind) || !(rule->exp_shapes & exp_shape.kind)) {
+            continue;
+        }
+        const auto mark = ctx.rules_fired.size();
+        ctx.rules_fired.push_back(rule->name);
+        try {
+            auto result = rule->apply(match, ctx);
+            if (!result.is_null()) {
+                if (use_memo) {
+                    antiderivative_memo().store(expr, var->get_name(), result);
+                }
+                return result;
+            }
+        } catch (const SymbolicError&) {
+            // A nested sub-integral failed; fall through to lower-priority
+            // rules unless the budget itself is gone.
+            if (ctx.steps_used > ctx.step_budget) {
+                throw;
+            }
+        }
+        ctx.rules_fired.resize(mark);
+    }
+    throw SymbolicError("Unsupported integrand");
+}
+
+IntegrationResult integrate_traced(const std::string& expr, const std::string& var, int step_budget) {
+    try {
+        const auto parsed = SymEngine::parse(expr);
+        const auto symbol = SymEngine::symbol(var);
+        IntegrationContext ctx;
+        ctx.step_budget = step_budget;
+        ctx.use_memo = false;
+        const auto result = integrate_expr(parsed, symbol, ctx);
+        return IntegrationResult{result->__str__(), ctx.rules_fired, ctx.steps_used};
+    } catch (const SymbolicError&) {
+        throw;
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+DefiniteIntegralResult integrate_definite(const std::string& expr, const std::string& var, double a, double b, double tol) {
+    if (std::isnan(a) || std::isnan(b)) {
+        throw NumericError("Integration limits must not be NaN");
+    }
+    RCP<const Basic> parsed;
+    try {
+        parsed = SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+    const auto symbol = SymEngine::symbol(var);
+
+    const double lo = std::min(a, b);
+    const double hi = std::max(a, b);
+    const double sign = a <= b ? 1.0 : -1.0;
+    DefiniteIntegralResult result;
+    if (!symbolic_definite(parsed, symbol, lo, hi, result)) {
+        result = numeric_definite(parsed, symbol, lo, hi, tol);
+    }
+    result.value *= sign;
+    return result;
+}
+
+DefiniteIntegralResult integrate_nd(
+    const std::string& expr,
+    const std::vector<std::string>& vars,
+    const std::vector<std::pair<double, double>>& bounds,
+    double tol,
+    unsigned int seed
+) {
+    if (vars.empty() || vars.size() != bounds.size()) {
+        throw NumericError("integrate_nd needs one (lower, upper) pair per variable");
+    }
+    if (vars.size() == 1) {
+        return integrate_definite(expr, vars[0], bounds[0].first, bounds[0].second, tol);
+    }
+    RCP<const Basic> parsed;
+    try {
+        parsed = SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+
+    const CompiledExpr f(parsed, vars);
+    const BatchFunction batch = [&f](const double* points, std::size_t count, double* out) {
+        f.evaluate_batch(points, count, out);
+    };
+    std::vector<double> lower;
+    std::vector<double> upper;
+    for (const auto& bound : bounds) {
+        lower.push_back(bound.first);
+        upper.push_back(bound.second);
+    }
+
+    if (vars.size() <= kMaxCubatureVars) {
+        const auto result = adaptive_cubature(batch, lower, upper, tol, tol);
+        return DefiniteIntegralResult{result.value, result.error_estimate, result.evaluations,
+                                      result.converged, "cubature", ""};
+    }
+    const auto result = qmc_integrate(batch, lower, upper, tol, tol, kQmcSamples, kQmcReplicas, seed);
+    return DefiniteIntegralResult{result.value, result.error_estimate, result.evaluations,
+                                  result.converged, "qmc", ""};
+}
+
+IntegrationMemoStats integration_memo_stats() {
+    return antiderivative_memo().stats();
+}
+
+void clear_integration_memo() {
+    antiderivative_memo().clear();
+}
+
+void set_integration_memo_capacity(std::size_t capacity) {
+    antiderivative_memo().set_capacity(capacity);
+}
+
+std::size_t load_integration_memo(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw SymbolicError("Cannot open integration memo file: " + path);
+    }
+    std::size_t loaded = 0;
+    std::size_t line_number = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const auto first = line.find('\t');
+        const auto second = first == std::string::npos ? first : line.find('\t', first + 1);
+        if (second == std::string::npos) {
+            throw SymbolicError("Malformed integration memo line " + std::to_string(line_number));
+        }
+        const auto var = line.substr(0, first);
+        const auto integrand_str = line.substr(first + 1, second - first - 1);
+        const auto antiderivative_str = line.substr(second + 1);
+        RCP<const Basic> integrand, antiderivative;
+        try {
+            integrand = SymEngine::parse(integrand_str);
+            antiderivative = SymEngine::parse(antiderivative_str);
+        } catch (const std::exception& ex) {
+            throw SymbolicError("Integration memo line " + std::to_string(line_number) + ": " + ex.what());
+        }
+        // A stale or corrupted file must not be served as an answer: the
+        // entry is kept only if it differentiates back to its integrand.
+        bool valid = false;
+        try {
+            valid = check_antiderivative(antiderivative_str, integrand_str, var).ok;
+        } catch (const std::exception&) {
+        }
+        if (!valid) {
+            continue;
+        }
+        antiderivative_memo().store(integrand, var, antiderivative);
+        ++loaded;
+    }
+    return loaded;
+}
+
+std::size_t save_integration_memo(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw SymbolicError("Cannot open integration memo file: " + path);
+    }
+    const auto entries = antiderivative_memo().snapshot();
+    for (const auto& entry : entries) {
+        out << entry.first << '\t' << entry.second.first->__str__() << '\t' << entry.second.second->__str__() << '\n';
+    }
+    return entries.size();
+}
+
+}
@@ -0,0 +1,286 @@
+#include "mathllm/intern.h"
+
+#include <symengine/add.h>
+#include <symengine/functions.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+
+const std::size_t kShards = 64;
+const std::size_t kDefaultInternCapacity = std::size_t(1) << 18;
+
+// The operator of head applied to args; nodes of any other kind are kept
+// as they are, with their own children.
+RCP<const Basic> rebuild(const RCP<const Basic>& head, const SymEngine::vec_basic& args) {
+    if (SymEngine::is_a<SymEngine::Add>(*head)) {
+        return SymEngine::add(args);
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(*head)) {
+        return SymEngine::mul(args);
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*head)) {
+        return SymEngine::pow(args[0], args[1]);
+    }
+    if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*head)) {
+        return SymEngine::down_cast<const SymEngine::OneArgFunction&>(*head).create(args[0]);
+    }
+    if (SymEngine::is_a_sub<SymEngine::TwoArgFunction>(*head)) {
+        return SymEngine::down_cast<const SymEngine::TwoArgFunction&>(*head).create(args[0], args[1]);
+    }
+    if (SymEngine::is_a_sub<SymEngine::MultiArgFunction>(*head)) {
+        return SymEngine::down_cast<const SymEngine::MultiArgFunction&>(*head).create(args);
+    }
+    return head;
+}
+
+// Hash-cons table. Shards are locked independently; counters are atomic
+// so statistics never take a lock. Entries whose only reference is the
+// table are retired under an epoch and released once no pin from an
+// earlier epoch is alive.
+class InternTable {
+public:
+    RCP<const Basic> intern(const RCP<const Basic>& expr) {
+        if (capacity_.load() == 0) {
+            return expr;
+        }
+        RCP<const Basic> found;
+        if (lookup(expr, found)) {
+            ++hits_;
+            return found;
+        }
+        ++misses_;
+        // Children first, so the stored node is built on canonical ones.
+        const auto args = expr->get_args();
+        SymEngine::vec_basic canonical;
+        bool changed = false;
+        for (const auto& arg : args) {
+            canonical.push_back(intern(arg));
+            changed = changed || canonical.back().get() != arg.get();
+        }
+        return insert(changed ? rebuild(expr, canonical) : expr);
+    }
+
+    bool contains(const RCP<const Basic>& expr) const {
+        RCP<const Basic> found;
+        return lookup(expr, found) && found.get() == expr.get();
+    }
+
+    std::uint64_t pin() {
+        std::lock_guard<std::mutex> lock(pins_mutex_);
+        const std::uint64_t epoch = epoch_.load();
+        pins_.insert(epoch);
+        return epoch;
+    }
+
+    void unpin(std::uint64_t epoch) {
+        {
+            std::lock_guard<std::mutex> lock(pins_mutex_);
+            pins_.erase(pins_.find(epoch));
+        }
+        release();
+    }
+
+    std::size_t reclaim() {
+        return retire([](const RCP<const Basic>& node) { return node->use_count() == 1; });
+    }
+
+    void clear() {
+        retire([](const RCP<const Basic>&) { return true; });
+        hits_ = 0;
+        misses_ = 0;
+        rejected_ = 0;
+    }
+
+    void set_capacity(std::size_t capacity) {
+        capacity_ = capacity;
+        if (capacity == 0) {
+            clear();
+        } else if (entries_.load() > capacity) {
+            reclaim();
+        }
+    }
+
+    InternStats stats() const {
+        return InternStats{
+            entries_.load(), capacity_.load(), hits_.load(), misses_.load(),
+            rejected_.load(), retired_.load(), reclaimed_.load(), epoch_.load(),
+        };
+    }
+
+private:
+    using NodeSet = std::unordered_set<RCP<const Basic>, SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq>;
+
+    struct Shard {
+        std::mutex mutex;
+        NodeSet nodes;
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        std::vector<RCP<const Basic>> nodes;
+    };
+
+    Shard& shard_of(const Basic& expr) const {
+        return shards_[static_cast<std::size_t>(expr.hash()) % kShards];
+    }
+
+    bool lookup(const RCP<const Basic>& expr, RCP<const Basic>& out) const {
+        Shard& shard = shard_of(*expr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.nodes.find(expr);
+        if (it == shard.nodes.end()) {
+            return false;
+        }
+        out = *it;
+        return true;
+    }
+
+    // A full table sweeps on the first insert and then once per eighth of
+    // its capacity in further inserts, not on every one.
+    RCP<const Basic> insert(const RCP<const Basic>& node) {
+        const std::size_t capacity = capacity_.load();
+        if (entries_.load() >= capacity) {
+            if (pressure_++ % std::max<std::size_t>(1, capacity / 8) == 0) {
+                reclaim();
+            }
+            if (entries_.load() >= capacity_.load()) {
+                ++rejected_;
+                return node;
+            }
+            pressure_ = 0;
+        }
+        Shard& shard = shard_of(*node);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto inserted = shard.nodes.insert(node);
+        if (inserted.second) {
+            ++entries_;
+        }
+        // Another thread may have interned the same structure meanwhile.
+        return *inserted.first;
+    }
+
+    // Moves the entries selected by retire_if out of the table. The epoch
+    // advances after the sweep, so a pin taken from then on cannot reach
+    // them, while every earlier pin holds them back.
+    template <class Predicate>
+    std::size_t retire(Predicate retire_if) {
+        std::vector<RCP<const Basic>> nodes;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.nodes.begin(); it != shard.nodes.end();) {
+                if (retire_if(*it)) {
+                    nodes.push_back(*it);
+                    it = shard.nodes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        const std::size_t count = nodes.size();
+        entries_ -= count;
+        retired_ += count;
+        const std::uint64_t epoch = ++epoch_;
+        if (count > 0) {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            retired_nodes_.push_back(Retired{epoch, std::move(nodes)});
+        }
+        release();
+        return count;
+    }
+
+    // Drops retired batches that no live pin predates. The nodes are
+    // destroyed outside the locks.
+    void release() {
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        {
+            std::lock_guard<std::mutex> lock(pins_mutex_);
+            if (!pins_.empty()) {
+                oldest = *pins_.begin();
+            }
+        }
+        std::vector<Retired> released;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            auto keep = std::stable_partition(retired_nodes_.begin(), retired_nodes_.end(),
+                [oldest](const Retired& batch) { return batch.epoch > oldest; });
+            std::move(keep, retired_nodes_.end(), std::back_inserter(released));
+            retired_nodes_.erase(keep, retired_nodes_.end());
+        }
+        for (const auto& batch : released) {
+            reclaimed_ += batch.nodes.size();
+        }
+    }
+
+    mutable std::array<Shard, kShards> shards_;
+    std::atomic<std::size_t> capacity_{kDefaultInternCapacity};
+    std::atomic<std::size_t> entries_{0};
+    std::atomic<std::size_t> hits_{0};
+    std::atomic<std::size_t> misses_{0};
+    std::atomic<std::size_t> rejected_{0};
+    std::atomic<std::size_t> retired_{0};
+    std::atomic<std::size_t> reclaimed_{0};
+    std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<std::size_t> pressure_{0};
+
+    std::mutex pins_mutex_;
+    std::multiset<std::uint64_t> pins_;
+    std::mutex retired_mutex_;
+    std::vector<Retired> retired_nodes_;
+};
+
+InternTable& intern_table() {
+    static InternTable table;
+    return table;
+}
+
+}
+
+RCP<const Basic> intern(const RCP<const Basic>& expr) {
+    return intern_table().intern(expr);
+}
+
+bool is_interned(const RCP<const Basic>& expr) {
+    return intern_table().contains(expr);
+}
+
+InternPin::InternPin() : epoch_(intern_table().pin()) {}
+
+InternPin::~InternPin() {
+    intern_table().unpin(epoch_);
+}
+
+InternStats intern_stats() {
+    return intern_table().stats();
+}
+
+void set_intern_capacity(std::size_t capacity) {
+    intern_table().set_capacity(capacity);
+}
+
+std::size_t reclaim_interned() {
+    return intern_table().reclaim();
+}
+
+void clear_intern_table() {
+    intern_table().clear();
+}
+
+}
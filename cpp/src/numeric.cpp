@@ -11,8 +11,13 @@
 #include <symengine/functions.h>
 #include <symengine/integer.h>
 #include <symengine/rational.h>
+#include <symengine/constants.h>
+#include <symengine/eval_double.h>
+#include <symengine/symengine_exception.h>
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <functional>
 #include <random>
 #include <cmath>
 #include <map>
@@ -108,6 +113,154 @@ public:
     }
 };
 
+const std::size_t kBatchBlock = 64;
+
+template <typename F>
+void map_unary(double* dst, const double* src, std::size_t n, F f) {
+    for (std::size_t j = 0; j < n; ++j) {
+        dst[j] = f(src[j]);
+    }
+}
+
+template <typename F>
+void map_binary(double* dst, const double* lhs, const double* rhs, std::size_t n, F f) {
+    for (std::size_t j = 0; j < n; ++j) {
+        dst[j] = f(lhs[j], rhs[j]);
+    }
+}
+
+const double kInf = std::numeric_limits<double>::infinity();
+const double kPi = 3.14159265358979323846;
+
+struct Range {
+    double lo;
+    double hi;
+};
+
+const Range kEmptyRange = {kInf, -kInf};
+const Range kWholeRange = {-kInf, kInf};
+
+bool is_empty(const Range& r) {
+    return r.lo > r.hi;
+}
+
+// Outward rounding by one ulp; a NaN bound means the operation hit an
+// indeterminate form, so nothing is known about the result.
+Range widen(const Range& r) {
+    if (std::isnan(r.lo) || std::isnan(r.hi)) {
+        return kWholeRange;
+    }
+    if (is_empty(r)) {
+        return r;
+    }
+    return {std::nextafter(r.lo, -kInf), std::nextafter(r.hi, kInf)};
+}
+
+// Whether [r.lo, r.hi] contains offset + k * period for some integer k.
+bool contains_point(const Range& r, double offset, double period) {
+    return offset + std::ceil((r.lo - offset) / period) * period <= r.hi;
+}
+
+template <typename F>
+Range increasing(const Range& r, F f) {
+    return {f(r.lo), f(r.hi)};
+}
+
+Range mul_range(const Range& a, const Range& b) {
+    double products[4] = {a.lo * b.lo, a.lo * b.hi, a.hi * b.lo, a.hi * b.hi};
+    for (double& p : products) {
+        // 0 * inf: the other corners already carry the unbounded side.
+        if (std::isnan(p)) {
+            p = 0.0;
+        }
+    }
+    return {*std::min_element(products, products + 4), *std::max_element(products, products + 4)};
+}
+
+Range abs_range(const Range& a) {
+    if (a.lo >= 0.0) {
+        return a;
+    }
+    if (a.hi <= 0.0) {
+        return {-a.hi, -a.lo};
+    }
+    return {0.0, std::max(-a.lo, a.hi)};
+}
+
+Range recip_range(const Range& a) {
+    if (a.lo > 0.0 || a.hi < 0.0) {
+        return {1.0 / a.hi, 1.0 / a.lo};
+    }
+    if (a.lo == 0.0 && a.hi == 0.0) {
+        return kEmptyRange;
+    }
+    if (a.lo == 0.0) {
+        return {1.0 / a.hi, kInf};
+    }
+    if (a.hi == 0.0) {
+        return {-kInf, 1.0 / a.lo};
+    }
+    return kWholeRange;
+}
+
+Range sin_range(const Range& a) {
+    if (!(a.hi - a.lo < 2.0 * kPi)) {
+        return {-1.0, 1.0};
+    }
+    const double s_lo = std::sin(a.lo);
+    const double s_hi = std::sin(a.hi);
+    return {contains_point(a, -0.5 * kPi, 2.0 * kPi) ? -1.0 : std::min(s_lo, s_hi),
+            contains_point(a, 0.5 * kPi, 2.0 * kPi) ? 1.0 : std::max(s_lo, s_hi)};
+}
+
+Range cos_range(const Range& a) {
+    if (!(a.hi - a.lo < 2.0 * kPi)) {
+        return {-1.0, 1.0};
+    }
+    const double c_lo = std::cos(a.lo);
+    const double c_hi = std::cos(a.hi);
+    return {contains_point(a, kPi, 2.0 * kPi) ? -1.0 : std::min(c_lo, c_hi),
+            contains_point(a, 0.0, 2.0 * kPi) ? 1.0 : std::max(c_lo, c_hi)};
+}
+
+Range tan_range(const Range& a) {
+    if (!(a.hi - a.lo < kPi) || contains_point(a, 0.5 * kPi, kPi)) {
+        return kWholeRange;
+    }
+    return increasing(a, [](double v) { return std::tan(v); });
+}
+
+Range pow_range(const Range& base, const Range& exp) {
+    if (exp.lo == exp.hi && std::nearbyint(exp.lo) == exp.lo && std::abs(exp.lo) < 1e15) {
+        const double n = exp.lo;
+        if (n == 0.0) {
+            return {1.0, 1.0};
+        }
+        if (n < 0.0) {
+            return recip_range(pow_range(base, {-n, -n}));
+        }
+        if (std::fmod(n, 2.0) != 0.0) {
+            return {std::pow(base.lo, n), std::pow(base.hi, n)};
+        }
+        const Range magnitude = abs_range(base);
+        return {std::pow(magnitude.lo, n), std::pow(magnitude.hi, n)};
+    }
+    // Non-integer powers are real only for non-negative bases.
+    if (base.hi < 0.0) {
+        return kEmptyRange;
+    }
+    const Range clamped = {std::max(base.lo, 0.0), base.hi};
+    if (exp.lo == exp.hi) {
+        return exp.lo > 0.0 ? Range{std::pow(clamped.lo, exp.lo), std::pow(clamped.hi, exp.lo)}
+                            : Range{std::pow(clamped.hi, exp.lo), std::pow(clamped.lo, exp.lo)};
+    }
+    if (clamped.lo > 0.0) {
+        const Range log_base = increasing(clamped, [](double v) { return std::log(v); });
+        return increasing(mul_range(exp, log_base), [](double v) { return std::exp(v); });
+    }
+    return kWholeRange;
+}
+
 double evaluate_at_point(
     const RCP<const Basic>& expr,
     const std::map<std::string, double>& point
@@ -208,4 +361,267 @@ ProbeResult probe_equal(
     };
 }
 
+CompiledExpr::CompiledExpr(const RCP<const Basic>& expr, const std::vector<std::string>& symbols) {
+    init({expr}, symbols);
+}
+
+CompiledExpr::CompiledExpr(const std::string& expr, const std::vector<std::string>& symbols) {
+    RCP<const Basic> parsed;
+    try {
+        parsed = SymEngine::parse(expr);
+    } catch (const std::exception& e) {
+        throw NumericError(std::string("Parse error: ") + e.what());
+    }
+    init({parsed}, symbols);
+}
+
+CompiledExpr::CompiledExpr(const SymEngine::vec_basic& exprs, const std::vector<std::string>& symbols) {
+    if (exprs.empty()) {
+        throw NumericError("No expressions to compile");
+    }
+    init(exprs, symbols);
+}
+
+void CompiledExpr::init(const SymEngine::vec_basic& exprs, const std::vector<std::string>& symbols) {
+    num_symbols_ = symbols.size();
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        symbol_index_[symbols[i]] = static_cast<int>(i);
+    }
+    for (const auto& expr : exprs) {
+        outputs_.push_back(compile(expr));
+    }
+    slots_.clear();
+}
+
+int CompiledExpr::emit(Op op, int lhs, int rhs, double value) {
+    const bool foldable = op != Op::Const && op != Op::Var
+        && tape_[lhs].op == Op::Const && (rhs < 0 || tape_[rhs].op == Op::Const);
+    if (foldable) {
+        const double rhs_value = rhs < 0 ? 0.0 : tape_[rhs].value;
+        execute(op, &value, &tape_[lhs].value, &rhs_value, 1);
+        op = Op::Const;
+        lhs = rhs = -1;
+    }
+    tape_.push_back(Instr{op, lhs, rhs, value});
+    return static_cast<int>(tape_.size()) - 1;
+}
+
+int CompiledExpr::compile(const RCP<const Basic>& expr) {
+    auto cached = slots_.find(expr);
+    if (cached != slots_.end()) {
+        return cached->second;
+    }
+
+    int slot;
+    if (SymEngine::is_a<SymEngine::Symbol>(*expr)) {
+        const auto& name = SymEngine::rcp_static_cast<const Symbol>(expr)->get_name();
+        auto it = symbol_index_.find(name);
+        if (it == symbol_index_.end()) {
+            throw NumericError("Undefined symbol: " + name);
+        }
+        slot = emit(Op::Var, it->second);
+    } else if (SymEngine::is_a_Number(*expr) || SymEngine::is_a<SymEngine::Constant>(*expr)) {
+        double value;
+        try {
+            value = SymEngine::eval_double(*expr);
+        } catch (const SymEngine::SymEngineException& e) {
+            throw NumericError(std::string("Cannot evaluate constant: ") + e.what());
+        }
+        slot = emit(Op::Const, -1, -1, value);
+    } else if (SymEngine::is_a<SymEngine::Add>(*expr) || SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        const Op op = SymEngine::is_a<SymEngine::Add>(*expr) ? Op::Add : Op::Mul;
+        const auto args = expr->get_args();
+        slot = compile(args[0]);
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            slot = emit(op, slot, compile(args[i]));
+        }
+    } else if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+        const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*expr);
+        const auto& base = pow.get_base();
+        const auto& exp = pow.get_exp();
+        if (SymEngine::eq(*base, *SymEngine::E)) {
+            slot = emit(Op::Exp, compile(exp));
+        } else if (SymEngine::eq(*exp, *SymEngine::integer(2))) {
+            slot = emit(Op::Square, compile(base));
+        } else if (SymEngine::eq(*exp, *SymEngine::minus_one)) {
+            slot = emit(Op::Recip, compile(base));
+        } else if (SymEngine::eq(*exp, *SymEngine::rational(1, 2))) {
+            slot = emit(Op::Sqrt, compile(base));
+        } else {
+            slot = emit(Op::Pow, compile(base), compile(exp));
+        }
+    } else if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*expr)) {
+        Op op;
+        switch (expr->get_type_code()) {
+            case SymEngine::SYMENGINE_LOG: op = Op::Log; break;
+            case SymEngine::SYMENGINE_SIN: op = Op::Sin; break;
+            case SymEngine::SYMENGINE_COS: op = Op::Cos; break;
+            case SymEngine::SYMENGINE_TAN: op = Op::Tan; break;
+            case SymEngine::SYMENGINE_COT: op = Op::Cot; break;
+            case SymEngine::SYMENGINE_SEC: op = Op::Sec; break;
+            case SymEngine::SYMENGINE_CSC: op = Op::Csc; break;
+            case SymEngine::SYMENGINE_ASIN: op = Op::Asin; break;
+            case SymEngine::SYMENGINE_ACOS: op = Op::Acos; break;
+            case SymEngine::SYMENGINE_ATAN: op = Op::Atan; break;
+            case SymEngine::SYMENGINE_SINH: op = Op::Sinh; break;
+            case SymEngine::SYMENGINE_COSH: op = Op::Cosh; break;
+            case SymEngine::SYMENGINE_TANH: op = Op::Tanh; break;
+            case SymEngine::SYMENGINE_ABS: op = Op::Abs; break;
+            default:
+                throw NumericError("Unsupported function for compilation: " + expr->__str__());
+        }
+        const auto& arg = SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).get_arg();
+        slot = emit(op, compile(arg));
+    } else {
+        throw NumericError("Unsupported expression type for compilation: " + expr->__str__());
+    }
+    slots_[expr] = slot;
+    return slot;
+}
+
+void CompiledExpr::execute(Op op, double* dst, const double* lhs, const double* rhs, std::size_t n) {
+    switch (op) {
+        case Op::Add: map_binary(dst, lhs, rhs, n, std::plus<double>()); break;
+        case Op::Mul: map_binary(dst, lhs, rhs, n, std::multiplies<double>()); break;
+        case Op::Pow: map_binary(dst, lhs, rhs, n, [](double a, double b) { return std::pow(a, b); }); break;
+        case Op::Square: map_unary(dst, lhs, n, [](double v) { return v * v; }); break;
+        case Op::Sqrt: map_unary(dst, lhs, n, [](double v) { return std::sqrt(v); }); break;
+        case Op::Recip: map_unary(dst, lhs, n, [](double v) { return 1.0 / v; }); break;
+        case Op::Exp: map_unary(dst, lhs, n, [](double v) { return std::exp(v); }); break;
+        case Op::Log: map_unary(dst, lhs, n, [](double v) { return std::log(v); }); break;
+        case Op::Sin: map_unary(dst, lhs, n, [](double v) { return std::sin(v); }); break;
+        case Op::Cos: map_unary(dst, lhs, n, [](double v) { return std::cos(v); }); break;
+        case Op::Tan: map_unary(dst, lhs, n, [](double v) { return std::tan(v); }); break;
+        case Op::Cot: map_unary(dst, lhs, n, [](double v) { return 1.0 / std::tan(v); }); break;
+        case Op::Sec: map_unary(dst, lhs, n, [](double v) { return 1.0 / std::cos(v); }); break;
+        case Op::Csc: map_unary(dst, lhs, n, [](double v) { return 1.0 / std::sin(v); }); break;
+        case Op::Asin: map_unary(dst, lhs, n, [](double v) { return std::asin(v); }); break;
+        case Op::Acos: map_unary(dst, lhs, n, [](double v) { return std::acos(v); }); break;
+        case Op::Atan: map_unary(dst, lhs, n, [](double v) { return std::atan(v); }); break;
+        case Op::Sinh: map_unary(dst, lhs, n, [](double v) { return std::sinh(v); }); break;
+        case Op::Cosh: map_unary(dst, lhs, n, [](double v) { return std::cosh(v); }); break;
+        case Op::Tanh: map_unary(dst, lhs, n, [](double v) { return std::tanh(v); }); break;
+        case Op::Abs: map_unary(dst, lhs, n, [](double v) { return std::abs(v); }); break;
+        case Op::Const:
+        case Op::Var:
+            break;
+    }
+}
+
+void CompiledExpr::run(const double* points, std::size_t n, std::size_t stride, double* regs, double* out) const {
+    for (std::size_t i = 0; i < tape_.size(); ++i) {
+        const Instr& instr = tape_[i];
+        double* dst = regs + i * stride;
+        if (instr.op == Op::Const) {
+            std::fill(dst, dst + n, instr.value);
+        } else if (instr.op == Op::Var) {
+            for (std::size_t j = 0; j < n; ++j) {
+                dst[j] = points[j * num_symbols_ + instr.lhs];
+            }
+        } else {
+            const double* rhs = instr.rhs < 0 ? nullptr : regs + instr.rhs * stride;
+            execute(instr.op, dst, regs + instr.lhs * stride, rhs, n);
+        }
+    }
+    const std::size_t width = outputs_.size();
+    for (std::size_t k = 0; k < width; ++k) {
+        const double* values = regs + outputs_[k] * stride;
+        for (std::size_t j = 0; j < n; ++j) {
+            out[j * width + k] = values[j];
+        }
+    }
+}
+
+double CompiledExpr::evaluate(const double* point) const {
+    std::vector<double> regs(tape_.size());
+    std::vector<double> result(outputs_.size());
+    run(point, 1, 1, regs.data(), result.data());
+    return result[0];
+}
+
+void CompiledExpr::evaluate_all(const double* point, double* out) const {
+    std::vector<double> regs(tape_.size());
+    run(point, 1, 1, regs.data(), out);
+}
+
+double CompiledExpr::evaluate(const std::vector<double>& point) const {
+    if (point.size() != num_symbols_) {
+        throw NumericError("Point dimension does not match compiled symbols");
+    }
+    return evaluate(point.data());
+}
+
+void CompiledExpr::evaluate_batch(const double* points, std::size_t count, double* out) const {
+    std::vector<double> regs(tape_.size() * kBatchBlock);
+    for (std::size_t start = 0; start < count; start += kBatchBlock) {
+        const std::size_t n = std::min(kBatchBlock, count - start);
+        run(points + start * num_symbols_, n, kBatchBlock, regs.data(), out + start * outputs_.size());
+    }
+}
+
+void CompiledExpr::evaluate_interval(const double* lower, const double* upper, double& lo, double& hi) const {
+    std::vector<Range> regs(tape_.size());
+    for (std::size_t i = 0; i < tape_.size(); ++i) {
+        const Instr& instr = tape_[i];
+        if (instr.op == Op::Const) {
+            regs[i] = {instr.value, instr.value};
+            continue;
+        }
+        if (instr.op == Op::Var) {
+            regs[i] = {lower[instr.lhs], upper[instr.lhs]};
+            continue;
+        }
+        const Range a = regs[instr.lhs];
+        const Range b = instr.rhs < 0 ? Range{0.0, 0.0} : regs[instr.rhs];
+        if (is_empty(a) || is_empty(b)) {
+            regs[i] = kEmptyRange;
+            continue;
+        }
+        Range r = kWholeRange;
+        switch (instr.op) {
+            case Op::Add: r = {a.lo + b.lo, a.hi + b.hi}; break;
+            case Op::Mul: r = mul_range(a, b); break;
+            case Op::Pow: r = pow_range(a, b); break;
+            case Op::Square: r = pow_range(a, {2.0, 2.0}); break;
+            case Op::Sqrt:
+                r = a.hi < 0.0 ? kEmptyRange : Range{std::sqrt(std::max(a.lo, 0.0)), std::sqrt(a.hi)};
+                break;
+            case Op::Recip: r = recip_range(a); break;
+            case Op::Exp: r = increasing(a, [](double v) { return std::exp(v); }); break;
+            case Op::Log:
+                r = a.hi < 0.0 ? kEmptyRange : Range{std::log(std::max(a.lo, 0.0)), std::log(a.hi)};
+                break;
+            case Op::Sin: r = sin_range(a); break;
+            case Op::Cos: r = cos_range(a); break;
+            case Op::Tan: r = tan_range(a); break;
+            case Op::Cot: r = recip_range(tan_range(a)); break;
+            case Op::Sec: r = recip_range(cos_range(a)); break;
+            case Op::Csc: r = recip_range(sin_range(a)); break;
+            case Op::Asin:
+            case Op::Acos: {
+                const Range clamped = {std::max(a.lo, -1.0), std::min(a.hi, 1.0)};
+                if (is_empty(clamped)) {
+                    r = kEmptyRange;
+                } else if (instr.op == Op::Asin) {
+                    r = increasing(clamped, [](double v) { return std::asin(v); });
+                } else {
+                    r = {std::acos(clamped.hi), std::acos(clamped.lo)};
+                }
+                break;
+            }
+            case Op::Atan: r = increasing(a, [](double v) { return std::atan(v); }); break;
+            case Op::Sinh: r = increasing(a, [](double v) { return std::sinh(v); }); break;
+            case Op::Cosh: r = increasing(abs_range(a), [](double v) { return std::cosh(v); }); break;
+            case Op::Tanh: r = increasing(a, [](double v) { return std::tanh(v); }); break;
+            case Op::Abs: r = abs_range(a); break;
+            case Op::Const:
+            case Op::Var:
+                break;
+        }
+        regs[i] = widen(r);
+    }
+    lo = regs[outputs_[0]].lo;
+    hi = regs[outputs_[0]].hi;
+}
+
 }
@@ -0,0 +1,565 @@
+#include "mathllm/polynomial.h"
+#include "mathllm/roots.h"
+
+#include <symengine/add.h>
+#include <symengine/complex_double.h>
+#include <symengine/constants.h>
+#include <symengine/eval_double.h>
+#include <symengine/integer.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/sets.h>
+#include <symengine/solve.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <utility>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::Symbol;
+using Coeff = DensePoly::Coeff;
+
+const long kMaxRootCandidate = 1000000;
+// Powers above this are not expanded when probing for a polynomial.
+const int kMaxExpandExponent = 1000;
+// Numeric roots with |imag| below this fraction of |root| are reported real.
+const double kRealRootTolerance = 1e-12;
+
+// Exponents are range-checked as big integers before narrowing, so a
+// huge one can neither wrap around nor size a dense vector.
+bool nonnegative_int(const RCP<const Basic>& value, int& out) {
+    if (!SymEngine::is_a<SymEngine::Integer>(*value)) {
+        return false;
+    }
+    const auto& integer = SymEngine::rcp_static_cast<const SymEngine::Integer>(value);
+    if (integer->is_negative()
+        || integer->as_integer_class() > SymEngine::integer_class(DensePoly::kMaxDegree)) {
+        return false;
+    }
+    out = static_cast<int>(integer->as_int());
+    return true;
+}
+
+// Splits an expanded term into c * var^k with c a number, exact unless
+// exact is false.
+bool split_monomial(const RCP<const Basic>& term, const RCP<const Symbol>& var, Coeff& coeff, int& degree,
+                    bool exact = true) {
+    if (SymEngine::is_a_Number(*term)) {
+        coeff = SymEngine::rcp_static_cast<const SymEngine::Number>(term);
+        degree = 0;
+        return !exact || coeff->is_exact();
+    }
+    if (SymEngine::eq(*term, *var)) {
+        coeff = SymEngine::one;
+        degree = 1;
+        return true;
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*term)) {
+        const auto& pow_term = SymEngine::rcp_static_cast<const SymEngine::Pow>(term);
+        coeff = SymEngine::one;
+        return SymEngine::eq(*pow_term->get_base(), *var) && nonnegative_int(pow_term->get_exp(), degree);
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+        const auto& mul_term = SymEngine::rcp_static_cast<const SymEngine::Mul>(term);
+        const auto& dict = mul_term->get_dict();
+        if (dict.size() != 1 || !SymEngine::eq(*dict.begin()->first, *var)) {
+            return false;
+        }
+        coeff = mul_term->get_coef();
+        return (!exact || coeff->is_exact()) && nonnegative_int(dict.begin()->second, degree);
+    }
+    return false;
+}
+
+// Cheap structural test run before expand(): only var, numbers, sums,
+// products and non-negative integer powers can expand to a polynomial in
+// var. Inexact numbers are rejected unless exact is false.
+bool polynomial_shape(const RCP<const Basic>& expr, const RCP<const Symbol>& var, bool exact = true) {
+    if (SymEngine::is_a_Number(*expr)) {
+        return !exact || SymEngine::rcp_static_cast<const SymEngine::Number>(expr)->is_exact();
+    }
+    if (SymEngine::is_a<Symbol>(*expr)) {
+        return SymEngine::eq(*expr, *var);
+    }
+    if (SymEngine::is_a<SymEngine::Add>(*expr) || SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        for (const auto& arg : expr->get_args()) {
+            if (!polynomial_shape(arg, var, exact)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+        const auto& pow = SymEngine::rcp_static_cast<const SymEngine::Pow>(expr);
+        int exponent = 0;
+        return nonnegative_int(pow->get_exp(), exponent) && exponent <= kMaxExpandExponent
+            && polynomial_shape(pow->get_base(), var, exact);
+    }
+    return false;
+}
+
+RCP<const Basic> to_number(const std::complex<double>& root) {
+    if (std::abs(root.imag()) <= kRealRootTolerance * std::max(1.0, std::abs(root))) {
+        return SymEngine::real_double(root.real());
+    }
+    return SymEngine::complex_double(root);
+}
+
+bool to_long(const RCP<const SymEngine::Integer>& value, long& out) {
+    try {
+        out = value->as_int();
+        return true;
+    } catch (const SymEngine::SymEngineException&) {
+        return false;
+    }
+}
+
+bool num_den(const Coeff& value, long& num, long& den) {
+    if (SymEngine::is_a<SymEngine::Integer>(*value)) {
+        den = 1;
+        return to_long(SymEngine::rcp_static_cast<const SymEngine::Integer>(value), num);
+    }
+    if (SymEngine::is_a<SymEngine::Rational>(*value)) {
+        const auto& rational = SymEngine::rcp_static_cast<const SymEngine::Rational>(value);
+        return to_long(rational->get_num(), num) && to_long(rational->get_den(), den);
+    }
+    return false;
+}
+
+std::vector<long> divisors(long n) {
+    std::vector<long> result;
+    for (long d = 1; d * d <= n; ++d) {
+        if (n % d == 0) {
+            result.push_back(d);
+            if (d != n / d) {
+                result.push_back(n / d);
+            }
+        }
+    }
+    return result;
+}
+
+}
+
+DensePoly::DensePoly(std::vector<Coeff> coeffs) : coeffs_(std::move(coeffs)) {
+    trim();
+}
+
+DensePoly DensePoly::constant(const Coeff& value) {
+    return DensePoly({value});
+}
+
+DensePoly DensePoly::monomial(const Coeff& value, int degree) {
+    std::vector<Coeff> coeffs(degree + 1, SymEngine::zero);
+    coeffs[degree] = value;
+    return DensePoly(std::move(coeffs));
+}
+
+void DensePoly::trim() {
+    while (!coeffs_.empty() && coeffs_.back()->is_zero()) {
+        coeffs_.pop_back();
+    }
+}
+
+bool DensePoly::from_basic(const RCP<const Basic>& expr, const RCP<const Symbol>& var, DensePoly& out) {
+    if (!polynomial_shape(expr, var)) {
+        return false;
+    }
+    return from_expanded(SymEngine::expand(expr), var, out);
+}
+
+bool DensePoly::from_expanded(const RCP<const Basic>& expr, const RCP<const Symbol>& var, DensePoly& out) {
+    SymEngine::vec_basic terms;
+    if (SymEngine::is_a<SymEngine::Add>(*expr)) {
+        terms = expr->get_args();
+    } else {
+        terms.push_back(expr);
+    }
+    std::vector<Coeff> coeffs;
+    for (const auto& term : terms) {
+        Coeff coeff;
+        int degree = 0;
+        if (!split_monomial(term, var, coeff, degree)) {
+            return false;
+        }
+        if (static_cast<int>(coeffs.size()) <= degree) {
+            coeffs.resize(degree + 1, SymEngine::zero);
+        }
+        coeffs[degree] = SymEngine::addnum(coeffs[degree], coeff);
+    }
+    out = DensePoly(std::move(coeffs));
+    return true;
+}
+
+RCP<const Basic> DensePoly::to_basic(const RCP<const Symbol>& var) const {
+    SymEngine::vec_basic terms;
+    terms.reserve(coeffs_.size());
+    for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+        if (!coeffs_[i]->is_zero()) {
+            terms.push_back(SymEngine::mul(coeffs_[i], SymEngine::pow(var, SymEngine::integer(static_cast<long>(i)))));
+        }
+    }
+    return SymEngine::add(terms);
+}
+
+Coeff DensePoly::coeff(int i) const {
+    if (i < 0 || i > degree()) {
+        return SymEngine::zero;
+    }
+    return coeffs_[i];
+}
+
+Coeff DensePoly::leading_coeff() const {
+    return is_zero() ? Coeff(SymEngine::zero) : coeffs_.back();
+}
+
+DensePoly DensePoly::operator+(const DensePoly& other) const {
+    std::vector<Coeff> result(std::max(coeffs_.size(), other.coeffs_.size()), SymEngine::zero);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i] = SymEngine::addnum(coeff(static_cast<int>(i)), other.coeff(static_cast<int>(i)));
+    }
+    return DensePoly(std::move(result));
+}
+
+DensePoly DensePoly::operator-(const DensePoly& other) const {
+    std::vector<Coeff> result(std::max(coeffs_.size(), other.coeffs_.size()), SymEngine::zero);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i] = SymEngine::subnum(coeff(static_cast<int>(i)), other.coeff(static_cast<int>(i)));
+    }
+    return DensePoly(std::move(result));
+}
+
+DensePoly DensePoly::operator*(const DensePoly& other) const {
+    if (is_zero() || other.is_zero()) {
+        return DensePoly();
+    }
+    std::vector<Coeff> result(coeffs_.size() + other.coeffs_.size() - 1, SymEngine::zero);
+    for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+        if (coeffs_[i]->is_zero()) {
+            continue;
+        }
+        for (std::size_t j = 0; j < other.coeffs_.size(); ++j) {
+            result[i + j] = SymEngine::addnum(result[i + j], SymEngine::mulnum(coeffs_[i], other.coeffs_[j]));
+        }
+    }
+    return DensePoly(std::move(result));
+}
+
+DensePoly DensePoly::scale(const Coeff& factor) const {
+    std::vector<Coeff> result(coeffs_.size());
+    for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+        result[i] = SymEngine::mulnum(coeffs_[i], factor);
+    }
+    return DensePoly(std::move(result));
+}
+
+DensePoly DensePoly::monic() const {
+    if (is_zero()) {
+        return *this;
+    }
+    return scale(SymEngine::divnum(SymEngine::one, leading_coeff()));
+}
+
+DensePoly DensePoly::derivative() const {
+    if (coeffs_.size() <= 1) {
+        return DensePoly();
+    }
+    std::vector<Coeff> result(coeffs_.size() - 1);
+    for (std::size_t i = 1; i < coeffs_.size(); ++i) {
+        result[i - 1] = SymEngine::mulnum(coeffs_[i], SymEngine::integer(static_cast<long>(i)));
+    }
+    return DensePoly(std::move(result));
+}
+
+DensePoly DensePoly::antiderivative() const {
+    std::vector<Coeff> result(coeffs_.size() + 1, SymEngine::zero);
+    for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+        result[i + 1] = SymEngine::divnum(coeffs_[i], SymEngine::integer(static_cast<long>(i + 1)));
+    }
+    return DensePoly(std::move(result));
+}
+
+Coeff DensePoly::evaluate(const Coeff& x) const {
+    Coeff result = SymEngine::zero;
+    for (auto it = coeffs_.rbegin(); it != coeffs_.rend(); ++it) {
+        result = SymEngine::addnum(SymEngine::mulnum(result, x), *it);
+    }
+    return result;
+}
+
+void DensePoly::divmod(const DensePoly& a, const DensePoly& b, DensePoly& quotient, DensePoly& remainder) {
+    if (b.is_zero()) {
+        throw SymbolicError("Polynomial division by zero");
+    }
+    std::vector<Coeff> rem = a.coeffs_;
+    const int db = b.degree();
+    if (a.degree() < db) {
+        quotient = DensePoly();
+        remainder = a;
+        return;
+    }
+    std::vector<Coeff> quot(a.degree() - db + 1, SymEngine::zero);
+    const auto lead = b.leading_coeff();
+    for (int i = a.degree(); i >= db; --i) {
+        if (rem[i]->is_zero()) {
+            continue;
+        }
+        const auto factor = SymEngine::divnum(rem[i], lead);
+        quot[i - db] = factor;
+        for (int j = 0; j <= db; ++j) {
+            rem[i - db + j] = SymEngine::subnum(rem[i - db + j], SymEngine::mulnum(factor, b.coeffs_[j]));
+        }
+    }
+    rem.resize(db);
+    quotient = DensePoly(std::move(quot));
+    remainder = DensePoly(std::move(rem));
+}
+
+DensePoly DensePoly::extended_gcd(const DensePoly& a, const DensePoly& b, DensePoly& s, DensePoly& t) {
+    DensePoly r0 = a, r1 = b;
+    DensePoly s0 = constant(SymEngine::one), s1;
+    DensePoly t0, t1 = constant(SymEngine::one);
+    while (!r1.is_zero()) {
+        DensePoly q, r;
+        divmod(r0, r1, q, r);
+        r0 = std::exchange(r1, r);
+        s0 = std::exchange(s1, s0 - q * s1);
+        t0 = std::exchange(t1, t0 - q * t1);
+    }
+    if (r0.is_zero()) {
+        s = DensePoly();
+        t = DensePoly();
+        return r0;
+    }
+    const auto inv_lead = SymEngine::divnum(SymEngine::one, r0.leading_coeff());
+    s = s0.scale(inv_lead);
+    t = t0.scale(inv_lead);
+    return r0.scale(inv_lead);
+}
+
+DensePoly DensePoly::gcd(const DensePoly& a, const DensePoly& b) {
+    DensePoly r0 = a, r1 = b;
+    while (!r1.is_zero()) {
+        DensePoly q, r;
+        divmod(r0, r1, q, r);
+        r0 = std::exchange(r1, r);
+    }
+    return r0.monic();
+}
+
+std::vector<DensePoly> DensePoly::square_free() const {
+    std::vector<DensePoly> factors;
+    if (degree() < 1) {
+        return factors;
+    }
+    const DensePoly f = monic();
+    const DensePoly f_prime = f.derivative();
+    DensePoly a = gcd(f, f_prime);
+    DensePoly b, c, d, unused;
+    divmod(f, a, b, unused);
+    divmod(f_prime, a, c, unused);
+    d = c - b.derivative();
+    while (b.degree() > 0) {
+        a = gcd(b, d);
+        factors.push_back(a);
+        DensePoly next_b;
+        divmod(b, a, next_b, unused);
+        divmod(d, a, c, unused);
+        b = next_b;
+        d = c - b.derivative();
+    }
+    return factors;
+}
+
+std::vector<Coeff> DensePoly::rational_roots() const {
+    std::vector<Coeff> roots;
+    if (degree() < 1) {
+        return roots;
+    }
+    std::vector<long> nums(coeffs_.size()), dens(coeffs_.size());
+    long lcm = 1;
+    for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+        if (!num_den(coeffs_[i], nums[i], dens[i])) {
+            return roots;
+        }
+        lcm = std::lcm(lcm, dens[i]);
+        if (lcm > kMaxRootCandidate) {
+            return roots;
+        }
+    }
+    std::size_t low = 0;
+    while (nums[low] == 0) {
+        ++low;
+    }
+    if (low > 0) {
+        roots.push_back(SymEngine::zero);
+    }
+    if (static_cast<int>(low) == degree()) {
+        return roots;
+    }
+    if (std::labs(nums[low]) > kMaxRootCandidate || std::labs(nums.back()) > kMaxRootCandidate) {
+        return roots;
+    }
+    const long constant_term = std::labs(nums[low] * (lcm / dens[low]));
+    const long leading_term = std::labs(nums.back() * (lcm / dens.back()));
+    if (constant_term > kMaxRootCandidate || leading_term > kMaxRootCandidate) {
+        return roots;
+    }
+    for (long p : divisors(constant_term)) {
+        for (long q : divisors(leading_term)) {
+            if (std::gcd(p, q) != 1) {
+                continue;
+            }
+            for (long sign : {1L, -1L}) {
+                const auto candidate = SymEngine::Rational::from_two_ints(sign * p, q);
+                if (evaluate(candidate)->is_zero()) {
+                    roots.push_back(candidate);
+                }
+            }
+        }
+    }
+    return roots;
+}
+
+DensePoly DensePoly::square_free_part() const {
+    if (degree() < 1) {
+        return *this;
+    }
+    DensePoly quotient, remainder;
+    divmod(*this, gcd(*this, derivative()), quotient, remainder);
+    return quotient.monic();
+}
+
+SymEngine::vec_basic polynomial_roots(const DensePoly& poly) {
+    SymEngine::vec_basic roots;
+    if (poly.degree() < 1) {
+        return roots;
+    }
+    DensePoly rest = poly.square_free_part();
+    for (const auto& root : rest.rational_roots()) {
+        roots.push_back(root);
+        DensePoly quotient, remainder;
+        DensePoly::divmod(rest, DensePoly({SymEngine::mulnum(root, SymEngine::minus_one), SymEngine::one}),
+                          quotient, remainder);
+        rest = quotient;
+    }
+
+    const auto& c = rest.coeffs();
+    switch (rest.degree()) {
+        case -1:
+        case 0:
+            break;
+        case 1:
+            roots.push_back(SymEngine::divnum(SymEngine::mulnum(c[0], SymEngine::minus_one), c[1]));
+            break;
+        case 2: {
+            const auto discriminant = SymEngine::subnum(
+                SymEngine::mulnum(c[1], c[1]),
+                SymEngine::mulnum(SymEngine::integer(4), SymEngine::mulnum(c[2], c[0])));
+            const auto root = SymEngine::sqrt(discriminant);
+            const auto denominator = SymEngine::mul(SymEngine::integer(2), c[2]);
+            const auto minus_b = SymEngine::neg(c[1]);
+            roots.push_back(SymEngine::div(SymEngine::add(minus_b, root), denominator));
+            roots.push_back(SymEngine::div(SymEngine::sub(minus_b, root), denominator));
+            break;
+        }
+        case 3:
+        case 4: {
+            const SymEngine::vec_basic coeffs(c.begin(), c.end());
+            const auto solutions = rest.degree() == 3 ? SymEngine::solve_poly_cubic(coeffs)
+                                                       : SymEngine::solve_poly_quartic(coeffs);
+            if (SymEngine::is_a<SymEngine::FiniteSet>(*solutions)) {
+                for (const auto& root : SymEngine::rcp_static_cast<const SymEngine::FiniteSet>(solutions)->get_container()) {
+                    roots.push_back(root);
+                }
+                break;
+            }
+            for (const auto& root : numeric_roots(rest)) {
+                roots.push_back(to_number(root));
+            }
+            break;
+        }
+        default:
+            for (const auto& root : numeric_roots(rest)) {
+                roots.push_back(to_number(root));
+            }
+            break;
+    }
+    return roots;
+}
+
+std::vector<std::complex<double>> numeric_roots(const DensePoly& poly) {
+    if (poly.degree() < 1) {
+        return {};
+    }
+    std::vector<double> coeffs;
+    coeffs.reserve(poly.coeffs().size());
+    for (const auto& coeff : poly.coeffs()) {
+        coeffs.push_back(SymEngine::eval_double(*coeff));
+    }
+    std::vector<std::complex<double>> roots;
+    for (const auto& root : find_polynomial_roots(coeffs).roots) {
+        roots.insert(roots.end(), root.multiplicity, root.value);
+    }
+    return roots;
+}
+
+bool numeric_polynomial_roots(
+    const RCP<const Basic>& expr,
+    const RCP<const Symbol>& var,
+    SymEngine::vec_basic& roots,
+    std::vector<int>* multiplicities
+) {
+    if (!polynomial_shape(expr, var, false)) {
+        return false;
+    }
+    const auto expanded = SymEngine::expand(expr);
+    SymEngine::vec_basic terms;
+    if (SymEngine::is_a<SymEngine::Add>(*expanded)) {
+        terms = expanded->get_args();
+    } else {
+        terms.push_back(expanded);
+    }
+    std::vector<double> coeffs;
+    for (const auto& term : terms) {
+        Coeff coeff;
+        int degree = 0;
+        if (!split_monomial(term, var, coeff, degree, false) || coeff->is_complex()) {
+            return false;
+        }
+        if (static_cast<int>(coeffs.size()) <= degree) {
+            coeffs.resize(degree + 1, 0.0);
+        }
+        coeffs[degree] += SymEngine::eval_double(*coeff);
+    }
+    while (!coeffs.empty() && coeffs.back() == 0.0) {
+        coeffs.pop_back();
+    }
+    if (coeffs.size() < 2) {
+        return false;
+    }
+    roots.clear();
+    if (multiplicities != nullptr) {
+        multiplicities->clear();
+    }
+    for (const auto& root : find_polynomial_roots(coeffs).roots) {
+        roots.push_back(to_number(root.value));
+        if (multiplicities != nullptr) {
+            multiplicities->push_back(root.multiplicity);
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,599 @@
+#include "mathllm/quadrature.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+// Kronrod abscissae (descending) and weights for the 15-point rule; the odd
+// entries and the centre are the embedded 7-point Gauss nodes.
+const std::array<double, 8> kKronrodNodes = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+};
+const std::array<double, 8> kKronrodWeights = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+const std::array<double, 4> kGaussWeights = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+const double kHalfPi = 1.57079632679489661923;
+// Beyond |t| = 4 the tanh-sinh weights are below 1e-36.
+const double kTanhSinhTMax = 4.0;
+// Relative distance from an endpoint inside which non-finite values are
+// treated as the endpoint singularity and dropped.
+const double kEndpointDrop = 1e-8;
+
+struct Interval {
+    double a;
+    double b;
+    double value;
+    double error;
+};
+
+bool less_error(const Interval& lhs, const Interval& rhs) {
+    return lhs.error < rhs.error;
+}
+
+std::string not_finite_message(double x) {
+    return "Integrand is not finite at x = " + std::to_string(x);
+}
+
+// Rewrites an integral over a possibly infinite range as one over a finite
+// range; lo and hi receive the new limits.
+BatchFunction map_to_finite(const BatchFunction& f, double a, double b, double& lo, double& hi) {
+    const bool a_inf = std::isinf(a);
+    const bool b_inf = std::isinf(b);
+    if (!a_inf && !b_inf) {
+        lo = a;
+        hi = b;
+        return f;
+    }
+    auto transformed = [f, a, b, a_inf, b_inf](const double* t, std::size_t count, double* out) {
+        std::vector<double> x(count);
+        std::vector<double> jacobian(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (a_inf && b_inf) {
+                // x = t / (1 - t^2) on (-1, 1)
+                const double d = 1.0 - t[i] * t[i];
+                x[i] = t[i] / d;
+                jacobian[i] = (1.0 + t[i] * t[i]) / (d * d);
+            } else if (b_inf) {
+                // x = a + t / (1 - t) on [0, 1)
+                const double d = 1.0 - t[i];
+                x[i] = a + t[i] / d;
+                jacobian[i] = 1.0 / (d * d);
+            } else {
+                // x = b - (1 - t) / t on (0, 1]
+                x[i] = b - (1.0 - t[i]) / t[i];
+                jacobian[i] = 1.0 / (t[i] * t[i]);
+            }
+        }
+        f(x.data(), count, out);
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] *= jacobian[i];
+        }
+    };
+    lo = a_inf && b_inf ? -1.0 : 0.0;
+    hi = 1.0;
+    return transformed;
+}
+
+Interval kronrod_interval(const BatchFunction& f, double a, double b, int& evaluations) {
+    const double center = 0.5 * (a + b);
+    const double half = 0.5 * (b - a);
+    std::array<double, 15> x;
+    std::array<double, 15> fx;
+    for (std::size_t k = 0; k < 7; ++k) {
+        x[k] = center - half * kKronrodNodes[k];
+        x[14 - k] = center + half * kKronrodNodes[k];
+    }
+    x[7] = center;
+    f(x.data(), x.size(), fx.data());
+    evaluations += static_cast<int>(x.size());
+
+    for (std::size_t k = 0; k < fx.size(); ++k) {
+        if (!std::isfinite(fx[k])) {
+            throw NumericError(not_finite_message(x[k]));
+        }
+    }
+    double kronrod = kKronrodWeights[7] * fx[7];
+    double gauss = kGaussWeights[3] * fx[7];
+    for (std::size_t k = 0; k < 7; ++k) {
+        const double pair = fx[k] + fx[14 - k];
+        kronrod += kKronrodWeights[k] * pair;
+        if (k % 2 == 1) {
+            gauss += kGaussWeights[k / 2] * pair;
+        }
+    }
+    return Interval{a, b, kronrod * half, std::abs((kronrod - gauss) * half)};
+}
+
+// Shared handling of empty and reversed ranges.
+bool trivial_range(double& a, double& b, double& sign, QuadratureResult& result) {
+    if (std::isnan(a) || std::isnan(b)) {
+        throw NumericError("Integration limits must not be NaN");
+    }
+    sign = 1.0;
+    if (a > b) {
+        std::swap(a, b);
+        sign = -1.0;
+    }
+    if (a == b) {
+        result = QuadratureResult{0.0, 0.0, 0, true};
+        return true;
+    }
+    return false;
+}
+
+// Genz-Malik generator distances on [-1, 1]^n.
+const double kGenzMalikL2 = 0.35856858280031809;  // sqrt(9/70)
+const double kGenzMalikL4 = 0.94868329805051380;  // sqrt(9/10)
+const double kGenzMalikL5 = 0.68824720161168529;  // sqrt(9/19)
+const std::size_t kMaxCubatureDim = 10;
+// Regions bisected per round; their children are evaluated together.
+const std::size_t kRegionsPerRound = 16;
+const std::size_t kQmcBlock = 256;
+
+struct Region {
+    std::vector<double> center;
+    std::vector<double> half;
+    double value;
+    double error;
+    std::size_t split_axis;
+};
+
+bool less_region_error(const Region& lhs, const Region& rhs) {
+    return lhs.error < rhs.error;
+}
+
+std::size_t genz_malik_points(std::size_t dim) {
+    return (std::size_t{1} << dim) + 2 * dim * dim + 2 * dim + 1;
+}
+
+// Applies the degree 7/5 Genz-Malik pair to region.center/half and fills in
+// value, error and the axis with the largest fourth difference.
+void genz_malik(const BatchFunction& f, Region& region) {
+    const std::size_t n = region.center.size();
+    const std::size_t count = genz_malik_points(n);
+    std::vector<double> points;
+    points.reserve(count * n);
+    auto push = [&](const std::vector<double>& offset) {
+        for (std::size_t i = 0; i < n; ++i) {
+            points.push_back(region.center[i] + region.half[i] * offset[i]);
+        }
+    };
+
+    std::vector<double> offset(n, 0.0);
+    push(offset);
+    for (double lambda : {kGenzMalikL2, kGenzMalikL4}) {
+        for (std::size_t i = 0; i < n; ++i) {
+            offset[i] = lambda;
+            push(offset);
+            offset[i] = -lambda;
+            push(offset);
+            offset[i] = 0.0;
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            for (double si : {1.0, -1.0}) {
+                for (double sj : {1.0, -1.0}) {
+                    offset[i] = si * kGenzMalikL4;
+                    offset[j] = sj * kGenzMalikL4;
+                    push(offset);
+                }
+            }
+            offset[i] = offset[j] = 0.0;
+        }
+    }
+    for (std::size_t mask = 0; mask < (std::size_t{1} << n); ++mask) {
+        for (std::size_t i = 0; i < n; ++i) {
+            offset[i] = (mask >> i) & 1 ? kGenzMalikL5 : -kGenzMalikL5;
+        }
+        push(offset);
+    }
+
+    std::vector<double> fx(count);
+    f(points.data(), count, fx.data());
+    for (std::size_t k = 0; k < count; ++k) {
+        if (!std::isfinite(fx[k])) {
+            throw NumericError("Integrand is not finite at a cubature node");
+        }
+    }
+
+    const double dn = static_cast<double>(n);
+    const double center = fx[0];
+    double sum2 = 0.0;
+    double sum3 = 0.0;
+    double worst_difference = -1.0;
+    region.split_axis = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double pair2 = fx[1 + 2 * i] + fx[2 + 2 * i];
+        const double pair3 = fx[1 + 2 * n + 2 * i] + fx[2 + 2 * n + 2 * i];
+        sum2 += pair2;
+        sum3 += pair3;
+        const double difference = std::abs(pair2 - 2.0 * center - (pair3 - 2.0 * center) / 7.0);
+        if (difference > worst_difference
+            || (difference == worst_difference && region.half[i] > region.half[region.split_axis])) {
+            worst_difference = difference;
+            region.split_axis = i;
+        }
+    }
+    const std::size_t corner_start = 1 + 4 * n;
+    const std::size_t corner_end = corner_start + 2 * n * (n - 1);
+    double sum4 = 0.0;
+    for (std::size_t k = corner_start; k < corner_end; ++k) {
+        sum4 += fx[k];
+    }
+    double sum5 = 0.0;
+    for (std::size_t k = corner_end; k < count; ++k) {
+        sum5 += fx[k];
+    }
+
+    double volume = 1.0;
+    for (double h : region.half) {
+        volume *= 2.0 * h;
+    }
+    const double degree7 = (12824.0 - 9120.0 * dn + 400.0 * dn * dn) / 19683.0 * center
+        + 980.0 / 6561.0 * sum2
+        + (1820.0 - 400.0 * dn) / 19683.0 * sum3
+        + 200.0 / 19683.0 * sum4
+        + 6859.0 / 19683.0 / std::ldexp(1.0, static_cast<int>(n)) * sum5;
+    const double degree5 = (729.0 - 950.0 * dn + 50.0 * dn * dn) / 729.0 * center
+        + 245.0 / 486.0 * sum2
+        + (265.0 - 100.0 * dn) / 1458.0 * sum3
+        + 25.0 / 729.0 * sum4;
+    region.value = volume * degree7;
+    region.error = volume * std::abs(degree7 - degree5);
+}
+
+void check_box(const std::vector<double>& lower, const std::vector<double>& upper) {
+    if (lower.empty() || lower.size() != upper.size()) {
+        throw NumericError("Integration bounds must be non-empty and of equal dimension");
+    }
+    for (std::size_t i = 0; i < lower.size(); ++i) {
+        if (!std::isfinite(lower[i]) || !std::isfinite(upper[i])) {
+            throw NumericError("Multi-dimensional integration bounds must be finite");
+        }
+    }
+}
+
+// Golden ratio generalization: the positive root of x^(d+1) = x + 1.
+double kronecker_base(std::size_t dim) {
+    double phi = 2.0;
+    for (int i = 0; i < 64; ++i) {
+        phi = std::pow(1.0 + phi, 1.0 / (static_cast<double>(dim) + 1.0));
+    }
+    return phi;
+}
+
+}
+
+QuadratureResult gauss_kronrod(
+    const BatchFunction& f,
+    double a,
+    double b,
+    double abs_tol,
+    double rel_tol,
+    int max_intervals
+) {
+    if (max_intervals <= 0) {
+        throw NumericError("max_intervals must be positive");
+    }
+    double sign;
+    QuadratureResult result;
+    if (trivial_range(a, b, sign, result)) {
+        return result;
+    }
+    double lo, hi;
+    const BatchFunction g = map_to_finite(f, a, b, lo, hi);
+
+    int evaluations = 0;
+    std::vector<Interval> heap;
+    heap.push_back(kronrod_interval(g, lo, hi, evaluations));
+    double value = heap.front().value;
+    double error = heap.front().error;
+
+    while (error > std::max(abs_tol, rel_tol * std::abs(value))
+           && static_cast<int>(heap.size()) < max_intervals) {
+        std::pop_heap(heap.begin(), heap.end(), less_error);
+        const Interval worst = heap.back();
+        const double mid = 0.5 * (worst.a + worst.b);
+        if (mid <= worst.a || mid >= worst.b) {
+            std::push_heap(heap.begin(), heap.end(), less_error);
+            break;
+        }
+        heap.pop_back();
+        const Interval left = kronrod_interval(g, worst.a, mid, evaluations);
+        const Interval right = kronrod_interval(g, mid, worst.b, evaluations);
+        heap.push_back(left);
+        std::push_heap(heap.begin(), heap.end(), less_error);
+        heap.push_back(right);
+        std::push_heap(heap.begin(), heap.end(), less_error);
+
+        value = 0.0;
+        error = 0.0;
+        for (const auto& interval : heap) {
+            value += interval.value;
+            error += interval.error;
+        }
+    }
+
+    const bool converged = error <= std::max(abs_tol, rel_tol * std::abs(value));
+    return QuadratureResult{sign * value, error, evaluations, converged};
+}
+
+QuadratureResult tanh_sinh(
+    const BatchFunction& f,
+    double a,
+    double b,
+    double abs_tol,
+    double rel_tol,
+    int max_levels
+) {
+    if (max_levels <= 0) {
+        throw NumericError("max_levels must be positive");
+    }
+    double sign;
+    QuadratureResult result;
+    if (trivial_range(a, b, sign, result)) {
+        return result;
+    }
+    double lo, hi;
+    const BatchFunction g = map_to_finite(f, a, b, lo, hi);
+    const double center = 0.5 * (lo + hi);
+    const double half = 0.5 * (hi - lo);
+
+    int evaluations = 0;
+    // Weighted sum over the nodes t = k * h for the given k.
+    auto level_sum = [&](const std::vector<double>& nodes) {
+        std::vector<double> x(nodes.size());
+        std::vector<double> weights(nodes.size());
+        std::vector<double> near_endpoint(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            const double t = nodes[i];
+            const double u = kHalfPi * std::sinh(t);
+            const double cosh_u = std::cosh(u);
+            // 1 - tanh(|u|), computed without cancellation.
+            const double delta = 2.0 / (1.0 + std::exp(2.0 * std::abs(u)));
+            x[i] = t < 0.0 ? lo + half * delta : (t > 0.0 ? hi - half * delta : center);
+            weights[i] = half * kHalfPi * std::cosh(t) / (cosh_u * cosh_u);
+            near_endpoint[i] = delta;
+        }
+        std::vector<double> fx(nodes.size());
+        g(x.data(), x.size(), fx.data());
+        evaluations += static_cast<int>(nodes.size());
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (!std::isfinite(fx[i])) {
+                if (near_endpoint[i] < kEndpointDrop) {
+                    continue;
+                }
+                throw NumericError(not_finite_message(x[i]));
+            }
+            sum += weights[i] * fx[i];
+        }
+        return sum;
+    };
+
+    double h = 1.0;
+    std::vector<double> nodes;
+    for (int k = -static_cast<int>(kTanhSinhTMax); k <= static_cast<int>(kTanhSinhTMax); ++k) {
+        nodes.push_back(k);
+    }
+    double value = h * level_sum(nodes);
+    double error = std::numeric_limits<double>::infinity();
+    bool converged = false;
+
+    for (int level = 1; level <= max_levels; ++level) {
+        h *= 0.5;
+        nodes.clear();
+        for (double t = h; t <= kTanhSinhTMax; t += 2.0 * h) {
+            nodes.push_back(t);
+            nodes.push_back(-t);
+        }
+        const double refined = 0.5 * value + h * level_sum(nodes);
+        error = std::abs(refined - value);
+        value = refined;
+        if (level >= 2 && error <= std::max(abs_tol, rel_tol * std::abs(value))) {
+            converged = true;
+            break;
+        }
+    }
+    return QuadratureResult{sign * value, error, evaluations, converged};
+}
+
+QuadratureResult adaptive_cubature(
+    const BatchFunction& f,
+    const std::vector<double>& lower,
+    const std::vector<double>& upper,
+    double abs_tol,
+    double rel_tol,
+    int max_evaluations
+) {
+    check_box(lower, upper);
+    const std::size_t dim = lower.size();
+    if (dim < 2 || dim > kMaxCubatureDim) {
+        throw NumericError("Adaptive cubature supports 2 to 10 dimensions");
+    }
+    Region root;
+    double sign = 1.0;
+    for (std::size_t i = 0; i < dim; ++i) {
+        root.center.push_back(0.5 * (lower[i] + upper[i]));
+        root.half.push_back(0.5 * std::abs(upper[i] - lower[i]));
+        if (upper[i] < lower[i]) {
+            sign = -sign;
+        }
+        if (root.half.back() == 0.0) {
+            return QuadratureResult{0.0, 0.0, 0, true};
+        }
+    }
+
+    const int points_per_region = static_cast<int>(genz_malik_points(dim));
+    int evaluations = points_per_region;
+    genz_malik(f, root);
+    std::vector<Region> heap{root};
+    double value = root.value;
+    double error = root.error;
+
+    while (error > std::max(abs_tol, rel_tol * std::abs(value))) {
+        std::vector<Region> children;
+        while (!heap.empty() && children.size() < 2 * kRegionsPerRound
+               && evaluations + static_cast<int>(children.size() + 2) * points_per_region <= max_evaluations) {
+            std::pop_heap(heap.begin(), heap.end(), less_region_error);
+            Region parent = heap.back();
+            heap.pop_back();
+            const std::size_t axis = parent.split_axis;
+            parent.half[axis] *= 0.5;
+            Region left = parent;
+            Region right = parent;
+            left.center[axis] -= parent.half[axis];
+            right.center[axis] += parent.half[axis];
+            children.push_back(std::move(left));
+            children.push_back(std::move(right));
+        }
+        if (children.empty()) {
+            break;
+        }
+
+        const long child_count = static_cast<long>(children.size());
+        bool failed = false;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (long k = 0; k < child_count; ++k) {
+            try {
+                genz_malik(f, children[k]);
+            } catch (const NumericError&) {
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+                failed = true;
+            }
+        }
+        if (failed) {
+            throw NumericError("Integrand is not finite at a cubature node");
+        }
+        evaluations += static_cast<int>(children.size()) * points_per_region;
+        for (auto& child : children) {
+            heap.push_back(std::move(child));
+            std::push_heap(heap.begin(), heap.end(), less_region_error);
+        }
+
+        value = 0.0;
+        error = 0.0;
+        for (const auto& region : heap) {
+            value += region.value;
+            error += region.error;
+        }
+    }
+
+    const bool converged = error <= std::max(abs_tol, rel_tol * std::abs(value));
+    return QuadratureResult{sign * value, error, evaluations, converged};
+}
+
+QuadratureResult qmc_integrate(
+    const BatchFunction& f,
+    const std::vector<double>& lower,
+    const std::vector<double>& upper,
+    double abs_tol,
+    double rel_tol,
+    int samples,
+    int replicas,
+    unsigned int seed
+) {
+    check_box(lower, upper);
+    if (samples <= 0 || replicas < 2) {
+        throw NumericError("QMC needs positive samples and at least two replicas");
+    }
+    const std::size_t dim = lower.size();
+    double volume = 1.0;
+    for (std::size_t i = 0; i < dim; ++i) {
+        volume *= upper[i] - lower[i];
+    }
+
+    const double phi = kronecker_base(dim);
+    std::vector<double> alpha(dim);
+    for (std::size_t i = 0; i < dim; ++i) {
+        alpha[i] = std::fmod(std::pow(1.0 / phi, static_cast<double>(i + 1)), 1.0);
+    }
+    // Draw every shift up front so the result is independent of scheduling.
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> shifts(static_cast<std::size_t>(replicas) * dim);
+    for (double& shift : shifts) {
+        shift = unit(rng);
+    }
+
+    std::vector<double> means(replicas, 0.0);
+    bool failed = false;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (int r = 0; r < replicas; ++r) {
+        const double* shift = &shifts[static_cast<std::size_t>(r) * dim];
+        std::vector<double> points(kQmcBlock * dim);
+        std::vector<double> fx(kQmcBlock);
+        double sum = 0.0;
+        for (int start = 0; start < samples; start += static_cast<int>(kQmcBlock)) {
+            const std::size_t n = std::min(kQmcBlock, static_cast<std::size_t>(samples - start));
+            for (std::size_t j = 0; j < n; ++j) {
+                const double k = static_cast<double>(start + j + 1);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    double u = shift[i] + k * alpha[i];
+                    u -= std::floor(u);
+                    // Baker's transform: periodizes the integrand, which
+                    // lattice rules need for their higher-order convergence.
+                    u = 1.0 - std::abs(2.0 * u - 1.0);
+                    points[j * dim + i] = lower[i] + (upper[i] - lower[i]) * u;
+                }
+            }
+            f(points.data(), n, fx.data());
+            for (std::size_t j = 0; j < n; ++j) {
+                sum += fx[j];
+            }
+        }
+        if (!std::isfinite(sum)) {
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+            failed = true;
+        }
+        means[r] = volume * sum / samples;
+    }
+    if (failed) {
+        throw NumericError("Integrand is not finite at a QMC sample");
+    }
+
+    double value = 0.0;
+    for (double mean : means) {
+        value += mean;
+    }
+    value /= replicas;
+    double variance = 0.0;
+    for (double mean : means) {
+        variance += (mean - value) * (mean - value);
+    }
+    variance /= replicas - 1;
+    const double error = std::sqrt(variance / replicas);
+    const bool converged = error <= std::max(abs_tol, rel_tol * std::abs(value));
+    return QuadratureResult{value, error, samples * replicas, converged};
+}
+
+}
@@ -0,0 +1,623 @@
+#include "mathllm/rational.h"
+
+#include <symengine/add.h>
+#include <symengine/constants.h>
+#include <symengine/functions.h>
+#include <symengine/infinity.h>
+#include <symengine/integer.h>
+#include <symengine/mul.h>
+#include <symengine/nan.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::integer_class;
+
+// Evaluation points tried before the heuristic gcd gives up, and the bound
+// on deg * bits(xi) past which the integers get too large to be worth it.
+const int kGcdAttempts = 6;
+const std::size_t kGcdMaxBits = 16384;
+// Largest exponent of a generator and of an integer power. Larger ones are
+// rejected before they are narrowed, and products never add up past it, so
+// the int exponents cannot overflow.
+const long kMaxExponent = 1L << 16;
+
+using Exponents = std::vector<int>;
+// Sparse polynomial with integer coefficients over the generators, terms in
+// lexicographically descending order: begin() is the leading term.
+using Poly = std::map<Exponents, integer_class, std::greater<Exponents>>;
+
+struct Fraction {
+    Poly num;
+    Poly den;
+};
+
+void check_exponent(long exponent) {
+    if (exponent > kMaxExponent || exponent < -kMaxExponent) {
+        throw SymbolicError("Exponent too large for the rational normal form");
+    }
+}
+
+// value as a long, after checking it against kMaxExponent.
+long bounded_exponent(const integer_class& value) {
+    integer_class magnitude;
+    SymEngine::mp_abs(magnitude, value);
+    if (magnitude > integer_class(kMaxExponent)) {
+        throw SymbolicError("Exponent too large for the rational normal form");
+    }
+    return SymEngine::mp_get_si(value);
+}
+
+RCP<const Basic> parse_expression(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+Poly constant(const integer_class& value, std::size_t n) {
+    Poly result;
+    if (SymEngine::mp_sign(value) != 0) {
+        result.emplace(Exponents(n, 0), value);
+    }
+    return result;
+}
+
+void add_term(Poly& poly, const Exponents& exps, const integer_class& coef) {
+    if (SymEngine::mp_sign(coef) == 0) {
+        return;
+    }
+    auto it = poly.find(exps);
+    if (it == poly.end()) {
+        poly.emplace(exps, coef);
+        return;
+    }
+    it->second += coef;
+    if (SymEngine::mp_sign(it->second) == 0) {
+        poly.erase(it);
+    }
+}
+
+Poly add(const Poly& a, const Poly& b) {
+    Poly result = a;
+    for (const auto& term : b) {
+        add_term(result, term.first, term.second);
+    }
+    return result;
+}
+
+Poly scale(const Poly& a, const integer_class& factor) {
+    Poly result;
+    if (SymEngine::mp_sign(factor) == 0) {
+        return result;
+    }
+    for (const auto& term : a) {
+        result.emplace(term.first, term.second * factor);
+    }
+    return result;
+}
+
+Poly sub(const Poly& a, const Poly& b) {
+    return add(a, scale(b, -1));
+}
+
+Poly mul(const Poly& a, const Poly& b) {
+    Poly result;
+    for (const auto& x : a) {
+        for (const auto& y : b) {
+            Exponents exps = x.first;
+            for (std::size_t i = 0; i < exps.size(); ++i) {
+                exps[i] += y.first[i];
+                check_exponent(exps[i]);
+            }
+            add_term(result, exps, x.second * y.second);
+        }
+    }
+    return result;
+}
+
+Poly power(Poly base, unsigned long exponent, std::size_t n) {
+    Poly result = constant(1, n);
+    while (exponent > 0) {
+        if (exponent & 1UL) {
+            result = mul(result, base);
+        }
+        exponent >>= 1;
+        if (exponent > 0) {
+            base = mul(base, base);
+        }
+    }
+    return result;
+}
+
+bool is_constant(const Poly& a) {
+    return a.size() == 1 && std::all_of(a.begin()->first.begin(), a.begin()->first.end(), [](int e) { return e == 0; });
+}
+
+integer_class content(const Poly& a) {
+    integer_class result(0);
+    for (const auto& term : a) {
+        SymEngine::mp_gcd(result, result, term.second);
+    }
+    return result;
+}
+
+integer_class max_norm(const Poly& a) {
+    integer_class result(0);
+    integer_class magnitude;
+    for (const auto& term : a) {
+        SymEngine::mp_abs(magnitude, term.second);
+        result = std::max(result, magnitude);
+    }
+    return result;
+}
+
+int degree(const Poly& a, std::size_t var) {
+    int result = 0;
+    for (const auto& term : a) {
+        result = std::max(result, term.first[var]);
+    }
+    return result;
+}
+
+// a / b when b divides a exactly; false otherwise. Leading terms are
+// divided off one at a time, which terminates with a zero remainder
+// exactly when the division is exact.
+bool divide_exact(const Poly& a, const Poly& b, Poly& quotient) {
+    quotient.clear();
+    if (b.empty()) {
+        return false;
+    }
+    for (std::size_t var = 0; var < b.begin()->first.size(); ++var) {
+        if (degree(b, var) > degree(a, var)) {
+            return a.empty();
+        }
+    }
+    const auto& lead = *b.begin();
+    Poly remainder = a;
+    integer_class rest;
+    while (!remainder.empty()) {
+        const auto& top = *remainder.begin();
+        Exponents exps = top.first;
+        for (std::size_t i = 0; i < exps.size(); ++i) {
+            exps[i] -= lead.first[i];
+            if (exps[i] < 0) {
+                return false;
+            }
+        }
+        SymEngine::mp_fdiv_r(rest, top.second, lead.second);
+        if (SymEngine::mp_sign(rest) != 0) {
+            return false;
+        }
+        Poly term;
+        term.emplace(exps, top.second / lead.second);
+        add_term(quotient, exps, term.begin()->second);
+        remainder = sub(remainder, mul(term, b));
+    }
+    return true;
+}
+
+// a with generator var set to value.
+Poly evaluate(const Poly& a, std::size_t var, const integer_class& value) {
+    std::vector<integer_class> powers{integer_class(1)};
+    Poly result;
+    for (const auto& term : a) {
+        const int e = term.first[var];
+        while (static_cast<int>(powers.size()) <= e) {
+            powers.push_back(powers.back() * value);
+        }
+        Exponents exps = term.first;
+        exps[var] = 0;
+        add_term(result, exps, term.second * powers[e]);
+    }
+    return result;
+}
+
+// Inverse of evaluate() at var = xi for polynomials whose coefficients are
+// below xi/2 in magnitude: the coefficients of var^0, var^1, ... are the
+// symmetric residues of the digits of a in base xi.
+Poly interpolate(Poly a, std::size_t var, const integer_class& xi) {
+    Poly result;
+    const integer_class half = xi / integer_class(2);
+    integer_class digit;
+    for (int e = 0; !a.empty(); ++e) {
+        Poly digits;
+        for (const auto& term : a) {
+            SymEngine::mp_fdiv_r(digit, term.second, xi);
+            if (digit > half) {
+                digit -= xi;
+            }
+            add_term(digits, term.first, digit);
+        }
+        for (const auto& term : digits) {
+            Exponents exps = term.first;
+            exps[var] = e;
+            add_term(result, exps, term.second);
+        }
+        a = sub(a, digits);
+        for (auto& term : a) {
+            term.second /= xi;
+        }
+    }
+    return result;
+}
+
+// Divides out the content and makes the leading coefficient positive.
+Poly primitive(const Poly& a) {
+    if (a.empty()) {
+        return a;
+    }
+    integer_class c = content(a);
+    if (SymEngine::mp_sign(a.begin()->second) < 0) {
+        c = -c;
+    }
+    Poly result;
+    for (const auto& term : a) {
+        result.emplace(term.first, term.second / c);
+    }
+    return result;
+}
+
+// Heuristic gcd (GCDHEU, Char, Geddes and Gonnet): evaluate the first
+// generator at an integer xi larger than twice any coefficient, take the
+// gcd of the images recursively in the remaining generators, interpolate
+// it back and keep it when it divides both inputs. Images of a wrong xi
+// give a candidate that fails the division check, so a returned gcd is
+// always correct; false means every attempt failed.
+bool heuristic_gcd(const Poly& f, const Poly& g, std::size_t n, Poly& result) {
+    if (f.empty() || g.empty()) {
+        const Poly& other = f.empty() ? g : f;
+        result = other.empty() ? other : scale(primitive(other), content(other));
+        return true;
+    }
+    integer_class gamma;
+    SymEngine::mp_gcd(gamma, content(f), content(g));
+    if (is_constant(f) || is_constant(g)) {
+        result = constant(gamma, n);
+        return true;
+    }
+    std::size_t var = 0;
+    while (var < n && degree(f, var) == 0 && degree(g, var) == 0) {
+        ++var;
+    }
+    if (var == n) {
+        result = constant(gamma, n);
+        return true;
+    }
+    const Poly pf = primitive(f);
+    const Poly pg = primitive(g);
+    const int max_degree = std::max(degree(pf, var), degree(pg, var));
+    integer_class xi = integer_class(2) * std::min(max_norm(pf), max_norm(pg)) + integer_class(29);
+    for (int attempt = 0; attempt < kGcdAttempts; ++attempt) {
+        if (max_degree * SymEngine::mp_sizeinbase(xi, 2) > kGcdMaxBits) {
+            return false;
+        }
+        Poly image;
+        if (heuristic_gcd(evaluate(pf, var, xi), evaluate(pg, var, xi), n, image)) {
+            const Poly candidate = primitive(interpolate(image, var, xi));
+            Poly quotient;
+            if (!candidate.empty() && divide_exact(pf, candidate, quotient) && divide_exact(pg, candidate, quotient)) {
+                result = scale(candidate, gamma);
+                return true;
+            }
+        }
+        xi = xi * integer_class(73794) / integer_class(27011);
+    }
+    return false;
+}
+
+Fraction divide(const Fraction& a, const Fraction& b) {
+    if (b.num.empty()) {
+        throw SymbolicError("Division by zero");
+    }
+    return Fraction{mul(a.num, b.den), mul(a.den, b.num)};
+}
+
+// Rewrites an expression as a fraction of polynomials over generators.
+// Generators are collected in a first pass and ordered by SymEngine's
+// comparison, so equal inputs give equal polynomials whatever their
+// written order. A base b seen under exponents p/q is replaced by one root
+// b^(1/Q), Q the lcm of the q, so that x and x^(1/2) become s^2 and s.
+class Converter {
+public:
+    explicit Converter(const RCP<const Basic>& expr) {
+        collect(expr);
+        for (auto& entry : atoms_) {
+            Atom& atom = entry.second;
+            const long order = roots_.at(atom.base);
+            atom.generator = order == 1
+                ? atom.base
+                : SymEngine::pow(atom.base, SymEngine::Rational::from_two_ints(1, order));
+            atom.exponent *= order / atom.order;
+            check_exponent(atom.exponent);
+            generators_.insert(atom.generator);
+        }
+        for (const auto& gen : generators_) {
+            const std::size_t index = index_.size();
+            index_.emplace(gen, index);
+        }
+    }
+
+    Fraction convert(const RCP<const Basic>& expr) {
+        const std::size_t n = index_.size();
+        if (SymEngine::is_a<SymEngine::Integer>(*expr)) {
+            const auto& value = SymEngine::down_cast<const SymEngine::Integer&>(*expr).as_integer_class();
+            return Fraction{constant(value, n), constant(1, n)};
+        }
+        if (SymEngine::is_a<SymEngine::Rational>(*expr)) {
+            const auto& value = SymEngine::down_cast<const SymEngine::Rational&>(*expr).as_rational_class();
+            return Fraction{constant(SymEngine::get_num(value), n), constant(SymEngine::get_den(value), n)};
+        }
+        if (SymEngine::is_a<SymEngine::Add>(*expr)) {
+            Fraction sum{Poly(), constant(1, n)};
+            for (const auto& arg : expr->get_args()) {
+                const Fraction term = convert(arg);
+                // Over the least common denominator when the gcd is found,
+                // which keeps the final reduction small.
+                Poly common;
+                if (!heuristic_gcd(sum.den, term.den, n, common)) {
+                    common = constant(1, n);
+                }
+                Poly sum_cofactor;
+                Poly term_cofactor;
+                divide_exact(sum.den, common, sum_cofactor);
+                divide_exact(term.den, common, term_cofactor);
+                sum.num = add(mul(sum.num, term_cofactor), mul(term.num, sum_cofactor));
+                sum.den = mul(sum.den, term_cofactor);
+            }
+            return sum;
+        }
+        if (SymEngine::is_a<SymEngine::Mul>(*expr)) {
+            Fraction product{constant(1, n), constant(1, n)};
+            for (const auto& arg : expr->get_args()) {
+                const Fraction factor = convert(arg);
+                product.num = mul(product.num, factor.num);
+                product.den = mul(product.den, factor.den);
+            }
+            return product;
+        }
+        if (is_integer_power(*expr)) {
+            const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*expr);
+            const auto& exponent = SymEngine::down_cast<const SymEngine::Integer&>(*pow.get_exp());
+            Fraction base = convert(pow.get_base());
+            if (exponent.is_negative()) {
+                base = divide(Fraction{constant(1, n), constant(1, n)}, base);
+            }
+            const auto e = static_cast<unsigned long>(std::abs(bounded_exponent(exponent.as_integer_class())));
+            return Fraction{power(base.num, e, n), power(base.den, e, n)};
+        }
+        const auto& atom = atoms_.at(expr);
+        Exponents exps(n, 0);
+        exps[index_.at(atom.generator)] = static_cast<int>(std::abs(atom.exponent));
+        const Poly monomial{{exps, integer_class(1)}};
+        if (atom.exponent < 0) {
+            return Fraction{constant(1, n), monomial};
+        }
+        return Fraction{monomial, constant(1, n)};
+    }
+
+    std::vector<Expression> generators() const {
+        std::vector<Expression> result;
+        for (const auto& gen : generators_) {
+            result.emplace_back(gen);
+        }
+        return result;
+    }
+
+    std::size_t dimension() const { return index_.size(); }
+
+    bool only_symbols() const {
+        return std::all_of(generators_.begin(), generators_.end(), [](const RCP<const Basic>& gen) {
+            return SymEngine::is_a<SymEngine::Symbol>(*gen);
+        });
+    }
+
+    RCP<const Basic> to_basic(const Poly& poly) const {
+        SymEngine::vec_basic gens(generators_.begin(), generators_.end());
+        SymEngine::vec_basic terms;
+        for (const auto& term : poly) {
+            SymEngine::vec_basic factors{SymEngine::integer(term.second)};
+            for (std::size_t i = 0; i < gens.size(); ++i) {
+                if (term.first[i] != 0) {
+                    factors.push_back(SymEngine::pow(gens[i], SymEngine::integer(term.first[i])));
+                }
+            }
+            terms.push_back(SymEngine::mul(factors));
+        }
+        return SymEngine::add(terms);
+    }
+
+private:
+    static bool is_integer_power(const Basic& expr) {
+        return SymEngine::is_a<SymEngine::Pow>(expr)
+            && SymEngine::is_a<SymEngine::Integer>(*SymEngine::down_cast<const SymEngine::Pow&>(expr).get_exp());
+    }
+
+    void collect(const RCP<const Basic>& expr) {
+        if (SymEngine::is_a<SymEngine::Integer>(*expr) || SymEngine::is_a<SymEngine::Rational>(*expr)) {
+            return;
+        }
+        if (SymEngine::is_a<SymEngine::Add>(*expr) || SymEngine::is_a<SymEngine::Mul>(*expr)) {
+            for (const auto& arg : expr->get_args()) {
+                collect(arg);
+            }
+            return;
+        }
+        if (is_integer_power(*expr)) {
+            collect(SymEngine::down_cast<const SymEngine::Pow&>(*expr).get_base());
+            return;
+        }
+        if (atoms_.count(expr) != 0) {
+            return;
+        }
+        if (SymEngine::is_a_sub<SymEngine::Infty>(*expr) || SymEngine::is_a<SymEngine::NaN>(*expr)) {
+            throw SymbolicError("Not a rational function: " + expr->__str__());
+        }
+        if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+            const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*expr);
+            if (SymEngine::is_a<SymEngine::Rational>(*pow.get_exp())) {
+                const auto& exponent = SymEngine::down_cast<const SymEngine::Rational&>(*pow.get_exp()).as_rational_class();
+                register_atom(
+                    expr,
+                    normal_form(pow.get_base()),
+                    bounded_exponent(SymEngine::get_num(exponent)),
+                    bounded_exponent(SymEngine::get_den(exponent))
+                );
+                return;
+            }
+        }
+        register_atom(expr, normal_leaf(expr), 1, 1);
+    }
+
+    void register_atom(const RCP<const Basic>& expr, const RCP<const Basic>& base, long exponent, long order) {
+        atoms_.emplace(expr, Atom{base, exponent, order, RCP<const Basic>()});
+        auto it = roots_.emplace(base, order).first;
+        it->second = std::lcm(it->second, order);
+        check_exponent(it->second);
+    }
+
+    // expr with the arguments of functions and powers put in normal form.
+    static RCP<const Basic> normal_leaf(const RCP<const Basic>& expr) {
+        const auto args = expr->get_args();
+        if (args.empty()) {
+            return expr;
+        }
+        SymEngine::vec_basic normal_args;
+        for (const auto& arg : args) {
+            normal_args.push_back(normal_form(arg));
+        }
+        if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+            return SymEngine::pow(normal_args[0], normal_args[1]);
+        }
+        if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*expr)) {
+            return SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).create(normal_args[0]);
+        }
+        if (SymEngine::is_a_sub<SymEngine::TwoArgFunction>(*expr)) {
+            return SymEngine::down_cast<const SymEngine::TwoArgFunction&>(*expr).create(normal_args[0], normal_args[1]);
+        }
+        if (SymEngine::is_a_sub<SymEngine::MultiArgFunction>(*expr)) {
+            return SymEngine::down_cast<const SymEngine::MultiArgFunction&>(*expr).create(normal_args);
+        }
+        return expr;
+    }
+
+    static RCP<const Basic> normal_form(const RCP<const Basic>& expr);
+
+    SymEngine::set_basic generators_;
+    std::unordered_map<RCP<const Basic>, std::size_t, SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq> index_;
+    // A non-rational subterm base^(exponent/order), and after collection
+    // the power of its generator it stands for.
+    struct Atom {
+        RCP<const Basic> base;
+        long exponent;
+        long order;
+        RCP<const Basic> generator;
+    };
+
+    std::unordered_map<RCP<const Basic>, Atom, SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq> atoms_;
+    // Lcm of the orders each base is seen under.
+    std::unordered_map<RCP<const Basic>, long, SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq> roots_;
+};
+
+// Cancels the gcd and makes the leading coefficient of the denominator
+// positive. Returns false when the gcd could not be found.
+bool reduce(Fraction& fraction, std::size_t n) {
+    if (fraction.den.empty()) {
+        throw SymbolicError("Division by zero");
+    }
+    if (fraction.num.empty()) {
+        fraction.den = constant(1, n);
+        return true;
+    }
+    Poly common;
+    const bool found = heuristic_gcd(fraction.num, fraction.den, n, common);
+    if (found && !is_constant(common)) {
+        divide_exact(Poly(fraction.num), common, fraction.num);
+        divide_exact(Poly(fraction.den), common, fraction.den);
+    } else if (found) {
+        const integer_class& c = common.begin()->second;
+        for (auto& term : fraction.num) {
+            term.second /= c;
+        }
+        for (auto& term : fraction.den) {
+            term.second /= c;
+        }
+    }
+    if (SymEngine::mp_sign(fraction.den.begin()->second) < 0) {
+        fraction.num = scale(fraction.num, -1);
+        fraction.den = scale(fraction.den, -1);
+    }
+    return found;
+}
+
+RCP<const Basic> Converter::normal_form(const RCP<const Basic>& expr) {
+    Converter converter(expr);
+    Fraction fraction = converter.convert(expr);
+    reduce(fraction, converter.dimension());
+    return SymEngine::div(converter.to_basic(fraction.num), converter.to_basic(fraction.den));
+}
+
+}
+
+RationalForm rational_form(const RCP<const Basic>& expr) {
+    try {
+        Converter converter(expr);
+        Fraction fraction = converter.convert(expr);
+        const bool reduced = reduce(fraction, converter.dimension());
+        return RationalForm{
+            Expression(converter.to_basic(fraction.num)),
+            Expression(converter.to_basic(fraction.den)),
+            converter.generators(),
+            reduced,
+        };
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+RationalForm rational_form(const std::string& expr) {
+    return rational_form(parse_expression(expr));
+}
+
+std::string cancel(const std::string& expr) {
+    const auto form = rational_form(expr);
+    return SymEngine::div(form.numerator.get(), form.denominator.get())->__str__();
+}
+
+SymEngine::tribool rational_equal(const RCP<const Basic>& lhs, const RCP<const Basic>& rhs) {
+    try {
+        const auto difference = SymEngine::sub(lhs, rhs);
+        Converter converter(difference);
+        // Cancelling cannot make a nonzero numerator vanish, so the
+        // difference is compared unreduced.
+        const Fraction fraction = converter.convert(difference);
+        if (fraction.num.empty()) {
+            return SymEngine::tribool::tritrue;
+        }
+        return converter.only_symbols() ? SymEngine::tribool::trifalse : SymEngine::tribool::indeterminate;
+    } catch (const std::exception&) {
+        return SymEngine::tribool::indeterminate;
+    }
+}
+
+}
@@ -0,0 +1,302 @@
+#include "mathllm/roots.h"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+const double kEpsilon = std::numeric_limits<double>::epsilon();
+const double kTwoPi = 6.28318530717958647692;
+// Angular offset of the initial guesses, keeping them off the real axis so
+// conjugate pairs can separate.
+const double kInitialAngle = 0.4;
+// Newton steps tried on each root once the iteration has stopped.
+const int kPolishSteps = 3;
+// Inclusion radii are capped at this fraction of (1 + |z|); a vanishing
+// derivative would otherwise merge unrelated roots into one cluster.
+const double kMaxClusterRadius = 1e-2;
+
+struct Evaluation {
+    Complex value;
+    Complex derivative;
+    // Bound on the rounding error in value.
+    double rounding;
+};
+
+Evaluation horner(const std::vector<double>& c, Complex z) {
+    const std::size_t n = c.size() - 1;
+    Complex value = c[n];
+    Complex derivative = 0.0;
+    double magnitude = std::abs(c[n]);
+    const double r = std::abs(z);
+    for (std::size_t k = n; k-- > 0;) {
+        derivative = derivative * z + value;
+        value = value * z + c[k];
+        magnitude = magnitude * r + std::abs(c[k]);
+    }
+    return {value, derivative, 4.0 * static_cast<double>(n + 1) * kEpsilon * magnitude};
+}
+
+std::vector<double> derivative_coeffs(const std::vector<double>& c, int order) {
+    std::vector<double> out(c.begin() + order, c.end());
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        for (int j = 1; j <= order; ++j) {
+            out[k] *= static_cast<double>(k + j);
+        }
+    }
+    return out;
+}
+
+bool finite(Complex z) {
+    return std::isfinite(z.real()) && std::isfinite(z.imag());
+}
+
+// Aberth-Ehrlich iteration in Gauss-Seidel form: each root moves by the
+// Newton correction deflated by its distance to all the others. A root is
+// frozen once |p(z)| is below its rounding bound or the step is below tol.
+bool aberth(const std::vector<double>& c, double tol, int max_iterations, std::vector<Complex>& z, int& iterations) {
+    const std::size_t n = c.size() - 1;
+    double radius = std::pow(std::abs(c[0] / c[n]), 1.0 / static_cast<double>(n));
+    if (!std::isfinite(radius) || radius == 0.0) {
+        radius = 1.0;
+    }
+    z.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        z[k] = std::polar(radius, kTwoPi * static_cast<double>(k) / static_cast<double>(n) + kInitialAngle);
+    }
+
+    std::vector<bool> done(n, false);
+    for (iterations = 1; iterations <= max_iterations; ++iterations) {
+        std::size_t active = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            const auto eval = horner(c, z[i]);
+            if (std::abs(eval.value) <= eval.rounding) {
+                done[i] = true;
+                continue;
+            }
+            Complex repulsion = 0.0;
+            for (std::size_t j = 0; j < n; ++j) {
+                if (j != i) {
+                    repulsion += 1.0 / (z[i] - z[j]);
+                }
+            }
+            const Complex step = 1.0 / (eval.derivative / eval.value - repulsion);
+            if (!finite(step)) {
+                return false;
+            }
+            z[i] -= step;
+            if (std::abs(step) <= tol * std::max(1.0, std::abs(z[i]))) {
+                done[i] = true;
+            } else {
+                ++active;
+            }
+        }
+        if (active == 0) {
+            return true;
+        }
+    }
+    iterations = max_iterations;
+    return false;
+}
+
+bool companion(const std::vector<double>& c, std::vector<Complex>& z) {
+    const int n = static_cast<int>(c.size()) - 1;
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(n, n);
+    for (int i = 1; i < n; ++i) {
+        matrix(i, i - 1) = 1.0;
+    }
+    for (int i = 0; i < n; ++i) {
+        matrix(i, n - 1) = -c[i] / c[n];
+    }
+    const Eigen::EigenSolver<Eigen::MatrixXd> solver(matrix, false);
+    const auto& eigenvalues = solver.eigenvalues();
+    z.assign(eigenvalues.data(), eigenvalues.data() + n);
+    return solver.info() == Eigen::Success;
+}
+
+// Newton steps on c that are kept only while they reduce |c(z)|.
+Complex polish(const std::vector<double>& c, Complex z) {
+    auto eval = horner(c, z);
+    for (int step = 0; step < kPolishSteps && std::abs(eval.value) > eval.rounding; ++step) {
+        const Complex next = z - eval.value / eval.derivative;
+        if (!finite(next)) {
+            break;
+        }
+        const auto next_eval = horner(c, next);
+        if (std::abs(next_eval.value) >= std::abs(eval.value)) {
+            break;
+        }
+        z = next;
+        eval = next_eval;
+    }
+    return z;
+}
+
+// Radius of a disk around z that contains a root of c: n |c(z) / c'(z)|.
+double inclusion_radius(const std::vector<double>& c, Complex z) {
+    const auto eval = horner(c, z);
+    const double n = static_cast<double>(c.size() - 1);
+    const double radius = n * (std::abs(eval.value) + eval.rounding) / std::abs(eval.derivative);
+    const double cap = kMaxClusterRadius * (1.0 + std::abs(z));
+    return std::isfinite(radius) ? std::min(radius, cap) : cap;
+}
+
+std::size_t find_root(std::vector<std::size_t>& parent, std::size_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// Merges approximations whose inclusion disks overlap into one root whose
+// multiplicity is the cluster size, then polishes the cluster centroid on
+// the derivative of order multiplicity - 1, where the root is simple.
+std::vector<PolynomialRoot> cluster_roots(const std::vector<double>& c, const std::vector<Complex>& z) {
+    const std::size_t n = z.size();
+    std::vector<double> radius(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        radius[i] = inclusion_radius(c, z[i]);
+    }
+    std::vector<std::size_t> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (std::abs(z[i] - z[j]) <= radius[i] + radius[j]) {
+                parent[find_root(parent, i)] = find_root(parent, j);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> clusters(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        clusters[find_root(parent, i)].push_back(i);
+    }
+    std::vector<PolynomialRoot> roots;
+    for (const auto& members : clusters) {
+        if (members.empty()) {
+            continue;
+        }
+        const int multiplicity = static_cast<int>(members.size());
+        if (multiplicity == 1) {
+            roots.push_back({z[members[0]], 1, radius[members[0]]});
+            continue;
+        }
+        Complex centroid = 0.0;
+        for (std::size_t i : members) {
+            centroid += z[i];
+        }
+        centroid /= static_cast<double>(multiplicity);
+        double spread = 0.0;
+        for (std::size_t i : members) {
+            spread = std::max(spread, std::abs(z[i] - centroid));
+        }
+        const auto derivative = derivative_coeffs(c, multiplicity - 1);
+        const Complex polished = polish(derivative, centroid);
+        if (std::abs(polished - centroid) <= spread) {
+            centroid = polished;
+        }
+        roots.push_back({centroid, multiplicity, std::max(spread, inclusion_radius(derivative, centroid))});
+    }
+    return roots;
+}
+
+}
+
+RootFinderResult find_polynomial_roots(const std::vector<double>& coeffs, double tol, int max_iterations) {
+    for (double value : coeffs) {
+        if (!std::isfinite(value)) {
+            throw NumericError("Polynomial coefficients must be finite");
+        }
+    }
+    if (max_iterations <= 0) {
+        throw NumericError("max_iterations must be positive");
+    }
+
+    RootFinderResult result{{}, 0, true, "aberth"};
+    std::size_t high = coeffs.size();
+    while (high > 0 && coeffs[high - 1] == 0.0) {
+        --high;
+    }
+    if (high == 0) {
+        throw NumericError("The zero polynomial has no isolated roots");
+    }
+    std::size_t low = 0;
+    while (coeffs[low] == 0.0) {
+        ++low;
+    }
+    if (low > 0) {
+        result.roots.push_back({0.0, static_cast<int>(low), 0.0});
+    }
+    const std::vector<double> c(coeffs.begin() + low, coeffs.begin() + high);
+    if (c.size() < 2) {
+        return result;
+    }
+
+    std::vector<Complex> z;
+    if (!aberth(c, tol, max_iterations, z, result.iterations)) {
+        result.method = "companion";
+        result.converged = companion(c, z);
+    }
+    for (auto& root : z) {
+        root = polish(c, root);
+    }
+    for (auto& root : cluster_roots(c, z)) {
+        // Real coefficients: a root within its error of the axis is real.
+        if (std::abs(root.value.imag()) <= root.error_estimate) {
+            root.value.imag(0.0);
+        }
+        result.roots.push_back(root);
+    }
+    std::sort(result.roots.begin(), result.roots.end(), [](const PolynomialRoot& lhs, const PolynomialRoot& rhs) {
+        if (lhs.value.real() != rhs.value.real()) {
+            return lhs.value.real() < rhs.value.real();
+        }
+        return lhs.value.imag() < rhs.value.imag();
+    });
+    return result;
+}
+
+std::vector<RootFinderResult> find_polynomial_roots_batch(
+    const std::vector<std::vector<double>>& polys,
+    double tol,
+    int max_iterations
+) {
+    if (max_iterations <= 0) {
+        throw NumericError("max_iterations must be positive");
+    }
+    std::vector<RootFinderResult> results(polys.size());
+    const long count = static_cast<long>(polys.size());
+    bool failed = false;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (long i = 0; i < count; ++i) {
+        try {
+            results[i] = find_polynomial_roots(polys[i], tol, max_iterations);
+        } catch (const NumericError&) {
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+            failed = true;
+        }
+    }
+    if (failed) {
+        throw NumericError("Batch contains a zero polynomial or non-finite coefficients");
+    }
+    return results;
+}
+
+}
@@ -0,0 +1,796 @@
+#include "mathllm/series.h"
+#include "mathllm/numeric.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/constants.h>
+#include <symengine/eval_double.h>
+#include <symengine/functions.h>
+#include <symengine/infinity.h>
+#include <symengine/nan.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::Symbol;
+
+// A symbol-free sum such as sin(1)^2 + cos(1)^2 - 1 counts as zero when it
+// evaluates below this fraction of the magnitudes of its terms.
+const double kZeroTolerance = 1e-13;
+// Working precision starts this many terms past the requested order and
+// grows by the shortfall plus this much when cancellation eats terms.
+const int kExtraTerms = 4;
+const int kMaxAttempts = 6;
+// Richardson extrapolation samples at h = kInitialStep / 2^k for k below
+// kRichardsonSteps. Full confidence takes kConfidentDigits agreeing digits;
+// below kMinConfidence a divergent limit is tried instead.
+const double kInitialStep = 0.125;
+const int kRichardsonSteps = 14;
+const double kConfidentDigits = 12.0;
+const double kMinConfidence = 0.5;
+
+// Cancellation left a series with no known non-zero term where one is
+// needed (a divisor, a base); series() retries with more working precision.
+struct PrecisionLost {};
+
+// Zero when SymEngine proves it or a sum cancels relative to its terms. A
+// small value alone, such as exp(-40), is not zero, and anything that
+// cannot be decided counts as non-zero.
+bool is_zero(const RCP<const Basic>& coeff) {
+    if (SymEngine::is_a_Number(*coeff)) {
+        return SymEngine::down_cast<const SymEngine::Number&>(*coeff).is_zero();
+    }
+    if (!SymEngine::free_symbols(*coeff).empty()) {
+        return false;
+    }
+    const auto known = SymEngine::is_zero(*coeff);
+    if (known != SymEngine::tribool::indeterminate) {
+        return known == SymEngine::tribool::tritrue;
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(*coeff)) {
+        const auto factors = coeff->get_args();
+        return std::any_of(factors.begin(), factors.end(), [](const RCP<const Basic>& factor) { return is_zero(factor); });
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*coeff)) {
+        const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*coeff);
+        return SymEngine::is_a_Number(*pow.get_exp())
+            && SymEngine::down_cast<const SymEngine::Number&>(*pow.get_exp()).is_positive()
+            && is_zero(pow.get_base());
+    }
+    if (!SymEngine::is_a<SymEngine::Add>(*coeff)) {
+        return false;
+    }
+    try {
+        double scale = 0.0;
+        for (const auto& term : coeff->get_args()) {
+            scale += std::abs(SymEngine::eval_complex_double(*term));
+        }
+        return std::abs(SymEngine::eval_complex_double(*coeff)) <= kZeroTolerance * scale;
+    } catch (const SymEngine::SymEngineException&) {
+        return false;
+    }
+}
+
+// t^valuation * (coeffs[0] + coeffs[1]*t + ...) + O(t^precision()).
+struct Series {
+    int valuation = 0;
+    std::vector<RCP<const Basic>> coeffs;
+
+    int precision() const { return valuation + static_cast<int>(coeffs.size()); }
+
+    // Coefficient of t^power, for power < precision().
+    RCP<const Basic> at(int power) const {
+        if (power < valuation) {
+            return SymEngine::zero;
+        }
+        return coeffs[power - valuation];
+    }
+};
+
+// Strips leading zero coefficients so coeffs[0], if any, is non-zero.
+void normalize(Series& series) {
+    std::size_t leading = 0;
+    while (leading < series.coeffs.size() && is_zero(series.coeffs[leading])) {
+        ++leading;
+    }
+    series.coeffs.erase(series.coeffs.begin(), series.coeffs.begin() + leading);
+    series.valuation += static_cast<int>(leading);
+}
+
+Series constant(const RCP<const Basic>& value, int precision) {
+    Series result;
+    result.coeffs.assign(precision, SymEngine::zero);
+    result.coeffs[0] = value;
+    normalize(result);
+    return result;
+}
+
+Series add(const Series& a, const Series& b) {
+    const int precision = std::min(a.precision(), b.precision());
+    Series result;
+    result.valuation = std::min({a.valuation, b.valuation, precision});
+    for (int power = result.valuation; power < precision; ++power) {
+        result.coeffs.push_back(SymEngine::expand(SymEngine::add(a.at(power), b.at(power))));
+    }
+    normalize(result);
+    return result;
+}
+
+Series scale(const Series& a, const RCP<const Basic>& factor) {
+    Series result = a;
+    for (auto& coeff : result.coeffs) {
+        coeff = SymEngine::expand(SymEngine::mul(coeff, factor));
+    }
+    normalize(result);
+    return result;
+}
+
+Series multiply(const Series& a, const Series& b) {
+    Series result;
+    result.valuation = a.valuation + b.valuation;
+    const int precision = std::min(a.precision() + b.valuation, b.precision() + a.valuation);
+    const int terms = precision - result.valuation;
+    const int a_size = static_cast<int>(a.coeffs.size());
+    const int b_size = static_cast<int>(b.coeffs.size());
+    for (int k = 0; k < terms; ++k) {
+        SymEngine::vec_basic products;
+        for (int i = std::max(0, k - b_size + 1); i <= std::min(k, a_size - 1); ++i) {
+            products.push_back(SymEngine::mul(a.coeffs[i], b.coeffs[k - i]));
+        }
+        result.coeffs.push_back(SymEngine::expand(SymEngine::add(products)));
+    }
+    normalize(result);
+    return result;
+}
+
+Series inverse(const Series& a) {
+    if (a.coeffs.empty()) {
+        throw PrecisionLost();
+    }
+    const auto inv0 = SymEngine::div(SymEngine::one, a.coeffs[0]);
+    Series result;
+    result.valuation = -a.valuation;
+    result.coeffs.push_back(inv0);
+    for (std::size_t k = 1; k < a.coeffs.size(); ++k) {
+        SymEngine::vec_basic products;
+        for (std::size_t j = 1; j <= k; ++j) {
+            products.push_back(SymEngine::mul(a.coeffs[j], result.coeffs[k - j]));
+        }
+        result.coeffs.push_back(SymEngine::expand(SymEngine::mul(SymEngine::neg(inv0), SymEngine::add(products))));
+    }
+    return result;
+}
+
+// The coefficients of t^0, t^1, ... of a series without negative powers.
+std::vector<RCP<const Basic>> regular(const Series& a) {
+    if (a.valuation < 0) {
+        if (a.coeffs.empty()) {
+            throw PrecisionLost();
+        }
+        throw SymbolicError("Essential singularity: a function of a pole has no Laurent expansion");
+    }
+    if (a.precision() <= 0) {
+        throw PrecisionLost();
+    }
+    std::vector<RCP<const Basic>> coeffs(a.valuation, SymEngine::zero);
+    coeffs.insert(coeffs.end(), a.coeffs.begin(), a.coeffs.end());
+    return coeffs;
+}
+
+Series from_regular(std::vector<RCP<const Basic>> coeffs) {
+    Series result;
+    result.coeffs = std::move(coeffs);
+    normalize(result);
+    return result;
+}
+
+Series derivative(const Series& a) {
+    const auto coeffs = regular(a);
+    std::vector<RCP<const Basic>> result;
+    for (std::size_t k = 1; k < coeffs.size(); ++k) {
+        result.push_back(SymEngine::expand(SymEngine::mul(SymEngine::integer(static_cast<long>(k)), coeffs[k])));
+    }
+    return from_regular(result);
+}
+
+// The antiderivative of a that takes the value value0 at t = 0.
+Series integrate(const Series& a, const RCP<const Basic>& value0) {
+    const auto coeffs = regular(a);
+    std::vector<RCP<const Basic>> result = {value0};
+    for (std::size_t k = 0; k < coeffs.size(); ++k) {
+        result.push_back(SymEngine::expand(SymEngine::div(coeffs[k], SymEngine::integer(static_cast<long>(k + 1)))));
+    }
+    return from_regular(result);
+}
+
+// Sum over j = 1..k of j * a_j * b_(k-j), the convolution behind f(a)' = g * a'.
+RCP<const Basic> weighted_sum(const std::vector<RCP<const Basic>>& a, const std::vector<RCP<const Basic>>& b, std::size_t k) {
+    SymEngine::vec_basic products;
+    for (std::size_t j = 1; j <= k; ++j) {
+        products.push_back(SymEngine::mul(SymEngine::integer(static_cast<long>(j)), SymEngine::mul(a[j], b[k - j])));
+    }
+    return SymEngine::add(products);
+}
+
+// exp(a) from b' = a' b.
+Series exp_series(const Series& a) {
+    const auto coeffs = regular(a);
+    std::vector<RCP<const Basic>> result = {SymEngine::exp(coeffs[0])};
+    for (std::size_t k = 1; k < coeffs.size(); ++k) {
+        const auto k_inv = SymEngine::rational(1, static_cast<long>(k));
+        result.push_back(SymEngine::expand(SymEngine::mul(k_inv, weighted_sum(coeffs, result, k))));
+    }
+    return from_regular(result);
+}
+
+// sin(a) and cos(a), or sinh(a) and cosh(a), from S' = C a', C' = -+S a'.
+void sin_cos_series(const Series& a, bool hyperbolic, Series& sin_out, Series& cos_out) {
+    const auto coeffs = regular(a);
+    std::vector<RCP<const Basic>> s = {hyperbolic ? SymEngine::sinh(coeffs[0]) : SymEngine::sin(coeffs[0])};
+    std::vector<RCP<const Basic>> c = {hyperbolic ? SymEngine::cosh(coeffs[0]) : SymEngine::cos(coeffs[0])};
+    for (std::size_t k = 1; k < coeffs.size(); ++k) {
+        const auto k_inv = SymEngine::rational(1, static_cast<long>(k));
+        s.push_back(SymEngine::expand(SymEngine::mul(k_inv, weighted_sum(coeffs, c, k))));
+        const auto dc = SymEngine::mul(k_inv, weighted_sum(coeffs, s, k));
+        c.push_back(SymEngine::expand(hyperbolic ? dc : SymEngine::neg(dc)));
+    }
+    sin_out = from_regular(s);
+    cos_out = from_regular(c);
+}
+
+// a^exponent for exponent free of t. With a = t^v a0 (1 + u), this is
+// t^(v exponent) a0^exponent (1 + u)^exponent, the last factor from
+// a b' = exponent a' b. A non-integer v exponent would be a Puiseux term.
+Series power(const Series& a, const RCP<const Basic>& exponent, bool positive) {
+    if (a.coeffs.empty()) {
+        throw PrecisionLost();
+    }
+    int shift = 0;
+    if (a.valuation != 0) {
+        bool integral = SymEngine::is_a<SymEngine::Integer>(*exponent);
+        if (!integral && positive && SymEngine::is_a<SymEngine::Rational>(*exponent)) {
+            const auto& rational = SymEngine::down_cast<const SymEngine::Rational&>(*exponent);
+            const long num = rational.get_num()->as_int();
+            const long den = rational.get_den()->as_int();
+            integral = (static_cast<long>(a.valuation) * num) % den == 0;
+        }
+        if (!integral) {
+            throw SymbolicError("Fractional power term: the expansion is not a Laurent series");
+        }
+        const auto product = SymEngine::mul(SymEngine::integer(a.valuation), exponent);
+        shift = static_cast<int>(SymEngine::down_cast<const SymEngine::Integer&>(*product).as_int());
+    }
+    const auto& coeffs = a.coeffs;
+    const auto a0_inv = SymEngine::div(SymEngine::one, coeffs[0]);
+    const auto exponent_plus_one = SymEngine::add(exponent, SymEngine::one);
+    std::vector<RCP<const Basic>> result = {SymEngine::pow(coeffs[0], exponent)};
+    for (std::size_t k = 1; k < coeffs.size(); ++k) {
+        SymEngine::vec_basic products;
+        for (std::size_t j = 1; j <= k; ++j) {
+            const auto weight = SymEngine::sub(
+                SymEngine::mul(exponent_plus_one, SymEngine::integer(static_cast<long>(j))),
+                SymEngine::integer(static_cast<long>(k))
+            );
+            products.push_back(SymEngine::mul(weight, SymEngine::mul(coeffs[j], result[k - j])));
+        }
+        const auto scale = SymEngine::mul(a0_inv, SymEngine::rational(1, static_cast<long>(k)));
+        result.push_back(SymEngine::expand(SymEngine::mul(scale, SymEngine::add(products))));
+    }
+    Series series = from_regular(result);
+    series.valuation += shift;
+    return series;
+}
+
+// log(a) = log(a0) + integral of a'/a; a must not vanish at t = 0.
+Series log_series(const Series& a) {
+    if (a.coeffs.empty()) {
+        throw PrecisionLost();
+    }
+    if (a.valuation != 0) {
+        throw SymbolicError("Logarithmic term: the expansion is not a Laurent series");
+    }
+    return integrate(multiply(derivative(a), inverse(a)), SymEngine::log(a.coeffs[0]));
+}
+
+Series abs_series(const Series& a, bool positive) {
+    if (a.coeffs.empty()) {
+        throw PrecisionLost();
+    }
+    const auto& leading = a.coeffs[0];
+    if (!SymEngine::free_symbols(*leading).empty() || (a.valuation % 2 != 0 && !positive)) {
+        throw SymbolicError("Cannot determine the sign under abs for a series expansion");
+    }
+    const std::complex<double> value = SymEngine::eval_complex_double(*leading);
+    if (value.imag() != 0.0) {
+        throw SymbolicError("Cannot expand abs of a complex series");
+    }
+    return value.real() < 0.0 ? scale(a, SymEngine::minus_one) : a;
+}
+
+Series one_minus_square(const Series& a, int precision) {
+    return add(constant(SymEngine::one, precision), scale(multiply(a, a), SymEngine::minus_one));
+}
+
+Series one_plus_square(const Series& a, int precision) {
+    return add(constant(SymEngine::one, precision), multiply(a, a));
+}
+
+class Expander {
+public:
+    Expander(const RCP<const Symbol>& var, const Series& var_series, int precision, bool positive)
+        : var_(var), var_series_(var_series), precision_(precision), positive_(positive) {}
+
+    Series expand(const RCP<const Basic>& expr) {
+        auto cached = memo_.find(expr);
+        if (cached != memo_.end()) {
+            return cached->second;
+        }
+        Series result = compute(expr);
+        memo_.emplace(expr, result);
+        return result;
+    }
+
+private:
+    Series compute(const RCP<const Basic>& expr) {
+        if (!SymEngine::has_symbol(*expr, *var_)) {
+            return constant(expr, precision_);
+        }
+        if (SymEngine::is_a<SymEngine::Symbol>(*expr)) {
+            return var_series_;
+        }
+        if (SymEngine::is_a<SymEngine::Add>(*expr) || SymEngine::is_a<SymEngine::Mul>(*expr)) {
+            const bool sum = SymEngine::is_a<SymEngine::Add>(*expr);
+            const auto args = expr->get_args();
+            Series result = expand(args[0]);
+            for (std::size_t i = 1; i < args.size(); ++i) {
+                result = sum ? add(result, expand(args[i])) : multiply(result, expand(args[i]));
+            }
+            return result;
+        }
+        if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+            const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*expr);
+            if (!SymEngine::has_symbol(*pow.get_exp(), *var_)) {
+                return power(expand(pow.get_base()), pow.get_exp(), positive_);
+            }
+            if (SymEngine::eq(*pow.get_base(), *SymEngine::E)) {
+                return exp_series(expand(pow.get_exp()));
+            }
+            return exp_series(multiply(expand(pow.get_exp()), log_series(expand(pow.get_base()))));
+        }
+        if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*expr)) {
+            const auto& arg = SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).get_arg();
+            return function(expr, expand(arg));
+        }
+        throw SymbolicError("Cannot expand in series: " + expr->__str__());
+    }
+
+    Series function(const RCP<const Basic>& expr, const Series& a) {
+        const auto type = expr->get_type_code();
+        Series s;
+        Series c;
+        switch (type) {
+            case SymEngine::SYMENGINE_LOG:
+                return log_series(a);
+            case SymEngine::SYMENGINE_ABS:
+                return abs_series(a, positive_);
+            case SymEngine::SYMENGINE_SIN:
+            case SymEngine::SYMENGINE_COS:
+            case SymEngine::SYMENGINE_TAN:
+            case SymEngine::SYMENGINE_COT:
+            case SymEngine::SYMENGINE_SEC:
+            case SymEngine::SYMENGINE_CSC:
+                sin_cos_series(a, false, s, c);
+                break;
+            case SymEngine::SYMENGINE_SINH:
+            case SymEngine::SYMENGINE_COSH:
+            case SymEngine::SYMENGINE_TANH:
+            case SymEngine::SYMENGINE_COTH:
+                sin_cos_series(a, true, s, c);
+                break;
+            default:
+                return inverse_function(expr, a);
+        }
+        switch (type) {
+            case SymEngine::SYMENGINE_SIN:
+            case SymEngine::SYMENGINE_SINH:
+                return s;
+            case SymEngine::SYMENGINE_COS:
+            case SymEngine::SYMENGINE_COSH:
+                return c;
+            case SymEngine::SYMENGINE_TAN:
+            case SymEngine::SYMENGINE_TANH:
+                return multiply(s, inverse(c));
+            case SymEngine::SYMENGINE_COT:
+            case SymEngine::SYMENGINE_COTH:
+                return multiply(c, inverse(s));
+            case SymEngine::SYMENGINE_SEC:
+                return inverse(c);
+            default:
+                return inverse(s);
+        }
+    }
+
+    // Inverse functions as the integral of their derivative, which is
+    // algebraic in the argument.
+    Series inverse_function(const RCP<const Basic>& expr, const Series& a) {
+        const auto value0 = regular(a)[0];
+        const auto minus_half = SymEngine::rational(-1, 2);
+        Series factor;
+        RCP<const Basic> start;
+        switch (expr->get_type_code()) {
+            case SymEngine::SYMENGINE_ATAN:
+                factor = inverse(one_plus_square(a, precision_));
+                start = SymEngine::atan(value0);
+                break;
+            case SymEngine::SYMENGINE_ASIN:
+                factor = power(one_minus_square(a, precision_), minus_half, positive_);
+                start = SymEngine::asin(value0);
+                break;
+            case SymEngine::SYMENGINE_ACOS:
+                factor = scale(power(one_minus_square(a, precision_), minus_half, positive_), SymEngine::minus_one);
+                start = SymEngine::acos(value0);
+                break;
+            case SymEngine::SYMENGINE_ASINH:
+                factor = power(one_plus_square(a, precision_), minus_half, positive_);
+                start = SymEngine::asinh(value0);
+                break;
+            case SymEngine::SYMENGINE_ACOSH:
+                factor = power(scale(one_minus_square(a, precision_), SymEngine::minus_one), minus_half, positive_);
+                start = SymEngine::acosh(value0);
+                break;
+            case SymEngine::SYMENGINE_ATANH:
+                factor = inverse(one_minus_square(a, precision_));
+                start = SymEngine::atanh(value0);
+                break;
+            default:
+                throw SymbolicError("Cannot expand in series: " + expr->__str__());
+        }
+        return integrate(multiply(derivative(a), factor), start);
+    }
+
+    RCP<const Symbol> var_;
+    Series var_series_;
+    int precision_;
+    bool positive_;
+    std::unordered_map<RCP<const Basic>, Series, SymEngine::RCPBasicHash, SymEngine::RCPBasicKeyEq> memo_;
+};
+
+// Where var approaches its expansion point from.
+struct Point {
+    RCP<const Basic> x0 = SymEngine::zero;
+    // +1 or -1 at +-oo, where var = +-1/t with t > 0.
+    int infinity = 0;
+    // +1: var = x0 + t, -1: var = x0 - t, both with t > 0. 0: var = x0 + t
+    // for t of either sign.
+    int side = 0;
+};
+
+Point parse_point(const std::string& x0, const RCP<const Symbol>& var) {
+    Point point;
+    if (x0 == "oo" || x0 == "+oo") {
+        point.infinity = 1;
+    } else if (x0 == "-oo") {
+        point.infinity = -1;
+    } else {
+        point.x0 = SymEngine::parse(x0);
+        if (SymEngine::has_symbol(*point.x0, *var)) {
+            throw SymbolicError("Expansion point depends on the series variable");
+        }
+    }
+    return point;
+}
+
+// Expansion of expr in t with every term below t^order exact.
+Series expand_about(const RCP<const Basic>& expr, const RCP<const Symbol>& var, const Point& point, int order) {
+    const bool positive = point.infinity != 0 || point.side != 0;
+    int precision = order + kExtraTerms;
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        Series var_series;
+        if (point.infinity != 0) {
+            var_series.valuation = -1;
+            var_series.coeffs.assign(precision + 1, SymEngine::zero);
+            var_series.coeffs[0] = SymEngine::integer(point.infinity);
+        } else {
+            var_series.coeffs.assign(precision, SymEngine::zero);
+            var_series.coeffs[0] = point.x0;
+            var_series.coeffs[1] = point.side < 0 ? SymEngine::minus_one : SymEngine::one;
+            normalize(var_series);
+        }
+        Series expansion;
+        try {
+            expansion = Expander(var, var_series, precision, positive).expand(expr);
+        } catch (const PrecisionLost&) {
+            precision *= 2;
+            continue;
+        }
+        if (expansion.precision() >= order) {
+            return expansion;
+        }
+        precision += order - expansion.precision() + kExtraTerms;
+    }
+    throw SymbolicError("Series expansion lost too many terms to cancellation");
+}
+
+// Functions continuous wherever they are finite, so substituting the point
+// gives the limit unless it yields an infinity or nan.
+bool substitutable(const Basic& expr) {
+    if (SymEngine::is_a_sub<SymEngine::Function>(expr)) {
+        switch (expr.get_type_code()) {
+            case SymEngine::SYMENGINE_SIN: case SymEngine::SYMENGINE_COS: case SymEngine::SYMENGINE_TAN:
+            case SymEngine::SYMENGINE_COT: case SymEngine::SYMENGINE_SEC: case SymEngine::SYMENGINE_CSC:
+            case SymEngine::SYMENGINE_ASIN: case SymEngine::SYMENGINE_ACOS: case SymEngine::SYMENGINE_ATAN:
+            case SymEngine::SYMENGINE_SINH: case SymEngine::SYMENGINE_COSH: case SymEngine::SYMENGINE_TANH:
+            case SymEngine::SYMENGINE_COTH: case SymEngine::SYMENGINE_ASINH: case SymEngine::SYMENGINE_ACOSH:
+            case SymEngine::SYMENGINE_ATANH: case SymEngine::SYMENGINE_LOG: case SymEngine::SYMENGINE_ABS:
+                break;
+            default:
+                return false;
+        }
+    }
+    for (const auto& arg : expr.get_args()) {
+        if (!substitutable(*arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool finite_value(const Basic& value) {
+    if (SymEngine::is_a<SymEngine::Infty>(value) || SymEngine::is_a<SymEngine::NaN>(value)) {
+        return false;
+    }
+    for (const auto& arg : value.get_args()) {
+        if (!finite_value(*arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LimitResult exact_limit(const RCP<const Basic>& value, const std::string& method) {
+    return LimitResult{Expression(value), method, 1.0, 0.0};
+}
+
+// One-sided limit from the leading term of the expansion. False when expr
+// has no Laurent expansion there or the sign of a pole is symbolic.
+bool series_limit(const RCP<const Basic>& expr, const RCP<const Symbol>& var, const Point& point, LimitResult& result) {
+    Series expansion;
+    try {
+        expansion = expand_about(expr, var, point, 1);
+    } catch (const SymbolicError&) {
+        return false;
+    } catch (const SymEngine::SymEngineException&) {
+        return false;
+    }
+    if (expansion.valuation > 0) {
+        result = exact_limit(SymEngine::zero, "series");
+        return true;
+    }
+    const auto& leading = expansion.coeffs[0];
+    if (expansion.valuation == 0) {
+        result = exact_limit(leading, "series");
+        return true;
+    }
+    // A pole: t^valuation > 0 since t > 0, so the sign is the leading
+    // coefficient's.
+    if (!SymEngine::free_symbols(*leading).empty()) {
+        return false;
+    }
+    const std::complex<double> sign = SymEngine::eval_complex_double(*leading);
+    if (sign.imag() != 0.0) {
+        result = exact_limit(SymEngine::ComplexInf, "series");
+    } else {
+        result = exact_limit(sign.real() > 0.0 ? SymEngine::Inf : SymEngine::NegInf, "series");
+    }
+    return true;
+}
+
+struct Extrapolation {
+    double value;
+    double error;
+};
+
+// Richardson extrapolation of samples[k] = f(h0 / 2^k), assuming
+// f(h) = L + a1 h + a2 h^2 + ...: column j of the tableau eliminates h^j.
+// The diagonal entry that moves least from its predecessor wins.
+Extrapolation extrapolate(const std::vector<double>& samples) {
+    Extrapolation best{samples.back(), std::numeric_limits<double>::infinity()};
+    std::vector<double> previous;
+    for (std::size_t k = 0; k < samples.size(); ++k) {
+        std::vector<double> row = {samples[k]};
+        for (std::size_t j = 1; j <= k; ++j) {
+            const double factor = std::ldexp(1.0, static_cast<int>(j)) - 1.0;
+            row.push_back(row[j - 1] + (row[j - 1] - previous[j - 1]) / factor);
+        }
+        if (k > 0) {
+            const double error = std::abs(row[k] - previous[k - 1]);
+            if (error < best.error) {
+                best = {row[k], error};
+            }
+        }
+        previous = std::move(row);
+    }
+    return best;
+}
+
+double confidence(double error, double scale) {
+    if (error == 0.0) {
+        return 1.0;
+    }
+    const double digits = -std::log10(error / (1.0 + std::abs(scale)));
+    return std::min(1.0, std::max(0.0, digits / kConfidentDigits));
+}
+
+// One-sided limit from compiled evaluations approaching the point. A
+// divergent limit shows up as 1/f extrapolating to zero with f of one sign.
+LimitResult richardson_limit(const RCP<const Basic>& expr, const RCP<const Symbol>& var, const Point& point) {
+    double x0 = 0.0;
+    if (point.infinity == 0) {
+        if (!SymEngine::free_symbols(*point.x0).empty()) {
+            throw SymbolicError("Cannot evaluate the limit numerically at a symbolic point");
+        }
+        x0 = SymEngine::eval_double(*point.x0);
+    }
+    const double scale = std::max(1.0, std::abs(x0));
+    // Overflowing samples count only through 1/f, which is then 0.
+    std::vector<double> samples;
+    std::vector<double> reciprocals;
+    bool one_sign = true;
+    bool positive = true;
+    try {
+        const CompiledExpr f(expr, {var->get_name()});
+        for (int k = 0; k < kRichardsonSteps; ++k) {
+            const double h = std::ldexp(kInitialStep, -k);
+            const double x = point.infinity != 0 ? point.infinity / h : x0 + point.side * h * scale;
+            const double value = f.evaluate(&x);
+            if (std::isnan(value)) {
+                throw NumericError("Expression is not real near the limit point");
+            }
+            if (k == 0) {
+                positive = value > 0.0;
+            }
+            one_sign = one_sign && value != 0.0 && (value > 0.0) == positive;
+            if (std::isfinite(value)) {
+                samples.push_back(value);
+            }
+            reciprocals.push_back(1.0 / value);
+        }
+    } catch (const NumericError& ex) {
+        throw SymbolicError(std::string("Cannot determine the limit: ") + ex.what());
+    }
+
+    Extrapolation direct{std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()};
+    if (samples.size() >= 2) {
+        direct = extrapolate(samples);
+    }
+    const double direct_confidence = confidence(direct.error, direct.value);
+    if (one_sign && direct_confidence < kMinConfidence) {
+        const Extrapolation inverse = extrapolate(reciprocals);
+        const double inverse_confidence = confidence(std::abs(inverse.value) + inverse.error, 0.0);
+        if (inverse_confidence > direct_confidence) {
+            const auto infinity = positive ? SymEngine::Inf : SymEngine::NegInf;
+            return LimitResult{Expression(infinity), "richardson", inverse_confidence, inverse.error};
+        }
+    }
+    RCP<const Basic> value = SymEngine::Nan;
+    if (direct_confidence > 0.0) {
+        value = SymEngine::real_double(direct.value);
+    }
+    return LimitResult{Expression(value), "richardson", direct_confidence, direct.error};
+}
+
+LimitResult one_sided_limit(const RCP<const Basic>& expr, const RCP<const Symbol>& var, const Point& point) {
+    LimitResult result = exact_limit(SymEngine::Nan, "series");
+    if (series_limit(expr, var, point, result)) {
+        return result;
+    }
+    return richardson_limit(expr, var, point);
+}
+
+// The two-sided limit exists when the one-sided ones agree: exactly for the
+// exact methods, within their error estimates otherwise.
+LimitResult combine(const LimitResult& right, const LimitResult& left) {
+    bool agree = SymEngine::eq(*right.value.get(), *left.value.get());
+    if (!agree && (right.method == "richardson" || left.method == "richardson")) {
+        const std::complex<double> a = right.value.approximation();
+        const std::complex<double> b = left.value.approximation();
+        const double tolerance = 10.0 * (right.error_estimate + left.error_estimate) + 1e-12 * (1.0 + std::abs(a));
+        agree = std::isfinite(std::abs(a)) && std::abs(a - b) <= tolerance;
+    }
+    LimitResult result = right.confidence >= left.confidence ? right : left;
+    result.confidence = std::min(right.confidence, left.confidence);
+    result.error_estimate = std::max(right.error_estimate, left.error_estimate);
+    if (!agree) {
+        result.value = Expression(SymEngine::Nan);
+    }
+    return result;
+}
+
+}
+
+SeriesResult series(const std::string& expr, const std::string& var, const std::string& x0, int order) {
+    if (order < 1) {
+        throw NumericError("Series order must be positive");
+    }
+    try {
+        const auto parsed = SymEngine::parse(expr);
+        const auto symbol = SymEngine::symbol(var);
+        const Point point = parse_point(x0, symbol);
+        const Series expansion = expand_about(parsed, symbol, point, order);
+
+        RCP<const Basic> t;
+        if (point.infinity != 0) {
+            t = SymEngine::div(SymEngine::integer(point.infinity), symbol);
+        } else {
+            t = SymEngine::sub(symbol, point.x0);
+        }
+        std::vector<Expression> coefficients;
+        SymEngine::vec_basic terms;
+        const int valuation = std::min(expansion.valuation, order);
+        for (int power = valuation; power < order; ++power) {
+            const auto coeff = expansion.at(power);
+            coefficients.emplace_back(coeff);
+            terms.push_back(SymEngine::mul(coeff, SymEngine::pow(t, SymEngine::integer(power))));
+        }
+        return SeriesResult{Expression(SymEngine::add(terms)), coefficients, valuation, order};
+    } catch (const SymbolicError&) {
+        throw;
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+LimitResult limit(const std::string& expr, const std::string& var, const std::string& point, const std::string& dir) {
+    if (dir != "+" && dir != "-" && dir != "+-") {
+        throw NumericError("Limit direction must be '+', '-' or '+-'");
+    }
+    try {
+        const auto parsed = SymEngine::parse(expr);
+        const auto symbol = SymEngine::symbol(var);
+        Point approach = parse_point(point, symbol);
+        if (approach.infinity != 0) {
+            return one_sided_limit(parsed, symbol, approach);
+        }
+        if (substitutable(*parsed)) {
+            SymEngine::map_basic_basic at;
+            at[symbol] = approach.x0;
+            const auto value = parsed->subs(at);
+            if (finite_value(*value)) {
+                return exact_limit(value, "substitution");
+            }
+        }
+        if (dir != "+-") {
+            approach.side = dir == "+" ? 1 : -1;
+            return one_sided_limit(parsed, symbol, approach);
+        }
+        approach.side = 1;
+        const LimitResult right = one_sided_limit(parsed, symbol, approach);
+        approach.side = -1;
+        return combine(right, one_sided_limit(parsed, symbol, approach));
+    } catch (const SymbolicError&) {
+        throw;
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+}
@@ -0,0 +1,1033 @@
+#include "mathllm/solver.h"
+#include "mathllm/numeric.h"
+#include "mathllm/polynomial.h"
+#include "mathllm/roots.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/constants.h>
+#include <symengine/eval_double.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/real_double.h>
+#include <symengine/sets.h>
+#include <symengine/solve.h>
+#include <symengine/symbol.h>
+#include <symengine/visitor.h>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::Symbol;
+
+const double kEpsilon = std::numeric_limits<double>::epsilon();
+// Boxes processed before the scan gives up and reports an incomplete result.
+const int kMaxBoxes = 1 << 16;
+const int kMaxBrentIterations = 200;
+// An unresolved cluster is reported as a root only if |f| at its midpoint
+// is at most this; interval bounds blow up across poles, so clusters also
+// form where f is unbounded.
+const double kClusterResidual = 1e-8;
+// Newton line search: sufficient-decrease constant and step halvings.
+const double kArmijo = 1e-4;
+const int kMaxHalvings = 30;
+// Multi-start solutions closer than this (relative, max-norm) are the same.
+const double kSameSolution = 1e-6;
+// Linear systems: numeric systems above this size skip exact elimination,
+// square ones from kSparseMinSize up with at most kSparseMaxDensity
+// non-zeros use sparse LU, and least-squares residuals above
+// kConsistencyTolerance (relative) mean the system is inconsistent.
+const std::size_t kMaxExactSize = 24;
+const std::size_t kSparseMinSize = 64;
+const double kSparseMaxDensity = 0.1;
+const double kConsistencyTolerance = 1e-9;
+// Parametric cases up to this degree compile their closed form. Cubic and
+// quartic formulas go through complex intermediates even when every root
+// is real, which real-valued tapes cannot follow.
+const int kMaxClosedFormDegree = 2;
+// Relative distance within which a parametric solution counts as one of
+// the excluded poles of a rational equation.
+const double kExclusionTolerance = 1e-9;
+
+// Coefficients of each variable followed by the right-hand side.
+using LinearRow = std::vector<RCP<const Basic>>;
+
+struct Box {
+    double a;
+    double b;
+    double fa;
+    double fb;
+};
+
+bool sign_change(double fa, double fb) {
+    return (fa <= 0.0 && fb >= 0.0) || (fa >= 0.0 && fb <= 0.0);
+}
+
+double scaled_tol(double tol, double x) {
+    return tol * std::max(1.0, std::abs(x));
+}
+
+// Brent's method on [a, b] with f(a) f(b) <= 0. Returns the best estimate;
+// bracket receives the width of the final sign-change bracket around it.
+double brent(const CompiledExpr& f, double a, double b, double fa, double fb, double tol,
+             double& bracket, int& evaluations) {
+    double c = a;
+    double fc = fa;
+    double d = b - a;
+    double e = d;
+    for (int iter = 0; iter < kMaxBrentIterations; ++iter) {
+        if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::abs(fc) < std::abs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+        const double tol1 = 2.0 * kEpsilon * std::abs(b) + 0.5 * scaled_tol(tol, b);
+        const double xm = 0.5 * (c - b);
+        if (fb == 0.0) {
+            bracket = 0.0;
+            return b;
+        }
+        if (std::abs(xm) <= tol1) {
+            break;
+        }
+        if (std::abs(e) >= tol1 && std::abs(fa) > std::abs(fb)) {
+            // Inverse quadratic interpolation, or secant when only two
+            // distinct points are known.
+            const double s = fb / fa;
+            double p;
+            double q;
+            if (a == c) {
+                p = 2.0 * xm * s;
+                q = 1.0 - s;
+            } else {
+                const double qa = fa / fc;
+                const double r = fb / fc;
+                p = s * (2.0 * xm * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) {
+                q = -q;
+            }
+            p = std::abs(p);
+            if (2.0 * p < std::min(3.0 * xm * q - std::abs(tol1 * q), std::abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = xm;
+                e = d;
+            }
+        } else {
+            d = xm;
+            e = d;
+        }
+        a = b;
+        fa = fb;
+        b += std::abs(d) > tol1 ? d : (xm > 0.0 ? tol1 : -tol1);
+        fb = f.evaluate(&b);
+        ++evaluations;
+    }
+    bracket = std::abs(c - b);
+    return b;
+}
+
+// Refines the single root in a box where f is strictly monotone. The bound
+// is the Brent bracket, tightened by |f(x)| / min |f'| over that bracket.
+RealRoot refine_root(const CompiledExpr& f, const CompiledExpr& df, const Box& box, double tol, int& evaluations) {
+    if (box.fa == 0.0) {
+        return {box.a, 0.0, true};
+    }
+    if (box.fb == 0.0) {
+        return {box.b, 0.0, true};
+    }
+    double bracket = 0.0;
+    const double x = brent(f, box.a, box.b, box.fa, box.fb, tol, bracket, evaluations);
+    double bound = std::max(bracket, kEpsilon * std::abs(x));
+    const double lo = std::max(box.a, x - bracket);
+    const double hi = std::min(box.b, x + bracket);
+    double d_lo;
+    double d_hi;
+    df.evaluate_interval(&lo, &hi, d_lo, d_hi);
+    const double min_slope = std::min(std::abs(d_lo), std::abs(d_hi));
+    if (min_slope > 0.0 && (d_lo > 0.0 || d_hi < 0.0)) {
+        const double fx = std::abs(f.evaluate(&x));
+        bound = std::min(bound, std::max(fx / min_slope, kEpsilon * std::abs(x)));
+    }
+    return {x, bound, true};
+}
+
+// Residuals and the non-zero Jacobian entries of a system, compiled once and
+// shared read-only between Newton runs.
+class CompiledSystem {
+public:
+    CompiledSystem(const std::vector<std::string>& equations, const std::vector<std::string>& vars)
+        : rows_(equations.size()), cols_(vars.size()) {
+        if (equations.empty() || vars.empty()) {
+            throw NumericError("A system needs at least one equation and one variable");
+        }
+        std::vector<RCP<const Symbol>> symbols;
+        for (const auto& var : vars) {
+            symbols.push_back(SymEngine::symbol(var));
+        }
+        for (std::size_t i = 0; i < equations.size(); ++i) {
+            const auto f = parse_equation(equations[i]);
+            residuals_.emplace_back(f, vars);
+            for (std::size_t j = 0; j < symbols.size(); ++j) {
+                const auto derivative = SymEngine::diff(f, symbols[j]);
+                if (!SymEngine::eq(*derivative, *SymEngine::zero)) {
+                    jacobian_.push_back({static_cast<int>(i), static_cast<int>(j), CompiledExpr(derivative, vars)});
+                }
+            }
+        }
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+
+    // Returns false if a residual is not finite.
+    bool residuals(const Eigen::VectorXd& x, Eigen::VectorXd& out) const {
+        out.resize(rows_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            out[i] = residuals_[i].evaluate(x.data());
+        }
+        return out.allFinite();
+    }
+
+    void jacobian(const Eigen::VectorXd& x, Eigen::MatrixXd& out) const {
+        out.setZero(rows_, cols_);
+        for (const auto& entry : jacobian_) {
+            out(entry.row, entry.col) = entry.expr.evaluate(x.data());
+        }
+    }
+
+private:
+    struct Entry {
+        int row;
+        int col;
+        CompiledExpr expr;
+    };
+
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<CompiledExpr> residuals_;
+    std::vector<Entry> jacobian_;
+};
+
+SystemSolveResult newton(const CompiledSystem& system, const std::vector<double>& x0, double tol,
+                         int max_iterations, int start_index) {
+    const double inf = std::numeric_limits<double>::infinity();
+    SystemSolveResult result{x0, inf, 0, false, start_index};
+    Eigen::VectorXd x = Eigen::Map<const Eigen::VectorXd>(x0.data(), static_cast<Eigen::Index>(x0.size()));
+    Eigen::VectorXd f;
+    if (!system.residuals(x, f)) {
+        return result;
+    }
+    double merit = f.squaredNorm();
+    Eigen::MatrixXd jacobian;
+    Eigen::VectorXd trial;
+    Eigen::VectorXd f_trial;
+    while (true) {
+        if (f.lpNorm<Eigen::Infinity>() <= tol) {
+            result.converged = true;
+            break;
+        }
+        if (result.iterations >= max_iterations) {
+            break;
+        }
+        system.jacobian(x, jacobian);
+        const Eigen::VectorXd step = jacobian.completeOrthogonalDecomposition().solve(-f);
+        if (!step.allFinite()) {
+            break;
+        }
+        double lambda = 1.0;
+        bool accepted = false;
+        for (int halving = 0; halving < kMaxHalvings; ++halving, lambda *= 0.5) {
+            trial = x + lambda * step;
+            if (system.residuals(trial, f_trial) && f_trial.squaredNorm() <= (1.0 - 2.0 * kArmijo * lambda) * merit) {
+                accepted = true;
+                break;
+            }
+        }
+        if (!accepted) {
+            break;
+        }
+        ++result.iterations;
+        x = trial;
+        f = f_trial;
+        merit = f.squaredNorm();
+        const double step_norm = lambda * step.lpNorm<Eigen::Infinity>();
+        if (step_norm <= tol * (1.0 + x.lpNorm<Eigen::Infinity>()) && f.lpNorm<Eigen::Infinity>() <= std::sqrt(tol)) {
+            result.converged = true;
+            break;
+        }
+    }
+    result.solution.assign(x.data(), x.data() + x.size());
+    result.residual_norm = f.size() > 0 ? f.lpNorm<Eigen::Infinity>() : inf;
+    return result;
+}
+
+void check_start(const std::vector<double>& start, std::size_t dimension) {
+    if (start.size() != dimension) {
+        throw NumericError("Starting point needs one value per variable");
+    }
+}
+
+bool is_zero_expr(const RCP<const Basic>& expr) {
+    return SymEngine::eq(*expr, *SymEngine::zero);
+}
+
+bool is_real_number(const RCP<const Basic>& expr) {
+    return SymEngine::is_a_Number(*expr) && !SymEngine::rcp_static_cast<const SymEngine::Number>(expr)->is_complex();
+}
+
+// Reads the coefficient of each symbol and the constant term off the
+// expanded terms of f; throws SymbolicError if f is not linear in symbols.
+LinearRow linear_row(const RCP<const Basic>& f, const std::vector<RCP<const Symbol>>& symbols) {
+    const auto expanded = SymEngine::expand(f);
+    SymEngine::vec_basic terms;
+    if (SymEngine::is_a<SymEngine::Add>(*expanded)) {
+        terms = expanded->get_args();
+    } else {
+        terms.push_back(expanded);
+    }
+    const std::size_t n = symbols.size();
+    LinearRow row(n + 1, SymEngine::zero);
+    for (const auto& term : terms) {
+        std::size_t found = n;
+        int count = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            if (SymEngine::has_symbol(*term, *symbols[j])) {
+                found = j;
+                ++count;
+            }
+        }
+        if (count == 0) {
+            row[n] = SymEngine::sub(row[n], term);
+            continue;
+        }
+        const auto coeff = count == 1 ? SymEngine::div(term, symbols[found]) : term;
+        if (count > 1 || SymEngine::has_symbol(*coeff, *symbols[found])) {
+            throw SymbolicError("Equation is not linear in the variables: " + f->__str__());
+        }
+        row[found] = SymEngine::add(row[found], coeff);
+    }
+    return row;
+}
+
+// Coefficients of f as a polynomial in var, constant term first, with
+// trailing zeros dropped. False if f is not a polynomial in var; throws
+// SymbolicError past DensePoly::kMaxDegree.
+bool polynomial_coefficients(
+    const RCP<const Basic>& f,
+    const RCP<const Symbol>& var,
+    std::vector<RCP<const Basic>>& coeffs
+) {
+    const auto expanded = SymEngine::expand(f);
+    SymEngine::vec_basic terms;
+    if (SymEngine::is_a<SymEngine::Add>(*expanded)) {
+        terms = expanded->get_args();
+    } else {
+        terms.push_back(expanded);
+    }
+    coeffs.clear();
+    for (const auto& term : terms) {
+        int degree = 0;
+        if (SymEngine::has_symbol(*term, *var)) {
+            RCP<const Basic> power = term;
+            if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+                const auto& dict = SymEngine::down_cast<const SymEngine::Mul&>(*term).get_dict();
+                const auto it = dict.find(var);
+                if (it == dict.end()) {
+                    return false;
+                }
+                power = SymEngine::pow(var, it->second);
+            }
+            if (SymEngine::eq(*power, *var)) {
+                degree = 1;
+            } else if (SymEngine::is_a<SymEngine::Pow>(*power)) {
+                const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*power);
+                if (!SymEngine::eq(*pow.get_base(), *var) || !SymEngine::is_a<SymEngine::Integer>(*pow.get_exp())) {
+                    return false;
+                }
+                const auto& exponent = SymEngine::down_cast<const SymEngine::Integer&>(*pow.get_exp());
+                if (!exponent.is_positive()) {
+                    return false;
+                }
+                // Checked as a big integer before narrowing. Past the cap
+                // SymEngine's solver would expand the same dense
+                // polynomial, so there is nothing to fall back on.
+                if (exponent.as_integer_class() > SymEngine::integer_class(DensePoly::kMaxDegree)) {
+                    throw SymbolicError("Degree in " + var->get_name() + " exceeds "
+                                        + std::to_string(DensePoly::kMaxDegree));
+                }
+                degree = static_cast<int>(exponent.as_int());
+            } else {
+                return false;
+            }
+        }
+        const auto coeff = degree == 0 ? term : SymEngine::div(term, SymEngine::pow(var, SymEngine::integer(degree)));
+        if (degree > 0 && SymEngine::has_symbol(*coeff, *var)) {
+            return false;
+        }
+        if (coeffs.size() <= static_cast<std::size_t>(degree)) {
+            coeffs.resize(degree + 1, SymEngine::zero);
+        }
+        coeffs[degree] = SymEngine::add(coeffs[degree], coeff);
+    }
+    while (!coeffs.empty() && is_zero_expr(coeffs.back())) {
+        coeffs.pop_back();
+    }
+    return true;
+}
+
+std::string join(const std::vector<std::string>& parts, const std::string& separator) {
+    std::string out;
+    for (const auto& part : parts) {
+        out += (out.empty() ? "" : separator) + part;
+    }
+    return out;
+}
+
+// Dividing an expanded polynomial by a monomial and expanding again cancels
+// exactly; by a sum it would leave an unreduced quotient.
+bool is_monomial(const RCP<const Basic>& expr) {
+    return !SymEngine::is_a<SymEngine::Add>(*expr);
+}
+
+void fill_values(LinearSolveResult& result, const std::vector<RCP<const Basic>>& solution) {
+    for (const auto& value : solution) {
+        result.solution.push_back(value->__str__());
+    }
+    if (std::all_of(solution.begin(), solution.end(), is_real_number)) {
+        for (const auto& value : solution) {
+            result.values.push_back(SymEngine::eval_double(*value));
+        }
+    }
+}
+
+// Solves the echelon rows for the pivot variables, from the last pivot row
+// up, with the free variables already set in x.
+void back_substitute(const std::vector<LinearRow>& rows, const std::vector<std::size_t>& pivots,
+                     const std::vector<RCP<const Basic>>& rhs, std::vector<RCP<const Basic>>& x) {
+    const std::size_t n = x.size();
+    for (std::size_t k = pivots.size(); k-- > 0;) {
+        const std::size_t c = pivots[k];
+        RCP<const Basic> value = rhs[k];
+        for (std::size_t j = c + 1; j < n; ++j) {
+            value = SymEngine::sub(value, SymEngine::mul(rows[k][j], x[j]));
+        }
+        x[c] = SymEngine::expand(SymEngine::div(SymEngine::expand(value), rows[k][c]));
+    }
+}
+
+// Bareiss elimination with row pivoting. The exact division by the
+// previous pivot is skipped when that pivot is a sum, which restarts the
+// recurrence; entries stay polynomial either way, so zero tests after
+// expand() are reliable.
+LinearSolveResult fraction_free_solve(std::vector<LinearRow> rows, std::size_t n) {
+    LinearSolveResult result;
+    result.method = "fraction_free";
+    const std::size_t m = rows.size();
+    std::vector<std::size_t> pivots;
+    RCP<const Basic> previous = SymEngine::one;
+    for (std::size_t c = 0; c < n && pivots.size() < m; ++c) {
+        const std::size_t r = pivots.size();
+        std::size_t p = r;
+        while (p < m && is_zero_expr(rows[p][c])) {
+            ++p;
+        }
+        if (p == m) {
+            continue;
+        }
+        std::swap(rows[p], rows[r]);
+        const auto pivot = rows[r][c];
+        const bool divide = is_monomial(previous);
+        for (std::size_t i = r + 1; i < m; ++i) {
+            const auto factor = rows[i][c];
+            for (std::size_t j = c + 1; j <= n; ++j) {
+                auto entry = SymEngine::sub(SymEngine::mul(pivot, rows[i][j]), SymEngine::mul(factor, rows[r][j]));
+                if (divide) {
+                    entry = SymEngine::div(entry, previous);
+                }
+                rows[i][j] = SymEngine::expand(entry);
+            }
+            rows[i][c] = SymEngine::zero;
+        }
+        previous = pivot;
+        pivots.push_back(c);
+    }
+
+    result.rank = static_cast<int>(pivots.size());
+    for (std::size_t i = pivots.size(); i < m; ++i) {
+        if (!is_zero_expr(rows[i][n])) {
+            result.status = "inconsistent";
+            return result;
+        }
+    }
+    result.status = pivots.size() == n ? "unique" : "infinite";
+
+    std::vector<RCP<const Basic>> rhs;
+    for (std::size_t k = 0; k < pivots.size(); ++k) {
+        rhs.push_back(rows[k][n]);
+    }
+    std::vector<RCP<const Basic>> x(n, SymEngine::zero);
+    back_substitute(rows, pivots, rhs, x);
+    fill_values(result, x);
+
+    const std::vector<RCP<const Basic>> no_rhs(pivots.size(), SymEngine::zero);
+    for (std::size_t f = 0, k = 0; f < n; ++f) {
+        if (k < pivots.size() && pivots[k] == f) {
+            ++k;
+            continue;
+        }
+        std::vector<RCP<const Basic>> direction(n, SymEngine::zero);
+        direction[f] = SymEngine::one;
+        back_substitute(rows, pivots, no_rhs, direction);
+        std::vector<std::string> strings;
+        for (const auto& value : direction) {
+            strings.push_back(value->__str__());
+        }
+        result.nullspace.push_back(std::move(strings));
+    }
+    return result;
+}
+
+std::vector<std::string> to_strings(const Eigen::VectorXd& v) {
+    std::vector<std::string> out;
+    for (Eigen::Index i = 0; i < v.size(); ++i) {
+        out.push_back(SymEngine::real_double(v[i])->__str__());
+    }
+    return out;
+}
+
+LinearSolveResult eigen_solve(const std::vector<LinearRow>& rows, std::size_t n) {
+    LinearSolveResult result;
+    const auto m = static_cast<Eigen::Index>(rows.size());
+    const auto cols = static_cast<Eigen::Index>(n);
+    Eigen::MatrixXd a(m, cols);
+    Eigen::VectorXd b(m);
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (Eigen::Index i = 0; i < m; ++i) {
+        for (Eigen::Index j = 0; j < cols; ++j) {
+            a(i, j) = SymEngine::eval_double(*rows[i][j]);
+            if (a(i, j) != 0.0) {
+                triplets.emplace_back(i, j, a(i, j));
+            }
+        }
+        b[i] = SymEngine::eval_double(*rows[i][n]);
+    }
+
+    if (m == cols && n >= kSparseMinSize
+        && static_cast<double>(triplets.size()) <= kSparseMaxDensity * static_cast<double>(n * n)) {
+        Eigen::SparseMatrix<double> sparse(m, cols);
+        sparse.setFromTriplets(triplets.begin(), triplets.end());
+        sparse.makeCompressed();
+        Eigen::SparseLU<Eigen::SparseMatrix<double>> lu;
+        lu.analyzePattern(sparse);
+        lu.factorize(sparse);
+        if (lu.info() == Eigen::Success) {
+            const Eigen::VectorXd x = lu.solve(b);
+            if (lu.info() == Eigen::Success && x.allFinite()) {
+                result.status = "unique";
+                result.rank = static_cast<int>(n);
+                result.method = "sparse_lu";
+                result.solution = to_strings(x);
+                result.values.assign(x.data(), x.data() + x.size());
+                return result;
+            }
+        }
+    }
+
+    // Singular sparse systems and everything else: full-pivot LU, which
+    // also yields the rank and the kernel.
+    result.method = "dense_lu";
+    const Eigen::FullPivLU<Eigen::MatrixXd> lu(a);
+    result.rank = static_cast<int>(lu.rank());
+    const Eigen::VectorXd x = lu.solve(b);
+    const double scale = a.norm() * x.norm() + b.norm();
+    if (!x.allFinite() || (a * x - b).norm() > kConsistencyTolerance * std::max(scale, 1e-300)) {
+        result.status = "inconsistent";
+        return result;
+    }
+    result.status = result.rank == static_cast<int>(n) ? "unique" : "infinite";
+    result.solution = to_strings(x);
+    result.values.assign(x.data(), x.data() + x.size());
+    if (result.rank < static_cast<int>(n)) {
+        const Eigen::MatrixXd kernel = lu.kernel();
+        for (Eigen::Index k = 0; k < kernel.cols(); ++k) {
+            result.nullspace.push_back(to_strings(kernel.col(k)));
+        }
+    }
+    return result;
+}
+
+}
+
+RCP<const Basic> parse_equation(const std::string& equation) {
+    const auto split = equation.find('=');
+    try {
+        if (split == std::string::npos) {
+            return SymEngine::parse(equation);
+        }
+        if (equation.find('=', split + 1) != std::string::npos) {
+            throw SymbolicError("Equation has more than one '=': " + equation);
+        }
+        return SymEngine::sub(SymEngine::parse(equation.substr(0, split)), SymEngine::parse(equation.substr(split + 1)));
+    } catch (const SymbolicError&) {
+        throw;
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+RealRootsResult find_real_roots(
+    const RCP<const Basic>& f,
+    const RCP<const Symbol>& var,
+    double lower,
+    double upper,
+    double tol
+) {
+    if (!std::isfinite(lower) || !std::isfinite(upper) || lower > upper) {
+        throw NumericError("Root search interval must be finite with lower <= upper");
+    }
+    if (!(tol > 0.0)) {
+        throw NumericError("Root tolerance must be positive");
+    }
+    const std::vector<std::string> symbols = {var->get_name()};
+    const CompiledExpr fx(f, symbols);
+    // Without a compilable derivative no box can be certified monotone, so
+    // every root is reported as an unverified cluster.
+    std::unique_ptr<CompiledExpr> dfx;
+    try {
+        dfx.reset(new CompiledExpr(SymEngine::diff(f, var), symbols));
+    } catch (const NumericError&) {
+    }
+
+    RealRootsResult result{{}, true, 0};
+    std::vector<std::pair<double, double>> unresolved;
+    std::vector<Box> stack = {{lower, upper, fx.evaluate(&lower), fx.evaluate(&upper)}};
+    result.evaluations = 2;
+    int boxes = 0;
+    while (!stack.empty()) {
+        if (boxes++ >= kMaxBoxes) {
+            result.complete = false;
+            break;
+        }
+        const Box box = stack.back();
+        stack.pop_back();
+
+        double f_lo;
+        double f_hi;
+        fx.evaluate_interval(&box.a, &box.b, f_lo, f_hi);
+        ++result.evaluations;
+        if (f_lo > f_hi || f_lo > 0.0 || f_hi < 0.0) {
+            continue;
+        }
+        if (dfx && std::isfinite(box.fa) && std::isfinite(box.fb)) {
+            double d_lo;
+            double d_hi;
+            dfx->evaluate_interval(&box.a, &box.b, d_lo, d_hi);
+            ++result.evaluations;
+            if (d_lo > 0.0 || d_hi < 0.0) {
+                if (sign_change(box.fa, box.fb)) {
+                    result.roots.push_back(refine_root(fx, *dfx, box, tol, result.evaluations));
+                }
+                continue;
+            }
+        }
+        const double mid = box.a + 0.5 * (box.b - box.a);
+        if (box.b - box.a <= scaled_tol(tol, mid) || mid <= box.a || mid >= box.b) {
+            unresolved.emplace_back(box.a, box.b);
+            continue;
+        }
+        const double fm = fx.evaluate(&mid);
+        ++result.evaluations;
+        stack.push_back({mid, box.b, fm, box.fb});
+        stack.push_back({box.a, mid, box.fa, fm});
+    }
+
+    // Adjacent unresolved boxes form one cluster, reported at its midpoint
+    // when f nearly vanishes there.
+    std::sort(unresolved.begin(), unresolved.end());
+    for (std::size_t i = 0; i < unresolved.size();) {
+        double a = unresolved[i].first;
+        double b = unresolved[i].second;
+        for (++i; i < unresolved.size() && unresolved[i].first <= b; ++i) {
+            b = std::max(b, unresolved[i].second);
+        }
+        const double mid = a + 0.5 * (b - a);
+        const double fm = fx.evaluate(&mid);
+        ++result.evaluations;
+        if (std::abs(fm) <= kClusterResidual) {
+            result.roots.push_back({mid, 0.5 * (b - a), false});
+        }
+    }
+
+    // A root on a shared box edge is found from both sides.
+    std::sort(result.roots.begin(), result.roots.end(), [](const RealRoot& lhs, const RealRoot& rhs) {
+        return lhs.value < rhs.value;
+    });
+    std::vector<RealRoot> merged;
+    for (const auto& root : result.roots) {
+        if (!merged.empty() && root.value - merged.back().value <= root.error_bound + merged.back().error_bound) {
+            if (root.verified && !merged.back().verified) {
+                merged.back() = root;
+            }
+            continue;
+        }
+        merged.push_back(root);
+    }
+    result.roots = std::move(merged);
+    return result;
+}
+
+RealRootsResult find_real_roots(
+    const std::string& lhs,
+    const std::string& rhs,
+    const std::string& var,
+    double lower,
+    double upper,
+    double tol
+) {
+    RCP<const Basic> f;
+    try {
+        f = SymEngine::sub(SymEngine::parse(lhs), SymEngine::parse(rhs));
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+    return find_real_roots(f, SymEngine::symbol(var), lower, upper, tol);
+}
+
+SystemSolveResult solve_system(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const std::vector<double>& x0,
+    double tol,
+    int max_iterations
+) {
+    const CompiledSystem system(equations, vars);
+    check_start(x0, vars.size());
+    return newton(system, x0, tol, max_iterations, 0);
+}
+
+std::vector<SystemSolveResult> solve_system_multistart(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const std::vector<std::vector<double>>& starts,
+    double tol,
+    int max_iterations
+) {
+    const CompiledSystem system(equations, vars);
+    for (const auto& start : starts) {
+        check_start(start, vars.size());
+    }
+    std::vector<SystemSolveResult> runs(starts.size());
+    const long count = static_cast<long>(starts.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (long i = 0; i < count; ++i) {
+        runs[i] = newton(system, starts[i], tol, max_iterations, static_cast<int>(i));
+    }
+
+    std::vector<SystemSolveResult> solutions;
+    for (auto& run : runs) {
+        if (!run.converged) {
+            continue;
+        }
+        const bool seen = std::any_of(solutions.begin(), solutions.end(), [&run](const SystemSolveResult& other) {
+            double distance = 0.0;
+            double scale = 1.0;
+            for (std::size_t k = 0; k < run.solution.size(); ++k) {
+                distance = std::max(distance, std::abs(run.solution[k] - other.solution[k]));
+                scale = std::max(scale, std::abs(other.solution[k]));
+            }
+            return distance <= kSameSolution * scale;
+        });
+        if (!seen) {
+            solutions.push_back(std::move(run));
+        }
+    }
+    return solutions;
+}
+
+LinearSolveResult solve_linear_system(const std::vector<std::string>& equations, const std::vector<std::string>& vars) {
+    if (equations.empty() || vars.empty()) {
+        throw NumericError("A system needs at least one equation and one variable");
+    }
+    std::vector<RCP<const Symbol>> symbols;
+    for (const auto& var : vars) {
+        symbols.push_back(SymEngine::symbol(var));
+    }
+    std::vector<LinearRow> rows;
+    bool numeric = true;
+    bool exact = true;
+    for (const auto& equation : equations) {
+        LinearRow row = linear_row(parse_equation(equation), symbols);
+        for (auto& entry : row) {
+            entry = SymEngine::expand(entry);
+            if (!is_real_number(entry)) {
+                numeric = false;
+            } else if (!SymEngine::rcp_static_cast<const SymEngine::Number>(entry)->is_exact()) {
+                exact = false;
+            }
+        }
+        rows.push_back(std::move(row));
+    }
+    if (numeric && (!exact || vars.size() > kMaxExactSize)) {
+        return eigen_solve(rows, vars.size());
+    }
+    return fraction_free_solve(std::move(rows), vars.size());
+}
+
+ParametricSolution::ParametricSolution(
+    const std::string& lhs,
+    const std::string& rhs,
+    const std::string& var,
+    const std::vector<std::string>& params
+)
+    : num_params_(params.size()) {
+    if (std::find(params.begin(), params.end(), var) != params.end()) {
+        throw NumericError("The solve variable cannot also be a parameter: " + var);
+    }
+    RCP<const Basic> f;
+    try {
+        f = SymEngine::sub(SymEngine::parse(lhs), SymEngine::parse(rhs));
+    } catch (const std::exception& ex) {
+        throw SymbolicError(ex.what());
+    }
+    const auto symbol = SymEngine::symbol(var);
+
+    std::vector<RCP<const Basic>> coeffs;
+    if (polynomial_coefficients(f, symbol, coeffs)) {
+        if (coeffs.size() < 2) {
+            throw SymbolicError("Equation does not involve " + var);
+        }
+        width_ = coeffs.size() - 1;
+        for (const auto& coeff : coeffs) {
+            coeffs_.emplace_back(coeff, params);
+        }
+        // One case per degree the leading coefficients can drop to, down to
+        // the first leading coefficient that is a non-zero constant.
+        std::vector<std::string> zero_tests;
+        for (int degree = static_cast<int>(width_); degree >= 1; --degree) {
+            const auto& lead = coeffs[degree];
+            if (is_zero_expr(lead)) {
+                continue;
+            }
+            const bool constant = SymEngine::is_a_Number(*lead);
+            std::vector<std::string> tests = zero_tests;
+            if (!constant) {
+                tests.push_back(lead->__str__() + " != 0");
+            }
+            ParametricCase info{join(tests, " and "), {}};
+            CompiledCase compiled{degree, {}};
+            if (degree <= kMaxClosedFormDegree) {
+                SymEngine::vec_basic terms;
+                for (int k = 0; k <= degree; ++k) {
+                    terms.push_back(SymEngine::mul(coeffs[k], SymEngine::pow(symbol, SymEngine::integer(k))));
+                }
+                try {
+                    const auto set = SymEngine::solve(SymEngine::add(terms), symbol);
+                    if (SymEngine::is_a<SymEngine::FiniteSet>(*set)) {
+                        for (const auto& element : SymEngine::down_cast<const SymEngine::FiniteSet&>(*set).get_container()) {
+                            compiled.solutions.emplace_back(element, params);
+                            info.solutions.push_back(element->__str__());
+                        }
+                        // A perfect square gives one root; list it twice.
+                        if (degree == 2 && compiled.solutions.size() == 1) {
+                            const auto discriminant = SymEngine::expand(SymEngine::sub(
+                                SymEngine::pow(coeffs[1], SymEngine::integer(2)),
+                                SymEngine::mul(SymEngine::integer(4), SymEngine::mul(coeffs[2], coeffs[0]))
+                            ));
+                            if (is_zero_expr(discriminant)) {
+                                const CompiledExpr root = compiled.solutions.front();
+                                compiled.solutions.push_back(root);
+                                info.solutions.push_back(info.solutions.front());
+                            }
+                        }
+                    }
+                } catch (const SymEngine::SymEngineException&) {
+                } catch (const NumericError&) {
+                    // Not compilable (complex constants): solve numerically.
+                    compiled.solutions.clear();
+                    info.solutions.clear();
+                }
+            }
+            cases_.push_back(std::move(info));
+            compiled_.push_back(std::move(compiled));
+            if (constant) {
+                break;
+            }
+            zero_tests.push_back(lead->__str__() + " == 0");
+        }
+        return;
+    }
+
+    RCP<const SymEngine::Set> set;
+    try {
+        set = SymEngine::solve(f, symbol);
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+    // Rational equations come back as the numerator's roots minus the
+    // denominator's; the excluded points are checked per evaluation.
+    std::vector<std::string> tests;
+    if (SymEngine::is_a<SymEngine::Complement>(*set)) {
+        const auto& complement = SymEngine::down_cast<const SymEngine::Complement&>(*set);
+        if (SymEngine::is_a<SymEngine::FiniteSet>(*complement.get_container())) {
+            for (const auto& point : SymEngine::down_cast<const SymEngine::FiniteSet&>(*complement.get_container()).get_container()) {
+                excluded_.emplace_back(point, params);
+                tests.push_back(var + " != " + point->__str__());
+            }
+            set = complement.get_universe();
+        }
+    }
+    if (!SymEngine::is_a<SymEngine::FiniteSet>(*set)) {
+        throw SymbolicError("No closed-form solution for " + var + ": " + set->__str__());
+    }
+    ParametricCase info{join(tests, " and "), {}};
+    CompiledCase compiled{-1, {}};
+    for (const auto& element : SymEngine::down_cast<const SymEngine::FiniteSet&>(*set).get_container()) {
+        compiled.solutions.emplace_back(element, params);
+        info.solutions.push_back(element->__str__());
+    }
+    width_ = compiled.solutions.size();
+    cases_.push_back(std::move(info));
+    compiled_.push_back(std::move(compiled));
+}
+
+void ParametricSolution::evaluate_batch(const double* points, std::size_t count, double* out) const {
+    std::fill(out, out + count * width_, std::numeric_limits<double>::quiet_NaN());
+    // Each compiled expression runs over the whole batch at once.
+    std::vector<std::vector<double>> coeffs(coeffs_.size(), std::vector<double>(count));
+    for (std::size_t k = 0; k < coeffs_.size(); ++k) {
+        coeffs_[k].evaluate_batch(points, count, coeffs[k].data());
+    }
+    std::vector<std::vector<std::vector<double>>> solutions(compiled_.size());
+    for (std::size_t c = 0; c < compiled_.size(); ++c) {
+        for (const auto& solution : compiled_[c].solutions) {
+            solutions[c].emplace_back(count);
+            solution.evaluate_batch(points, count, solutions[c].back().data());
+        }
+    }
+
+    std::vector<std::vector<double>> excluded(excluded_.size(), std::vector<double>(count));
+    for (std::size_t k = 0; k < excluded_.size(); ++k) {
+        excluded_[k].evaluate_batch(points, count, excluded[k].data());
+    }
+
+    std::vector<std::vector<double>> numeric;
+    std::vector<std::size_t> numeric_points;
+    for (std::size_t p = 0; p < count; ++p) {
+        std::size_t selected = compiled_.size();
+        if (coeffs_.empty()) {
+            selected = 0;
+        } else {
+            const bool finite = std::all_of(coeffs.begin(), coeffs.end(), [p](const std::vector<double>& c) {
+                return std::isfinite(c[p]);
+            });
+            for (std::size_t c = 0; finite && c < compiled_.size() && selected == compiled_.size(); ++c) {
+                const std::size_t degree = static_cast<std::size_t>(compiled_[c].degree);
+                bool applies = coeffs[degree][p] != 0.0;
+                for (std::size_t k = degree + 1; applies && k < coeffs.size(); ++k) {
+                    applies = coeffs[k][p] == 0.0;
+                }
+                if (applies) {
+                    selected = c;
+                }
+            }
+        }
+        if (selected == compiled_.size()) {
+            continue;
+        }
+        if (solutions[selected].empty()) {
+            std::vector<double> poly;
+            for (int k = 0; k <= compiled_[selected].degree; ++k) {
+                poly.push_back(coeffs[k][p]);
+            }
+            numeric.push_back(std::move(poly));
+            numeric_points.push_back(p);
+            continue;
+        }
+        for (std::size_t j = 0; j < solutions[selected].size(); ++j) {
+            const double value = solutions[selected][j][p];
+            const bool allowed = std::none_of(excluded.begin(), excluded.end(), [p, value](const std::vector<double>& e) {
+                return std::abs(e[p] - value) <= kExclusionTolerance * std::max(1.0, std::abs(value));
+            });
+            if (allowed) {
+                out[p * width_ + j] = value;
+            }
+        }
+    }
+
+    const auto roots = find_polynomial_roots_batch(numeric);
+    for (std::size_t q = 0; q < roots.size(); ++q) {
+        double* row = out + numeric_points[q] * width_;
+        std::size_t j = 0;
+        for (const auto& root : roots[q].roots) {
+            if (root.value.imag() != 0.0) {
+                continue;
+            }
+            for (int m = 0; m < root.multiplicity; ++m) {
+                row[j++] = root.value.real();
+            }
+        }
+    }
+    for (std::size_t p = 0; p < count; ++p) {
+        double* row = out + p * width_;
+        double* end = std::partition(row, row + width_, [](double x) { return !std::isnan(x); });
+        std::sort(row, end);
+    }
+}
+
+std::vector<std::vector<double>> ParametricSolution::evaluate(const std::vector<std::vector<double>>& points) const {
+    std::vector<double> flat;
+    flat.reserve(points.size() * num_params_);
+    for (const auto& point : points) {
+        if (point.size() != num_params_) {
+            throw NumericError("Each parameter point needs one value per parameter");
+        }
+        flat.insert(flat.end(), point.begin(), point.end());
+    }
+    std::vector<double> out(points.size() * width_);
+    evaluate_batch(flat.data(), points.size(), out.data());
+    std::vector<std::vector<double>> rows;
+    for (std::size_t p = 0; p < points.size(); ++p) {
+        rows.emplace_back(out.begin() + p * width_, out.begin() + (p + 1) * width_);
+    }
+    return rows;
+}
+
+ParametricSolution solve_parametric(
+    const std::string& lhs,
+    const std::string& rhs,
+    const std::string& var,
+    const std::vector<std::string>& params
+) {
+    return ParametricSolution(lhs, rhs, var, params);
+}
+
+}
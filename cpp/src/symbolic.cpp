@@ -1,22 +1,37 @@
 #include "mathllm/symbolic.h"
+#include "mathllm/canonical.h"
+#include "mathllm/egraph.h"
+#include "mathllm/integration.h"
+#include "mathllm/intern.h"
+#include "mathllm/polynomial.h"
+#include "mathllm/rational.h"
+#include "mathllm/solution_set.h"
+#include "mathllm/solver.h"
+#include "mathllm/trig.h"
 
 #include <symengine/add.h>
 #include <symengine/basic.h>
 #include <symengine/constants.h>
 #include <symengine/functions.h>
+#include <symengine/logic.h>
 #include <symengine/mul.h>
 #include <symengine/parser.h>
 #include <symengine/pow.h>
 #include <symengine/rational.h>
+#include <symengine/real_double.h>
 #include <symengine/sets.h>
 #include <symengine/solve.h>
 #include <symengine/symbol.h>
 #include <symengine/symengine_exception.h>
 #include <symengine/visitor.h>
 
+#include <algorithm>
+#include <deque>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 #include <chrono>
 
@@ -28,6 +43,10 @@ using SymEngine::Basic;
 using SymEngine::RCP;
 using SymEngine::Symbol;
 
+// Equations SymEngine leaves unsolved are searched for real roots on
+// [-kNumericSolveRange, kNumericSolveRange].
+const double kNumericSolveRange = 100.0;
+
 RCP<const Basic> parse_expression(const std::string& expr) {
 	return SymEngine::parse(expr);
 }
@@ -36,128 +55,431 @@ RCP<const Symbol> make_symbol(const std::string& name) {
 	return SymEngine::symbol(name);
 }
 
-RCP<const Basic> integrate_basic(const RCP<const Basic>& expr, const RCP<const Symbol>& var);
-
-RCP<const Basic> integrate_add(const SymEngine::Add& add_expr, const RCP<const Symbol>& var) {
-	RCP<const Basic> result = SymEngine::integer(0);
-	for (const auto& term : add_expr.get_args()) {
-		result = SymEngine::add(result, integrate_basic(term, var));
-	}
-	return result;
+std::string to_string(const RCP<const Basic>& expr) {
+	return expr->__str__();
 }
 
-RCP<const Basic> integrate_mul(const SymEngine::Mul& mul_expr, const RCP<const Symbol>& var) {
-	RCP<const Basic> constant = SymEngine::one;
-	RCP<const Basic> dependent = SymEngine::one;
-	for (const auto& factor : mul_expr.get_args()) {
-		if (SymEngine::has_symbol(*factor, *var)) {
-			if (!SymEngine::eq(*dependent, *SymEngine::one)) {
-				throw SymbolicError("Unsupported integrand");
+std::string solutions_to_string(const SymEngine::RCP<const SymEngine::Set>& set) {
+	if (SymEngine::is_a<SymEngine::FiniteSet>(*set)) {
+		const auto finite = SymEngine::rcp_static_cast<const SymEngine::FiniteSet>(set);
+		const auto& elements = finite->get_container();
+		if (elements.empty()) {
+			return "[]";
+		}
+		std::vector<std::string> parts;
+		parts.reserve(elements.size());
+		for (const auto& element : elements) {
+			parts.push_back(element->__str__());
+		}
+		std::ostringstream oss;
+		oss << "[";
+		for (std::size_t i = 0; i < parts.size(); ++i) {
+			oss << parts[i];
+			if (i + 1 < parts.size()) {
+				oss << ", ";
 			}
-			dependent = factor;
-		} else {
-			constant = SymEngine::mul(constant, factor);
 		}
+		oss << "]";
+		return oss.str();
 	}
-	if (SymEngine::eq(*dependent, *SymEngine::one)) {
-		return SymEngine::mul(mul_expr.rcp_from_this(), var);
-	}
-	return SymEngine::mul(constant, integrate_basic(dependent, var));
+	return set->__str__();
+}
+
+// Multiplicity of each finite solution; solutions not listed are simple.
+using Multiplicities = std::map<RCP<const Basic>, int, SymEngine::RCPBasicKeyLess>;
+
+RCP<const SymEngine::Set> finite_set(const SymEngine::vec_basic& elements) {
+	return SymEngine::finiteset(SymEngine::set_basic(elements.begin(), elements.end()));
 }
 
-RCP<const Basic> integrate_pow(const SymEngine::Pow& pow_expr, const RCP<const Symbol>& var) {
-	const auto& base = pow_expr.get_base();
-	const auto& exponent = pow_expr.get_exp();
-	if (SymEngine::eq(*base, *SymEngine::E)) {
-		if (SymEngine::eq(*exponent, *var)) {
-			return SymEngine::pow(base, exponent);
+void collect_solutions(const RCP<const SymEngine::Set>& set, const Multiplicities& multiplicities, SolutionSet& result) {
+	if (SymEngine::is_a<SymEngine::FiniteSet>(*set)) {
+		for (const auto& element : SymEngine::down_cast<const SymEngine::FiniteSet&>(*set).get_container()) {
+			const auto found = multiplicities.find(element);
+			const Expression value(element);
+			result.elements.push_back({value, found == multiplicities.end() ? 1 : found->second, value.approximation()});
+		}
+	} else if (SymEngine::is_a<SymEngine::Interval>(*set)) {
+		const auto& interval = SymEngine::down_cast<const SymEngine::Interval&>(*set);
+		result.intervals.push_back({
+			Expression(interval.get_start()),
+			Expression(interval.get_end()),
+			interval.get_left_open(),
+			interval.get_right_open()
+		});
+	} else if (SymEngine::is_a<SymEngine::Union>(*set)) {
+		for (const auto& part : SymEngine::down_cast<const SymEngine::Union&>(*set).get_container()) {
+			collect_solutions(SymEngine::rcp_static_cast<const SymEngine::Set>(part), multiplicities, result);
 		}
-		throw SymbolicError("Unsupported integrand");
+	} else if (SymEngine::is_a<SymEngine::ConditionSet>(*set)) {
+		result.conditions.emplace_back(SymEngine::down_cast<const SymEngine::ConditionSet&>(*set).get_condition());
+	} else if (!SymEngine::is_a<SymEngine::EmptySet>(*set)) {
+		result.conditions.emplace_back(set);
+	}
+}
+
+SolutionSet make_solution_set(const RCP<const SymEngine::Set>& set, const std::string& method, const Multiplicities& multiplicities) {
+	SolutionSet result;
+	collect_solutions(set, multiplicities, result);
+	result.method = method;
+	result.str = solutions_to_string(set);
+	return result;
+}
+
+// simplify() keeps at most kSimplifyForms distinct forms and applies at most
+// kSimplifyDepth rewrites in sequence to reach any of them.
+const std::size_t kSimplifyForms = 64;
+const int kSimplifyDepth = 4;
+// Largest power of sin or cos that pythagorean() expands, the same limit
+// as the trigonometric normal form; the expansion happens inside a single
+// rewrite, where the budget is not checked.
+const long kMaxPythagoreanPower = 4096;
+
+using CostFunction = double (*)(const Basic&);
+
+double node_count(const Basic& expr) {
+	double count = 1.0;
+	for (const auto& arg : expr.get_args()) {
+		count += node_count(*arg);
 	}
-	if (!SymEngine::eq(*base, *var)) {
-		throw SymbolicError("Unsupported integrand");
+	return count;
+}
+
+// One per binary sum or product, power and function call; one more for a
+// division or a non-integer power.
+double operation_count(const Basic& expr) {
+	const auto args = expr.get_args();
+	double count = 0.0;
+	for (const auto& arg : args) {
+		count += operation_count(*arg);
 	}
-	if (SymEngine::is_a<SymEngine::Integer>(*exponent)) {
-		const auto exp_int = SymEngine::rcp_static_cast<const SymEngine::Integer>(exponent);
-		if (SymEngine::eq(*exponent, *SymEngine::minus_one)) {
-			return SymEngine::log(var);
+	if (SymEngine::is_a<SymEngine::Add>(expr) || SymEngine::is_a<SymEngine::Mul>(expr)) {
+		count += static_cast<double>(args.size() - 1);
+	} else if (SymEngine::is_a<SymEngine::Pow>(expr)) {
+		const auto& exponent = SymEngine::down_cast<const SymEngine::Pow&>(expr).get_exp();
+		count += 1.0;
+		if (!SymEngine::is_a<SymEngine::Integer>(*exponent)) {
+			count += 1.0;
+		} else if (SymEngine::down_cast<const SymEngine::Integer&>(*exponent).is_negative()) {
+			count += 1.0;
 		}
-		const auto exponent_plus_one = SymEngine::add(exponent, SymEngine::one);
-		return SymEngine::div(SymEngine::pow(var, exponent_plus_one), exponent_plus_one);
+	} else if (SymEngine::is_a_sub<SymEngine::Function>(expr)) {
+		count += 1.0;
 	}
-	throw SymbolicError("Unsupported integrand");
+	return count;
 }
 
-RCP<const Basic> integrate_basic(const RCP<const Basic>& expr, const RCP<const Symbol>& var) {
-	if (!SymEngine::has_symbol(*expr, *var)) {
-		return SymEngine::mul(expr, var);
+CostFunction cost_function(const std::string& objective) {
+	if (objective == "ops") {
+		return operation_count;
 	}
-	if (SymEngine::is_a<Symbol>(*expr)) {
-		if (SymEngine::eq(*expr, *var)) {
-			const auto exponent_plus_one = SymEngine::integer(2);
-			return SymEngine::div(SymEngine::pow(var, exponent_plus_one), exponent_plus_one);
-		}
-		return SymEngine::mul(expr, var);
+	if (objective == "nodes") {
+		return node_count;
 	}
+	throw SymbolicError("Unknown simplify objective '" + objective + "'; expected 'ops' or 'nodes'");
+}
+
+// expr with its operands replaced by args. Node types without a generic
+// constructor are returned unchanged.
+RCP<const Basic> rebuild(const RCP<const Basic>& expr, const SymEngine::vec_basic& args) {
 	if (SymEngine::is_a<SymEngine::Add>(*expr)) {
-		return integrate_add(*SymEngine::rcp_static_cast<const SymEngine::Add>(expr), var);
+		return SymEngine::add(args);
 	}
 	if (SymEngine::is_a<SymEngine::Mul>(*expr)) {
-		return integrate_mul(*SymEngine::rcp_static_cast<const SymEngine::Mul>(expr), var);
+		return SymEngine::mul(args);
 	}
 	if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
-		return integrate_pow(*SymEngine::rcp_static_cast<const SymEngine::Pow>(expr), var);
+		return SymEngine::pow(args[0], args[1]);
 	}
-	if (SymEngine::is_a<SymEngine::Sin>(*expr)) {
-		const auto func = SymEngine::rcp_static_cast<const SymEngine::Sin>(expr);
-		const auto arg = func->get_arg();
-		if (!SymEngine::eq(*arg, *var)) {
-			throw SymbolicError("Unsupported integrand");
-		}
-		return SymEngine::mul(SymEngine::minus_one, SymEngine::cos(arg));
+	if (SymEngine::is_a_sub<SymEngine::OneArgFunction>(*expr)) {
+		return SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).create(args[0]);
 	}
-	if (SymEngine::is_a<SymEngine::Cos>(*expr)) {
-		const auto func = SymEngine::rcp_static_cast<const SymEngine::Cos>(expr);
-		const auto arg = func->get_arg();
-		if (!SymEngine::eq(*arg, *var)) {
-			throw SymbolicError("Unsupported integrand");
+	if (SymEngine::is_a_sub<SymEngine::TwoArgFunction>(*expr)) {
+		return SymEngine::down_cast<const SymEngine::TwoArgFunction&>(*expr).create(args[0], args[1]);
+	}
+	if (SymEngine::is_a_sub<SymEngine::MultiArgFunction>(*expr)) {
+		return SymEngine::down_cast<const SymEngine::MultiArgFunction&>(*expr).create(args);
+	}
+	return expr;
+}
+
+// Applies rule to every node, operands before the node built from them.
+template <class Rule>
+RCP<const Basic> map_bottom_up(const RCP<const Basic>& expr, const Rule& rule) {
+	auto args = expr->get_args();
+	bool changed = false;
+	for (auto& arg : args) {
+		auto mapped = map_bottom_up(arg, rule);
+		if (SymEngine::neq(*mapped, *arg)) {
+			arg = mapped;
+			changed = true;
 		}
-		return SymEngine::sin(arg);
 	}
-	if (SymEngine::is_a<SymEngine::FunctionSymbol>(*expr)) {
-		throw SymbolicError("Unsupported integrand");
+	return rule(changed ? rebuild(expr, args) : expr);
+}
+
+// The argument of a one-argument function such as sin or log.
+RCP<const Basic> function_argument(const RCP<const Basic>& expr) {
+	return SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).get_arg();
+}
+
+RCP<const Basic> expand_all(const RCP<const Basic>& expr) {
+	return SymEngine::expand(expr);
+}
+
+// Single fraction p/q in the rational normal form: the multivariate gcd of
+// p and q is divided out and q has a positive leading coefficient.
+// Expressions rational_form rejects are returned unchanged.
+RCP<const Basic> cancel_fraction(const RCP<const Basic>& expr) {
+	try {
+		const auto form = rational_form(expr);
+		return SymEngine::div(form.numerator.get(), form.denominator.get());
+	} catch (const SymbolicError&) {
+		return expr;
 	}
-	throw SymbolicError("Unsupported integrand");
 }
 
-std::string to_string(const RCP<const Basic>& expr) {
-	return expr->__str__();
+// Products and powers of sin and cos as sums over multiple angles.
+RCP<const Basic> multiple_angles(const RCP<const Basic>& expr) {
+	try {
+		return trig_normal_form(expr).get();
+	} catch (const SymbolicError&) {
+		return expr;
+	}
 }
 
-std::string solutions_to_string(const SymEngine::RCP<const SymEngine::Set>& set) {
-	if (SymEngine::is_a<SymEngine::FiniteSet>(*set)) {
-		const auto finite = SymEngine::rcp_static_cast<const SymEngine::FiniteSet>(set);
-		const auto& elements = finite->get_container();
-		if (elements.empty()) {
-			return "[]";
+RCP<const Basic> trig_to_sin_cos(const RCP<const Basic>& expr) {
+	return map_bottom_up(expr, [](const RCP<const Basic>& node) -> RCP<const Basic> {
+		if (SymEngine::is_a<SymEngine::Tan>(*node)) {
+			const auto arg = function_argument(node);
+			return SymEngine::div(SymEngine::sin(arg), SymEngine::cos(arg));
 		}
-		std::vector<std::string> parts;
-		parts.reserve(elements.size());
-		for (const auto& element : elements) {
-			parts.push_back(element->__str__());
+		if (SymEngine::is_a<SymEngine::Cot>(*node)) {
+			const auto arg = function_argument(node);
+			return SymEngine::div(SymEngine::cos(arg), SymEngine::sin(arg));
 		}
-		std::ostringstream oss;
-		oss << "[";
-		for (std::size_t i = 0; i < parts.size(); ++i) {
-			oss << parts[i];
-			if (i + 1 < parts.size()) {
-				oss << ", ";
+		if (SymEngine::is_a<SymEngine::Sec>(*node)) {
+			return SymEngine::div(SymEngine::one, SymEngine::cos(function_argument(node)));
+		}
+		if (SymEngine::is_a<SymEngine::Csc>(*node)) {
+			return SymEngine::div(SymEngine::one, SymEngine::sin(function_argument(node)));
+		}
+		return node;
+	});
+}
+
+// sin(a)^n -> (1 - cos(a)^2)^(n/2) * sin(a)^(n%2) for 2 <= n <=
+// kMaxPythagoreanPower, or the same with sin and cos swapped, then
+// expanded so that the identity cancels.
+RCP<const Basic> pythagorean(const RCP<const Basic>& expr, bool sin_to_cos) {
+	const auto rewritten = map_bottom_up(expr, [sin_to_cos](const RCP<const Basic>& node) -> RCP<const Basic> {
+		if (!SymEngine::is_a<SymEngine::Pow>(*node)) {
+			return node;
+		}
+		const auto& power = SymEngine::down_cast<const SymEngine::Pow&>(*node);
+		const auto& base = power.get_base();
+		const bool matches = sin_to_cos ? SymEngine::is_a<SymEngine::Sin>(*base) : SymEngine::is_a<SymEngine::Cos>(*base);
+		if (!matches || !SymEngine::is_a<SymEngine::Integer>(*power.get_exp())) {
+			return node;
+		}
+		const auto& exponent = SymEngine::down_cast<const SymEngine::Integer&>(*power.get_exp()).as_integer_class();
+		if (exponent < SymEngine::integer_class(2) || exponent > SymEngine::integer_class(kMaxPythagoreanPower)) {
+			return node;
+		}
+		const long n = SymEngine::mp_get_si(exponent);
+		const auto arg = function_argument(base);
+		const auto other = sin_to_cos ? SymEngine::cos(arg) : SymEngine::sin(arg);
+		const auto square = SymEngine::sub(SymEngine::one, SymEngine::pow(other, SymEngine::two));
+		return SymEngine::mul(
+			SymEngine::pow(square, SymEngine::integer(n / 2)),
+			SymEngine::pow(base, SymEngine::integer(n % 2))
+		);
+	});
+	return SymEngine::expand(rewritten);
+}
+
+RCP<const Basic> sin_squared_to_cos(const RCP<const Basic>& expr) {
+	return pythagorean(expr, true);
+}
+
+RCP<const Basic> cos_squared_to_sin(const RCP<const Basic>& expr) {
+	return pythagorean(expr, false);
+}
+
+// sin(a)^k * cos(a)^-k -> tan(a)^k within each product, for integer k;
+// with other k the branches of the powers need not agree.
+RCP<const Basic> fold_tangents(const RCP<const Basic>& expr) {
+	return map_bottom_up(expr, [](const RCP<const Basic>& node) -> RCP<const Basic> {
+		if (!SymEngine::is_a<SymEngine::Mul>(*node)) {
+			return node;
+		}
+		const auto& product = SymEngine::down_cast<const SymEngine::Mul&>(*node);
+		const auto& dict = product.get_dict();
+		const auto paired = [&dict](const RCP<const Basic>& partner, const RCP<const Basic>& exponent) {
+			const auto found = dict.find(partner);
+			return SymEngine::is_a<SymEngine::Integer>(*exponent) && found != dict.end()
+				&& SymEngine::eq(*found->second, *SymEngine::neg(exponent));
+		};
+		SymEngine::vec_basic factors{product.get_coef()};
+		bool folded = false;
+		for (const auto& entry : dict) {
+			const auto& base = entry.first;
+			const auto& exponent = entry.second;
+			if (SymEngine::is_a<SymEngine::Sin>(*base) && paired(SymEngine::cos(function_argument(base)), exponent)) {
+				factors.push_back(SymEngine::pow(SymEngine::tan(function_argument(base)), exponent));
+				folded = true;
+				continue;
 			}
+			if (SymEngine::is_a<SymEngine::Cos>(*base) && paired(SymEngine::sin(function_argument(base)), exponent)) {
+				continue;
+			}
+			factors.push_back(SymEngine::pow(base, exponent));
+		}
+		return folded ? SymEngine::mul(factors) : node;
+	});
+}
+
+// exp(c*log(a) + r) -> a^c * exp(r), and log(c*r) -> log(c) + log(r) for a
+// positive rational c. Both hold on the principal branch.
+RCP<const Basic> contract_exp_log(const RCP<const Basic>& expr) {
+	return map_bottom_up(expr, [](const RCP<const Basic>& node) -> RCP<const Basic> {
+		if (SymEngine::is_a<SymEngine::Pow>(*node)) {
+			const auto& power = SymEngine::down_cast<const SymEngine::Pow&>(*node);
+			if (SymEngine::neq(*power.get_base(), *SymEngine::E)) {
+				return node;
+			}
+			const auto& exponent = power.get_exp();
+			const auto terms = SymEngine::is_a<SymEngine::Add>(*exponent) ? exponent->get_args() : SymEngine::vec_basic{exponent};
+			SymEngine::vec_basic factors;
+			SymEngine::vec_basic rest;
+			for (const auto& term : terms) {
+				RCP<const Basic> logarithm;
+				if (SymEngine::is_a<SymEngine::Log>(*term)) {
+					logarithm = term;
+				} else if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+					for (const auto& entry : SymEngine::down_cast<const SymEngine::Mul&>(*term).get_dict()) {
+						if (SymEngine::is_a<SymEngine::Log>(*entry.first) && SymEngine::eq(*entry.second, *SymEngine::one)) {
+							logarithm = entry.first;
+							break;
+						}
+					}
+				}
+				if (logarithm.is_null()) {
+					rest.push_back(term);
+				} else {
+					factors.push_back(SymEngine::pow(function_argument(logarithm), SymEngine::div(term, logarithm)));
+				}
+			}
+			if (factors.empty()) {
+				return node;
+			}
+			factors.push_back(SymEngine::exp(SymEngine::add(rest)));
+			return SymEngine::mul(factors);
+		}
+		if (SymEngine::is_a<SymEngine::Log>(*node)) {
+			const auto arg = function_argument(node);
+			if (!SymEngine::is_a<SymEngine::Mul>(*arg)) {
+				return node;
+			}
+			const auto& coef = SymEngine::down_cast<const SymEngine::Mul&>(*arg).get_coef();
+			if (!coef->is_exact() || !coef->is_positive() || coef->is_one()) {
+				return node;
+			}
+			return SymEngine::add(SymEngine::log(coef), SymEngine::log(SymEngine::div(arg, coef)));
+		}
+		return node;
+	});
+}
+
+using Rewrite = RCP<const Basic> (*)(const RCP<const Basic>&);
+
+const Rewrite kRewrites[] = {
+	expand_all,
+	cancel_fraction,
+	trig_to_sin_cos,
+	sin_squared_to_cos,
+	cos_squared_to_sin,
+	fold_tangents,
+	contract_exp_log,
+	multiple_angles,
+};
+
+// Verified roots from the bisection scan, with the rest of the equation
+// as a condition: the scan only covers [-kNumericSolveRange,
+// kNumericSolveRange], and inside it too when it ran out of boxes or
+// left clusters it could not verify.
+RCP<const SymEngine::Set> bisection_set(
+	const RCP<const Basic>& equation,
+	const RCP<const Symbol>& symbol,
+	const RealRootsResult& numeric
+) {
+	SymEngine::vec_basic verified;
+	bool exhaustive = numeric.complete;
+	for (const auto& root : numeric.roots) {
+		if (root.verified) {
+			verified.push_back(SymEngine::real_double(root.value));
+		} else {
+			exhaustive = false;
 		}
-		oss << "]";
-		return oss.str();
 	}
-	return set->__str__();
+	RCP<const SymEngine::Boolean> condition = SymEngine::Eq(equation, SymEngine::zero);
+	if (exhaustive) {
+		condition = SymEngine::logical_and({condition, SymEngine::logical_or({
+			SymEngine::Lt(symbol, SymEngine::real_double(-kNumericSolveRange)),
+			SymEngine::Lt(SymEngine::real_double(kNumericSolveRange), symbol)
+		})});
+	}
+	return SymEngine::set_union({finite_set(verified), SymEngine::conditionset(symbol, condition)});
+}
+
+SolutionSet solve_parsed(const RCP<const Basic>& equation, const RCP<const Symbol>& symbol) {
+	DensePoly poly;
+	Multiplicities multiplicities;
+	SymEngine::vec_basic roots;
+	if (DensePoly::from_basic(equation, symbol, poly) && poly.degree() >= 1) {
+		// Roots of the factor of multiplicity i + 1 have multiplicity i + 1.
+		const auto factors = poly.square_free();
+		for (std::size_t i = 0; i < factors.size(); ++i) {
+			for (const auto& root : polynomial_roots(factors[i])) {
+				roots.push_back(root);
+				multiplicities[root] = static_cast<int>(i) + 1;
+			}
+		}
+		return make_solution_set(finite_set(roots), "polynomial", multiplicities);
+	}
+	RCP<const SymEngine::Set> result_set;
+	std::string solve_error;
+	try {
+		result_set = SymEngine::solve(equation, symbol);
+	} catch (const SymEngine::SymEngineException& ex) {
+		solve_error = ex.what();
+	}
+	if (!result_set.is_null() && SymEngine::is_a<SymEngine::FiniteSet>(*result_set)) {
+		return make_solution_set(result_set, "symengine", multiplicities);
+	}
+	// Polynomials SymEngine cannot solve in closed form (degree >= 5 with
+	// float coefficients) come back as a ConditionSet; solve numerically.
+	std::vector<int> numeric_multiplicities;
+	if (numeric_polynomial_roots(equation, symbol, roots, &numeric_multiplicities)) {
+		for (std::size_t i = 0; i < roots.size(); ++i) {
+			multiplicities[roots[i]] = numeric_multiplicities[i];
+		}
+		return make_solution_set(finite_set(roots), "numeric_polynomial", multiplicities);
+	}
+	// Transcendental equations: real roots by interval bisection.
+	if (result_set.is_null() || SymEngine::is_a<SymEngine::ConditionSet>(*result_set)) {
+		try {
+			const auto numeric = find_real_roots(equation, symbol, -kNumericSolveRange, kNumericSolveRange);
+			if (!numeric.roots.empty()) {
+				return make_solution_set(bisection_set(equation, symbol, numeric), "interval_bisection", multiplicities);
+			}
+		} catch (const NumericError&) {
+		}
+	}
+	if (result_set.is_null()) {
+		throw SymbolicError(solve_error);
+	}
+	return make_solution_set(result_set, "symengine", multiplicities);
 }
 
 }
@@ -166,8 +488,24 @@ std::string integrate(const std::string& expr, const std::string& var) {
 	try {
 		const auto parsed = parse_expression(expr);
 		const auto symbol = make_symbol(var);
-		const auto result = integrate_basic(parsed, symbol);
+		// Integrands that differ only in variable names share one entry.
+		const auto canonical = alpha_canonicalize({parsed}, {var});
+		AlphaCachedResult cached;
+		if (alpha_cache_lookup("integrate", canonical.key, cached)) {
+			return to_string(canonical.to_caller(cached.values[0]));
+		}
+		RCP<const Basic> result;
+		DensePoly poly;
+		if (DensePoly::from_expanded(parsed, symbol, poly)) {
+			result = poly.antiderivative().to_basic(symbol);
+		} else {
+			IntegrationContext ctx;
+			result = integrate_expr(parsed, symbol, ctx);
+		}
+		alpha_cache_store("integrate", canonical.key, AlphaCachedResult{{canonical.to_canonical(result)}, {}, "", false});
 		return to_string(result);
+	} catch (const SymbolicError&) {
+		throw;
 	} catch (const SymEngine::SymEngineException& ex) {
 		throw SymbolicError(ex.what());
 	} catch (const std::exception& ex) {
@@ -179,7 +517,19 @@ std::string diff(const std::string& expr, const std::string& var) {
 	try {
 		const auto parsed = parse_expression(expr);
 		const auto symbol = make_symbol(var);
-		const auto result = SymEngine::diff(parsed, symbol, false);
+		const auto canonical = alpha_canonicalize({parsed}, {var});
+		AlphaCachedResult cached;
+		if (alpha_cache_lookup("diff", canonical.key, cached)) {
+			return to_string(canonical.to_caller(cached.values[0]));
+		}
+		RCP<const Basic> result;
+		DensePoly poly;
+		if (DensePoly::from_expanded(parsed, symbol, poly)) {
+			result = poly.derivative().to_basic(symbol);
+		} else {
+			result = SymEngine::diff(parsed, symbol, false);
+		}
+		alpha_cache_store("diff", canonical.key, AlphaCachedResult{{canonical.to_canonical(result)}, {}, "", false});
 		return to_string(result);
 	} catch (const SymEngine::SymEngineException& ex) {
 		throw SymbolicError(ex.what());
@@ -188,14 +538,36 @@ std::string diff(const std::string& expr, const std::string& var) {
 	}
 }
 
-std::string solve_equation(const std::string& lhs, const std::string& rhs, const std::string& var) {
+SolutionSet solve_equation_set(const std::string& lhs, const std::string& rhs, const std::string& var) {
 	try {
 		const auto parsed_lhs = parse_expression(lhs);
 		const auto parsed_rhs = parse_expression(rhs);
 		const auto symbol = make_symbol(var);
-		const auto equation = SymEngine::sub(parsed_lhs, parsed_rhs);
-		const auto result_set = SymEngine::solve(equation, symbol);
-		return solutions_to_string(result_set);
+		const auto canonical = alpha_canonicalize({parsed_lhs, parsed_rhs}, {var});
+		AlphaCachedResult cached;
+		if (alpha_cache_lookup("solve", canonical.key, cached)) {
+			SymEngine::vec_basic roots;
+			Multiplicities multiplicities;
+			for (std::size_t i = 0; i < cached.values.size(); ++i) {
+				roots.push_back(canonical.to_caller(cached.values[i]));
+				multiplicities[roots.back()] = cached.multiplicities[i];
+			}
+			return make_solution_set(finite_set(roots), cached.method, multiplicities);
+		}
+		auto result = solve_parsed(SymEngine::sub(parsed_lhs, parsed_rhs), symbol);
+		// Only finite solution sets are kept; they carry everything
+		// make_solution_set needs to rebuild the result.
+		if (result.intervals.empty() && result.conditions.empty()) {
+			AlphaCachedResult entry{{}, {}, result.method, false};
+			for (const auto& element : result.elements) {
+				entry.values.push_back(canonical.to_canonical(element.value.get()));
+				entry.multiplicities.push_back(element.multiplicity);
+			}
+			alpha_cache_store("solve", canonical.key, entry);
+		}
+		return result;
+	} catch (const SymbolicError&) {
+		throw;
 	} catch (const SymEngine::SymEngineException& ex) {
 		throw SymbolicError(ex.what());
 	} catch (const std::exception& ex) {
@@ -203,12 +575,31 @@ std::string solve_equation(const std::string& lhs, const std::string& rhs, const
 	}
 }
 
+std::string solve_equation(const std::string& lhs, const std::string& rhs, const std::string& var) {
+	return solve_equation_set(lhs, rhs, var).str;
+}
+
 bool verify_equal(const std::string& lhs, const std::string& rhs, double timeout_ms) {
 	auto start = std::chrono::steady_clock::now();
 	
 	try {
-		const auto parsed_lhs = parse_expression(lhs);
-		const auto parsed_rhs = parse_expression(rhs);
+		// Interned, structurally equal sides are one node.
+		const auto parsed_lhs = intern(parse_expression(lhs));
+		const auto parsed_rhs = intern(parse_expression(rhs));
+		if (parsed_lhs.get() == parsed_rhs.get()) {
+			return true;
+		}
+		const auto canonical = alpha_canonicalize({parsed_lhs, parsed_rhs});
+		AlphaCachedResult cached;
+		if (alpha_cache_lookup("verify_equal", canonical.key, cached)) {
+			return cached.verdict;
+		}
+		// Verdicts of the exact tiers are kept; an e-graph miss may only
+		// mean its budget ran out.
+		const auto remember = [&canonical](bool verdict) {
+			alpha_cache_store("verify_equal", canonical.key, AlphaCachedResult{{}, {}, "", verdict});
+			return verdict;
+		};
 		
 		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
 			std::chrono::steady_clock::now() - start
@@ -229,11 +620,31 @@ bool verify_equal(const std::string& lhs, const std::string& rhs, double timeout
 			throw VerifierError("Verification timeout exceeded");
 		}
 		
-		auto tribool_result = SymEngine::is_zero(*simplified);
-		if (tribool_result == SymEngine::tribool::indeterminate) {
-			return false;
+		if (SymEngine::is_zero(*simplified) == SymEngine::tribool::tritrue) {
+			return remember(true);
+		}
+		
+		// Rational identities are decided by the normal form; a verdict of
+		// different is final only when every generator is a symbol.
+		const auto verdict = rational_equal(parsed_lhs, parsed_rhs);
+		if (verdict != SymEngine::tribool::indeterminate) {
+			return remember(verdict == SymEngine::tribool::tritrue);
+		}
+		// Polynomials in sin, cos and tan of linear arguments compare
+		// coefficient by coefficient in the exponential form.
+		const auto trig_verdict = trig_equal(parsed_lhs, parsed_rhs);
+		if (trig_verdict != SymEngine::tribool::indeterminate) {
+			return remember(trig_verdict == SymEngine::tribool::tritrue);
+		}
+		
+		// expand() knows no identities between functions. Equality
+		// saturation gets its default budget or the time left, if less.
+		SaturationBudget budget;
+		budget.time_ms = std::min(budget.time_ms, timeout_ms - static_cast<double>(elapsed));
+		if (egraph_equivalent(parsed_lhs, parsed_rhs, budget).equal) {
+			return remember(true);
 		}
-		return static_cast<bool>(tribool_result);
+		return false;
 	} catch (const VerifierError&) {
 		throw;
 	} catch (const SymEngine::SymEngineException& ex) {
@@ -243,4 +654,55 @@ bool verify_equal(const std::string& lhs, const std::string& rhs, double timeout
 	}
 }
 
+std::string simplify(const std::string& expr, double budget_ms, const std::string& objective) {
+	const CostFunction cost = cost_function(objective);
+	const auto start = std::chrono::steady_clock::now();
+	const auto elapsed_ms = [&start]() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+	try {
+		const auto parsed = parse_expression(expr);
+		// Breadth-first over rewrite sequences, so that among forms of equal
+		// cost the one closest to the input wins.
+		SymEngine::set_basic seen{parsed};
+		std::deque<std::pair<RCP<const Basic>, int>> pending{{parsed, 0}};
+		RCP<const Basic> best = parsed;
+		double best_cost = cost(*parsed);
+		while (!pending.empty() && seen.size() < kSimplifyForms) {
+			const auto form = pending.front().first;
+			const int depth = pending.front().second;
+			pending.pop_front();
+			if (depth >= kSimplifyDepth) {
+				continue;
+			}
+			for (const auto rewrite : kRewrites) {
+				if (elapsed_ms() >= budget_ms) {
+					return to_string(best);
+				}
+				const auto candidate = rewrite(form);
+				if (!seen.insert(candidate).second) {
+					continue;
+				}
+				const double candidate_cost = cost(*candidate);
+				if (candidate_cost < best_cost) {
+					best = candidate;
+					best_cost = candidate_cost;
+				}
+				pending.emplace_back(candidate, depth + 1);
+			}
+		}
+		return to_string(best);
+	} catch (const SymbolicError&) {
+		throw;
+	} catch (const SymEngine::SymEngineException& ex) {
+		throw SymbolicError(ex.what());
+	} catch (const std::exception& ex) {
+		throw SymbolicError(ex.what());
+	}
+}
+
+double expression_cost(const SymEngine::Basic& expr, const std::string& objective) {
+	return cost_function(objective)(expr);
+}
+
 }
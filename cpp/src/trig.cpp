@@ -0,0 +1,464 @@
+#include "mathllm/trig.h"
+
+#include <symengine/add.h>
+#include <symengine/constants.h>
+#include <symengine/functions.h>
+#include <symengine/integer.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+#include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/symbol.h>
+#include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+
+namespace mathllm {
+
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::integer_class;
+using SymEngine::rational_class;
+
+// Terms a single expansion may hold before the pass gives up; powers of
+// sums of many angles grow combinatorially.
+const std::size_t kMaxTerms = 4096;
+// Largest integer power expanded; sin(u)^n alone has n + 1 terms.
+const unsigned long kMaxExponent = kMaxTerms;
+
+// An angle as rational multiples of monomials, the constant part on the
+// monomial 1. Zero multiples are never stored, so equal angles compare
+// equal.
+using Frequency = std::map<RCP<const Basic>, rational_class, SymEngine::RCPBasicKeyLess>;
+
+struct FrequencyLess {
+    bool operator()(const Frequency& a, const Frequency& b) const {
+        const SymEngine::RCPBasicKeyLess less;
+        return std::lexicographical_compare(
+            a.begin(), a.end(), b.begin(), b.end(),
+            [&less](const Frequency::value_type& x, const Frequency::value_type& y) {
+                if (less(x.first, y.first)) {
+                    return true;
+                }
+                if (less(y.first, x.first)) {
+                    return false;
+                }
+                return x.second < y.second;
+            }
+        );
+    }
+};
+
+// Laurent polynomial in the exponentials: frequency u stands for
+// exp(I*u). Coefficients are any expressions free of those exponentials.
+using ExpPoly = std::map<Frequency, RCP<const Basic>, FrequencyLess>;
+
+struct Fraction {
+    ExpPoly num;
+    ExpPoly den;
+};
+
+RCP<const Basic> parse_expression(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw SymbolicError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+bool vanishes(const rational_class& q) {
+    return SymEngine::mp_sign(SymEngine::get_num(q)) == 0;
+}
+
+void accumulate(Frequency& freq, const RCP<const Basic>& atom, const rational_class& multiple) {
+    auto it = freq.find(atom);
+    if (it == freq.end()) {
+        if (!vanishes(multiple)) {
+            freq.emplace(atom, multiple);
+        }
+        return;
+    }
+    it->second += multiple;
+    if (vanishes(it->second)) {
+        freq.erase(it);
+    }
+}
+
+Frequency negate(const Frequency& freq) {
+    Frequency result;
+    for (const auto& entry : freq) {
+        result.emplace(entry.first, -entry.second);
+    }
+    return result;
+}
+
+// exp(I*pi*f) is 1, I, -1 or -I when 2*f is an integer and goes into the
+// coefficient; any other multiple of pi stays, reduced modulo 2.
+void fold_pi(Frequency& freq, RCP<const Basic>& coef) {
+    auto it = freq.find(SymEngine::pi);
+    if (it == freq.end()) {
+        return;
+    }
+    const integer_class den = SymEngine::get_den(it->second);
+    integer_class rest;
+    SymEngine::mp_fdiv_r(rest, SymEngine::get_num(it->second), integer_class(2) * den);
+    const rational_class reduced = rational_class(rest) / rational_class(den);
+    const rational_class twice = reduced * rational_class(2);
+    if (SymEngine::get_den(twice) == integer_class(1)) {
+        const RCP<const Basic> units[] = {
+            SymEngine::one, SymEngine::I, SymEngine::minus_one, SymEngine::neg(SymEngine::I),
+        };
+        coef = SymEngine::mul(coef, units[SymEngine::mp_get_ui(SymEngine::get_num(twice))]);
+        freq.erase(it);
+        return;
+    }
+    it->second = reduced;
+}
+
+void add_term(ExpPoly& poly, const Frequency& freq, const RCP<const Basic>& coef) {
+    if (SymEngine::is_number_and_zero(*coef)) {
+        return;
+    }
+    auto it = poly.find(freq);
+    if (it == poly.end()) {
+        if (poly.size() >= kMaxTerms) {
+            throw SymbolicError("Trigonometric expansion exceeds the term limit");
+        }
+        poly.emplace(freq, coef);
+        return;
+    }
+    it->second = SymEngine::add(it->second, coef);
+    if (SymEngine::is_number_and_zero(*it->second)) {
+        poly.erase(it);
+    }
+}
+
+ExpPoly constant(const RCP<const Basic>& value) {
+    ExpPoly result;
+    add_term(result, Frequency(), value);
+    return result;
+}
+
+ExpPoly exponential(Frequency freq, RCP<const Basic> coef) {
+    fold_pi(freq, coef);
+    ExpPoly result;
+    add_term(result, freq, coef);
+    return result;
+}
+
+bool is_one(const ExpPoly& poly) {
+    return poly.size() == 1 && poly.begin()->first.empty()
+        && SymEngine::eq(*poly.begin()->second, *SymEngine::one);
+}
+
+ExpPoly add(const ExpPoly& a, const ExpPoly& b) {
+    ExpPoly result = a;
+    for (const auto& term : b) {
+        add_term(result, term.first, term.second);
+    }
+    return result;
+}
+
+ExpPoly sub(const ExpPoly& a, const ExpPoly& b) {
+    ExpPoly result = a;
+    for (const auto& term : b) {
+        add_term(result, term.first, SymEngine::neg(term.second));
+    }
+    return result;
+}
+
+ExpPoly mul(const ExpPoly& a, const ExpPoly& b) {
+    if (is_one(a)) {
+        return b;
+    }
+    if (is_one(b)) {
+        return a;
+    }
+    ExpPoly result;
+    for (const auto& x : a) {
+        for (const auto& y : b) {
+            Frequency freq = x.first;
+            for (const auto& entry : y.first) {
+                accumulate(freq, entry.first, entry.second);
+            }
+            RCP<const Basic> coef = SymEngine::mul(x.second, y.second);
+            fold_pi(freq, coef);
+            add_term(result, freq, coef);
+        }
+    }
+    return result;
+}
+
+ExpPoly power(ExpPoly base, unsigned long exponent) {
+    ExpPoly result = constant(SymEngine::one);
+    while (exponent > 0) {
+        if (exponent & 1UL) {
+            result = mul(result, base);
+        }
+        exponent >>= 1;
+        if (exponent > 0) {
+            base = mul(base, base);
+        }
+    }
+    return result;
+}
+
+// Splits arg, once expanded, into rational multiples of monomials. A term
+// with an irrational or complex coefficient becomes a monomial of its own
+// and clears exact.
+Frequency angle(const RCP<const Basic>& arg, bool& exact) {
+    exact = true;
+    const auto expanded = SymEngine::expand(arg);
+    const SymEngine::vec_basic terms = SymEngine::is_a<SymEngine::Add>(*expanded)
+        ? expanded->get_args()
+        : SymEngine::vec_basic{expanded};
+    Frequency freq;
+    for (const auto& term : terms) {
+        RCP<const Basic> coef = SymEngine::one;
+        RCP<const Basic> atom = term;
+        if (SymEngine::is_a_Number(*term)) {
+            coef = term;
+            atom = SymEngine::one;
+        } else if (SymEngine::is_a<SymEngine::Mul>(*term)) {
+            coef = SymEngine::down_cast<const SymEngine::Mul&>(*term).get_coef();
+            atom = SymEngine::div(term, coef);
+        }
+        if (SymEngine::is_a<SymEngine::Integer>(*coef)) {
+            const auto& value = SymEngine::down_cast<const SymEngine::Integer&>(*coef).as_integer_class();
+            accumulate(freq, atom, rational_class(value));
+        } else if (SymEngine::is_a<SymEngine::Rational>(*coef)) {
+            accumulate(freq, atom, SymEngine::down_cast<const SymEngine::Rational&>(*coef).as_rational_class());
+        } else {
+            exact = false;
+            accumulate(freq, term, rational_class(1));
+        }
+    }
+    return freq;
+}
+
+// sin u = (z - 1/z)/(2*I) and cos u = (z + 1/z)/2 with z = exp(I*u).
+ExpPoly sine(const Frequency& freq) {
+    const auto half = SymEngine::rational(1, 2);
+    return add(
+        exponential(freq, SymEngine::mul(SymEngine::neg(half), SymEngine::I)),
+        exponential(negate(freq), SymEngine::mul(half, SymEngine::I))
+    );
+}
+
+ExpPoly cosine(const Frequency& freq) {
+    const auto half = SymEngine::rational(1, 2);
+    return add(exponential(freq, half), exponential(negate(freq), half));
+}
+
+Fraction invert(const Fraction& fraction) {
+    if (fraction.num.empty()) {
+        throw SymbolicError("Division by zero");
+    }
+    return Fraction{fraction.den, fraction.num};
+}
+
+// True if a coefficient holds a trigonometric function that convert() left
+// inside some other head, as in abs(sin(x)).
+bool hides_trig(const Basic& expr) {
+    if (SymEngine::is_a_sub<SymEngine::TrigFunction>(expr)) {
+        return true;
+    }
+    for (const auto& arg : expr.get_args()) {
+        if (hides_trig(*arg)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hides_trig(const ExpPoly& poly) {
+    return std::any_of(poly.begin(), poly.end(), [](const ExpPoly::value_type& term) {
+        return hides_trig(*term.second);
+    });
+}
+
+Fraction convert(const RCP<const Basic>& expr) {
+    const ExpPoly one = constant(SymEngine::one);
+    if (SymEngine::is_a<SymEngine::Add>(*expr)) {
+        Fraction sum{ExpPoly(), one};
+        for (const auto& arg : expr->get_args()) {
+            const Fraction term = convert(arg);
+            if (is_one(term.den)) {
+                sum.num = add(sum.num, mul(term.num, sum.den));
+            } else {
+                sum.num = add(mul(sum.num, term.den), mul(term.num, sum.den));
+                sum.den = mul(sum.den, term.den);
+            }
+        }
+        return sum;
+    }
+    if (SymEngine::is_a<SymEngine::Mul>(*expr)) {
+        Fraction product{one, one};
+        for (const auto& arg : expr->get_args()) {
+            const Fraction factor = convert(arg);
+            product.num = mul(product.num, factor.num);
+            product.den = mul(product.den, factor.den);
+        }
+        return product;
+    }
+    if (SymEngine::is_a<SymEngine::Pow>(*expr)) {
+        const auto& pow = SymEngine::down_cast<const SymEngine::Pow&>(*expr);
+        if (SymEngine::is_a<SymEngine::Integer>(*pow.get_exp())) {
+            const auto& exponent = SymEngine::down_cast<const SymEngine::Integer&>(*pow.get_exp());
+            Fraction base = convert(pow.get_base());
+            if (exponent.is_negative()) {
+                base = invert(base);
+            }
+            integer_class magnitude;
+            SymEngine::mp_abs(magnitude, exponent.as_integer_class());
+            if (magnitude > integer_class(kMaxExponent)) {
+                throw SymbolicError("Trigonometric expansion exceeds the exponent limit");
+            }
+            const unsigned long e = SymEngine::mp_get_ui(magnitude);
+            return Fraction{power(base.num, e), power(base.den, e)};
+        }
+        // exp(I*u) is the monomial of u when u is a rational combination.
+        if (SymEngine::eq(*pow.get_base(), *SymEngine::E)) {
+            bool exact = false;
+            const Frequency freq = angle(SymEngine::div(pow.get_exp(), SymEngine::I), exact);
+            if (exact) {
+                return Fraction{exponential(freq, SymEngine::one), one};
+            }
+        }
+        return Fraction{constant(expr), one};
+    }
+    if (SymEngine::is_a_sub<SymEngine::TrigFunction>(*expr)) {
+        bool exact = false;
+        const auto arg = SymEngine::down_cast<const SymEngine::OneArgFunction&>(*expr).get_arg();
+        const Frequency freq = angle(arg, exact);
+        if (SymEngine::is_a<SymEngine::Sin>(*expr)) {
+            return Fraction{sine(freq), one};
+        }
+        if (SymEngine::is_a<SymEngine::Cos>(*expr)) {
+            return Fraction{cosine(freq), one};
+        }
+        if (SymEngine::is_a<SymEngine::Tan>(*expr)) {
+            return Fraction{sine(freq), cosine(freq)};
+        }
+        if (SymEngine::is_a<SymEngine::Cot>(*expr)) {
+            return Fraction{cosine(freq), sine(freq)};
+        }
+        if (SymEngine::is_a<SymEngine::Sec>(*expr)) {
+            return Fraction{one, cosine(freq)};
+        }
+        if (SymEngine::is_a<SymEngine::Csc>(*expr)) {
+            return Fraction{one, sine(freq)};
+        }
+    }
+    return Fraction{constant(expr), one};
+}
+
+RCP<const Basic> angle_to_basic(const Frequency& freq) {
+    SymEngine::vec_basic terms;
+    for (const auto& entry : freq) {
+        terms.push_back(SymEngine::mul(SymEngine::Rational::from_mpq(entry.second), entry.first));
+    }
+    return SymEngine::add(terms);
+}
+
+// Orientation of the pair u, -u that is written out: the one whose first
+// multiple outside pi is positive.
+bool leads_positive(const Frequency& freq) {
+    for (const auto& entry : freq) {
+        if (!SymEngine::eq(*entry.first, *SymEngine::pi)) {
+            return SymEngine::mp_sign(SymEngine::get_num(entry.second)) > 0;
+        }
+    }
+    return true;
+}
+
+// a*exp(I*u) + b*exp(-I*u) is written (a + b)*cos(u) + I*(a - b)*sin(u).
+RCP<const Basic> to_basic(const ExpPoly& poly) {
+    ExpPoly rest = poly;
+    SymEngine::vec_basic terms;
+    while (!rest.empty()) {
+        Frequency freq = rest.begin()->first;
+        RCP<const Basic> a = rest.begin()->second;
+        rest.erase(rest.begin());
+        if (freq.empty()) {
+            terms.push_back(SymEngine::expand(a));
+            continue;
+        }
+        Frequency opposite = negate(freq);
+        RCP<const Basic> unit = SymEngine::one;
+        fold_pi(opposite, unit);
+        RCP<const Basic> b = SymEngine::zero;
+        auto it = rest.find(opposite);
+        if (it != rest.end()) {
+            b = it->second;
+            rest.erase(it);
+        }
+        if (!leads_positive(freq)) {
+            std::swap(freq, opposite);
+            std::swap(a, b);
+        }
+        const auto theta = angle_to_basic(freq);
+        terms.push_back(SymEngine::mul(SymEngine::expand(SymEngine::add(a, b)), SymEngine::cos(theta)));
+        terms.push_back(SymEngine::mul(
+            SymEngine::expand(SymEngine::mul(SymEngine::I, SymEngine::sub(a, b))),
+            SymEngine::sin(theta)
+        ));
+    }
+    return SymEngine::add(terms);
+}
+
+}
+
+Expression trig_normal_form(const RCP<const Basic>& expr) {
+    try {
+        const Fraction fraction = convert(expr);
+        return Expression(SymEngine::div(to_basic(fraction.num), to_basic(fraction.den)));
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw SymbolicError(ex.what());
+    }
+}
+
+std::string trig_canonical(const std::string& expr) {
+    return trig_normal_form(parse_expression(expr)).str();
+}
+
+SymEngine::tribool trig_equal(const RCP<const Basic>& lhs, const RCP<const Basic>& rhs) {
+    try {
+        const Fraction a = convert(lhs);
+        const Fraction b = convert(rhs);
+        const ExpPoly difference = sub(mul(a.num, b.den), mul(b.num, a.den));
+        bool equal = true;
+        bool decided = true;
+        for (const auto& term : difference) {
+            const auto coef = SymEngine::expand(term.second);
+            if (SymEngine::is_zero(*coef) == SymEngine::tribool::tritrue) {
+                continue;
+            }
+            equal = false;
+            // A nonzero exact coefficient settles it only on frequencies
+            // over independent symbols.
+            decided = decided && SymEngine::is_a_Number(*coef)
+                && SymEngine::down_cast<const SymEngine::Number&>(*coef).is_exact()
+                && std::all_of(term.first.begin(), term.first.end(), [](const Frequency::value_type& entry) {
+                    return SymEngine::is_a<SymEngine::Symbol>(*entry.first);
+                });
+        }
+        if (equal) {
+            return SymEngine::tribool::tritrue;
+        }
+        // Trigonometric functions the normal form did not reach may still
+        // cancel the difference.
+        decided = decided && !hides_trig(a.num) && !hides_trig(a.den) && !hides_trig(b.num) && !hides_trig(b.den);
+        return decided ? SymEngine::tribool::trifalse : SymEngine::tribool::indeterminate;
+    } catch (const std::exception&) {
+        return SymEngine::tribool::indeterminate;
+    }
+}
+
+}
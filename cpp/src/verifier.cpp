@@ -1,20 +1,126 @@
 #include "mathllm/verifier.h"
+#include "mathllm/numeric.h"
+#include "mathllm/rational.h"
+#include "mathllm/trig.h"
 
 #include <symengine/add.h>
 #include <symengine/constants.h>
+#include <symengine/eval_double.h>
 #include <symengine/parser.h>
 #include <symengine/simplify.h>
 #include <symengine/symbol.h>
 #include <symengine/symengine_exception.h>
+#include <symengine/visitor.h>
 
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include <stdexcept>
 
 namespace mathllm {
 
+namespace {
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+
+const int kCheckTrials = 10;
+const unsigned int kCheckSeed = 42;
+const double kCheckTolerance = 1e-8;
+
+RCP<const Basic> parse_checked(const std::string& expr) {
+    try {
+        return SymEngine::parse(expr);
+    } catch (const std::exception& ex) {
+        throw VerifierError(std::string("Parse error: ") + ex.what());
+    }
+}
+
+RCP<const Basic> diff_checked(const RCP<const Basic>& expr, const std::string& var) {
+    try {
+        return SymEngine::diff(expr, SymEngine::symbol(var));
+    } catch (const SymEngine::SymEngineException& ex) {
+        throw VerifierError(std::string("Differentiation error: ") + ex.what());
+    }
+}
+
+// Decides residual == 0: exactly when expand() cancels it or it vanishes
+// as a rational function of its subterms or in the exponential form of
+// its sines and cosines, otherwise by evaluating |residual| / (1 + |scale|)
+// at random points (once, in complex arithmetic, when there are no free
+// symbols). Points where either side is not finite are skipped; at least
+// half must survive.
+CheckResult check_residual(const RCP<const Basic>& residual, const RCP<const Basic>& scale) {
+    const auto expanded = SymEngine::expand(residual);
+    if (SymEngine::is_zero(*expanded) == SymEngine::tribool::tritrue) {
+        return CheckResult{true, "symbolic", "0", 0.0, 0};
+    }
+    if (rational_equal(residual, SymEngine::zero) == SymEngine::tribool::tritrue
+        || trig_equal(residual, SymEngine::zero) == SymEngine::tribool::tritrue) {
+        return CheckResult{true, "symbolic", "0", 0.0, 0};
+    }
+
+    std::vector<std::string> symbols;
+    for (const auto& sym : SymEngine::free_symbols(*SymEngine::add(residual, scale))) {
+        symbols.push_back(SymEngine::rcp_static_cast<const SymEngine::Symbol>(sym)->get_name());
+    }
+    std::sort(symbols.begin(), symbols.end());
+    if (symbols.empty()) {
+        // Closed-form values such as substituted roots may be complex.
+        try {
+            const double error = std::abs(SymEngine::eval_complex_double(*residual))
+                / (1.0 + std::abs(SymEngine::eval_complex_double(*scale)));
+            const bool ok = std::isfinite(error) && error <= kCheckTolerance;
+            return CheckResult{ok, ok ? "numeric" : "failed", expanded->__str__(), error, 1};
+        } catch (const SymEngine::SymEngineException&) {
+            return CheckResult{false, "failed", expanded->__str__(), 0.0, 0};
+        }
+    }
+    const std::size_t dim = symbols.size();
+
+    std::mt19937 rng(kCheckSeed);
+    std::uniform_real_distribution<double> dist(0.5, 2.0);
+    std::vector<double> points(kCheckTrials * dim);
+    for (double& value : points) {
+        value = dist(rng);
+    }
+    std::vector<double> residual_values(kCheckTrials);
+    std::vector<double> scale_values(kCheckTrials);
+    try {
+        CompiledExpr(residual, symbols).evaluate_batch(points.data(), kCheckTrials, residual_values.data());
+        CompiledExpr(scale, symbols).evaluate_batch(points.data(), kCheckTrials, scale_values.data());
+    } catch (const NumericError&) {
+        return CheckResult{false, "failed", expanded->__str__(), 0.0, 0};
+    }
+
+    int valid = 0;
+    double max_error = 0.0;
+    for (int i = 0; i < kCheckTrials; ++i) {
+        if (!std::isfinite(residual_values[i]) || !std::isfinite(scale_values[i])) {
+            continue;
+        }
+        ++valid;
+        max_error = std::max(max_error, std::abs(residual_values[i]) / (1.0 + std::abs(scale_values[i])));
+    }
+    const bool ok = 2 * valid >= kCheckTrials && max_error <= kCheckTolerance;
+    return CheckResult{ok, ok ? "numeric" : "failed", expanded->__str__(), max_error, valid};
+}
+
+}
+
 bool verify_equal(const std::string& lhs, const std::string& rhs) {
     try {
         auto lhs_expr = SymEngine::parse(lhs);
         auto rhs_expr = SymEngine::parse(rhs);
+        // The rational and trigonometric normal forms settle their classes
+        // of identities outright; simplify() is left for the rest.
+        auto verdict = rational_equal(lhs_expr, rhs_expr);
+        if (verdict == SymEngine::tribool::indeterminate) {
+            verdict = trig_equal(lhs_expr, rhs_expr);
+        }
+        if (verdict != SymEngine::tribool::indeterminate) {
+            return verdict == SymEngine::tribool::tritrue;
+        }
         auto diff_expr = SymEngine::simplify(SymEngine::sub(lhs_expr, rhs_expr));
         return SymEngine::eq(*diff_expr, *SymEngine::integer(0));
     } catch (const SymEngine::SymEngineException& ex) {
@@ -24,4 +130,49 @@ bool verify_equal(const std::string& lhs, const std::string& rhs) {
     }
 }
 
+CheckResult check_antiderivative(const std::string& F, const std::string& f, const std::string& var) {
+    const auto antiderivative = parse_checked(F);
+    const auto integrand = parse_checked(f);
+    const auto derivative = diff_checked(antiderivative, var);
+    return check_residual(SymEngine::sub(derivative, integrand), integrand);
+}
+
+RootCheckResult check_roots(const std::string& expr, const std::string& var, const std::vector<std::string>& roots) {
+    const auto parsed = parse_checked(expr);
+    const auto symbol = SymEngine::symbol(var);
+    // Residuals are measured against the sum of the term magnitudes so that
+    // large roots of high-degree polynomials are not rejected for rounding.
+    const auto expanded = SymEngine::expand(parsed);
+    SymEngine::vec_basic terms = SymEngine::is_a<SymEngine::Add>(*expanded)
+        ? expanded->get_args()
+        : SymEngine::vec_basic{expanded};
+
+    RootCheckResult result{true, {}};
+    for (const auto& root_str : roots) {
+        const auto root = parse_checked(root_str);
+        SymEngine::map_basic_basic subs{{symbol, root}};
+        SymEngine::vec_basic magnitudes;
+        for (const auto& term : terms) {
+            magnitudes.push_back(SymEngine::abs(term->subs(subs)));
+        }
+        auto check = check_residual(parsed->subs(subs), SymEngine::add(magnitudes));
+        result.ok = result.ok && check.ok;
+        result.roots.push_back(std::move(check));
+    }
+    return result;
+}
+
+CheckResult check_ode_solution(
+    const std::string& y_expr,
+    const std::string& rhs,
+    const std::string& t,
+    const std::string& y
+) {
+    const auto solution = parse_checked(y_expr);
+    const auto slope = parse_checked(rhs);
+    const auto derivative = diff_checked(solution, t);
+    SymEngine::map_basic_basic subs{{SymEngine::symbol(y), solution}};
+    return check_residual(SymEngine::sub(derivative, slope->subs(subs)), derivative);
+}
+
 }
@@ -0,0 +1,130 @@
+#include "mathllm/canonical.h"
+#include "mathllm/solution_set.h"
+#include "mathllm/symbolic.h"
+
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace {
+
+mathllm::CanonicalKey key_of(const std::string& expr, const std::string& var) {
+    return mathllm::alpha_canonicalize(expr, {var}).key;
+}
+
+// Result of call with the alpha cache out of the way; disabling the cache
+// empties it.
+template <class Call>
+auto uncached(Call call) -> decltype(call()) {
+    mathllm::set_alpha_cache_capacity(0);
+    auto result = call();
+    mathllm::set_alpha_cache_capacity(4096);
+    return result;
+}
+
+}
+
+void test_renamed_problems_share_key() {
+    const auto first = mathllm::alpha_canonicalize("x^2*sin(x)", {"x"});
+    const auto second = mathllm::alpha_canonicalize("t^2*sin(t)", {"t"});
+    assert(first.key == second.key);
+    assert(first.exprs[0].str() == second.exprs[0].str());
+    assert(first.renaming.size() == 1);
+    assert(first.renaming[0].first == "x" && first.renaming[0].second == "_0");
+    assert(first.key.hex().size() == 32);
+    std::cout << "[PASS] test_renamed_problems_share_key\n";
+}
+
+void test_free_symbols_and_operand_order() {
+    assert(key_of("a*x + b", "x") == key_of("p*y + q", "y"));
+    assert(key_of("a*x + b", "x") == key_of("b + x*a", "x"));
+    assert(key_of("a*x + b", "x") != key_of("a*x + a", "x"));
+    // Which symbol is bound is part of the problem.
+    assert(key_of("x^2*y", "x") != key_of("x^2*y", "y"));
+    assert(key_of("sin(x)", "x") != key_of("cos(x)", "x"));
+    // Doubles that print alike are still different problems.
+    assert(key_of("x + 0.1", "x") != key_of("x + 0.1000000000000001", "x"));
+    assert(key_of("x + 0.1", "x") == key_of("0.1 + y", "y"));
+
+    const auto canonical = mathllm::alpha_canonicalize("k*exp(w*t)", {"t"});
+    assert(canonical.renaming.size() == 3);
+    const auto back = canonical.to_caller(canonical.exprs[0].get());
+    assert(SymEngine::eq(*back, *SymEngine::parse("k*exp(w*t)")));
+    std::cout << "[PASS] test_free_symbols_and_operand_order\n";
+}
+
+void test_cached_results_map_back() {
+    const auto expected = uncached([] { return mathllm::integrate("u*exp(u)", "u"); });
+    mathllm::clear_alpha_cache();
+    mathllm::integrate("x*exp(x)", "x");
+    assert(mathllm::alpha_cache_stats().hits == 0);
+    assert(mathllm::integrate("u*exp(u)", "u") == expected);
+    assert(mathllm::alpha_cache_stats().hits == 1);
+
+    const auto derivative = uncached([] { return mathllm::diff("b*sin(w*t)", "t"); });
+    mathllm::diff("a*sin(k*x)", "x");
+    assert(mathllm::diff("b*sin(w*t)", "t") == derivative);
+    assert(mathllm::alpha_cache_stats().hits == 2);
+    std::cout << "[PASS] test_cached_results_map_back\n";
+}
+
+void test_solve_and_verify() {
+    const auto expected = uncached([] { return mathllm::solve_equation_set("(y - 1)^2*(y + 2)", "0", "y"); });
+    mathllm::clear_alpha_cache();
+    mathllm::solve_equation_set("(x - 1)^2*(x + 2)", "0", "x");
+    const auto cached = mathllm::solve_equation_set("(y - 1)^2*(y + 2)", "0", "y");
+    assert(mathllm::alpha_cache_stats().hits == 1);
+    assert(cached.str == expected.str);
+    assert(cached.method == expected.method);
+    assert(cached.elements.size() == expected.elements.size());
+    for (std::size_t i = 0; i < cached.elements.size(); ++i) {
+        assert(cached.elements[i].multiplicity == expected.elements[i].multiplicity);
+    }
+
+    mathllm::solve_equation_set("x^2 - a", "0", "x");
+    const auto roots = mathllm::solve_equation_set("z^2 - c", "0", "z");
+    assert(roots.str.find('c') != std::string::npos && roots.str.find('a') == std::string::npos);
+
+    assert(mathllm::verify_equal("(a + b)^2", "a^2 + 2*a*b + b^2", 1000.0));
+    const auto hits = mathllm::alpha_cache_stats().hits;
+    assert(mathllm::verify_equal("(p + q)^2", "p^2 + 2*p*q + q^2", 1000.0));
+    assert(mathllm::alpha_cache_stats().hits == hits + 1);
+    assert(!mathllm::verify_equal("(p + q)^2", "p^2 + q^2", 1000.0));
+
+    // A cached verdict for 0.1 is not served for a double that prints the
+    // same.
+    const auto inexact = uncached([] { return mathllm::verify_equal("2*(x + 0.1000000000000001)", "2*x + 0.2", 1000.0); });
+    assert(mathllm::verify_equal("2*(x + 0.1)", "2*x + 0.2", 1000.0));
+    assert(mathllm::verify_equal("2*(x + 0.1000000000000001)", "2*x + 0.2", 1000.0) == inexact);
+    std::cout << "[PASS] test_solve_and_verify\n";
+}
+
+void test_capacity() {
+    mathllm::clear_alpha_cache();
+    mathllm::set_alpha_cache_capacity(1);
+    mathllm::integrate("x^3", "x");
+    mathllm::diff("x^3", "x");
+    assert(mathllm::alpha_cache_stats().entries == 1);
+
+    mathllm::set_alpha_cache_capacity(0);
+    mathllm::diff("x^3", "x");
+    const auto stats = mathllm::alpha_cache_stats();
+    assert(stats.entries == 0 && stats.hits == 0);
+    mathllm::set_alpha_cache_capacity(4096);
+    std::cout << "[PASS] test_capacity\n";
+}
+
+int main() {
+    std::cout << "=== Alpha Canonicalization Tests ===\n";
+
+    test_renamed_problems_share_key();
+    test_free_symbols_and_operand_order();
+    test_cached_results_map_back();
+    test_solve_and_verify();
+    test_capacity();
+
+    std::cout << "\n[SUCCESS] All alpha canonicalization tests passed\n";
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "mathllm/egraph.h"
+#include "mathllm/symbolic.h"
+
+#include <symengine/basic.h>
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace {
+
+bool proves(const std::string& lhs, const std::string& rhs) {
+    return mathllm::egraph_equivalent(lhs, rhs).equal;
+}
+
+}
+
+void test_congruence() {
+    mathllm::EGraph graph;
+    const auto sin_x = graph.add(SymEngine::parse("sin(x) + 1"));
+    const auto sin_y = graph.add(SymEngine::parse("sin(y) + 1"));
+    assert(!graph.equivalent(sin_x, sin_y));
+    graph.merge(graph.add(SymEngine::parse("x")), graph.add(SymEngine::parse("y")));
+    graph.rebuild();
+    assert(graph.equivalent(sin_x, sin_y));
+    // Operand order of sums does not matter.
+    assert(graph.add(SymEngine::parse("1 + sin(y)")) == graph.find(sin_x));
+    std::cout << "[PASS] test_congruence\n";
+}
+
+void test_identities() {
+    const auto result = mathllm::egraph_equivalent("sin(x)^2 + cos(x)^2", "1");
+    assert(result.equal);
+    assert(result.stats.stop_reason == "goal");
+    assert(proves("tan(x)*cos(x)", "sin(x)"));
+    assert(proves("sin(2*x)", "2*sin(x)*cos(x)"));
+    assert(proves("cos(2*x)", "1 - 2*sin(x)^2"));
+    assert(proves("cosh(x)^2 - sinh(x)^2", "1"));
+    assert(proves("exp(2*log(x))", "x^2"));
+    assert(proves("sec(x)^2 - tan(x)^2", "1"));
+    assert(!proves("sin(x)", "cos(x)"));
+    assert(!proves("x^2", "x^3"));
+    // Not an identity where cos(x) < 0.
+    assert(!proves("sqrt(sin(x))/sqrt(cos(x))", "sqrt(tan(x))"));
+    std::cout << "[PASS] test_identities\n";
+}
+
+void test_simplify() {
+    auto result = mathllm::egraph_simplify("sin(x)^2 + cos(x)^2 + x");
+    assert(result.expr.str() == "1 + x");
+    assert(result.cost == 1.0);
+
+    result = mathllm::egraph_simplify("x*y + x*z", "nodes");
+    assert(result.cost <= mathllm::expression_cost(*SymEngine::parse("x*y + x*z"), "nodes"));
+
+    bool threw = false;
+    try {
+        mathllm::egraph_simplify("x", "length");
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_simplify\n";
+}
+
+void test_budget() {
+    mathllm::SaturationBudget budget;
+    budget.max_iterations = 0;
+    auto result = mathllm::egraph_equivalent("sin(x)^2 + cos(x)^2", "1", budget);
+    assert(!result.equal);
+    assert(result.stats.stop_reason == "iterations");
+
+    budget = mathllm::SaturationBudget();
+    budget.max_nodes = 8;
+    result = mathllm::egraph_equivalent("sin(x)^4 + cos(x)^4 + 2*sin(x)^2*cos(x)^2", "1", budget);
+    assert(result.stats.stop_reason == "nodes" || result.stats.stop_reason == "goal");
+    std::cout << "[PASS] test_budget\n";
+}
+
+void test_verifier_tier() {
+    assert(mathllm::verify_equal("sin(x)^2 + cos(x)^2", "1", 1000.0));
+    assert(mathllm::verify_equal("tan(x)*cos(x)", "sin(x)", 1000.0));
+    assert(!mathllm::verify_equal("sin(x)", "cos(x)", 1000.0));
+    std::cout << "[PASS] test_verifier_tier\n";
+}
+
+int main() {
+    std::cout << "=== E-graph Tests ===\n";
+
+    test_congruence();
+    test_identities();
+    test_simplify();
+    test_budget();
+    test_verifier_tier();
+
+    std::cout << "\n[SUCCESS] All e-graph tests passed\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "mathllm/groebner.h"
+
+#include <symengine/basic.h>
+#include <symengine/eval_double.h>
+#include <symengine/parser.h>
+#include <symengine/symbol.h>
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool same(const std::string& lhs, const std::string& rhs) {
+    const auto difference = SymEngine::expand(SymEngine::sub(SymEngine::parse(lhs), SymEngine::parse(rhs)));
+    return SymEngine::eq(*difference, *SymEngine::zero);
+}
+
+// Max |lhs - rhs| over the equations at a solution.
+double residual(
+    const std::vector<std::string>& equations,
+    const std::vector<std::string>& vars,
+    const std::vector<std::string>& solution
+) {
+    SymEngine::map_basic_basic at;
+    for (std::size_t i = 0; i < vars.size(); ++i) {
+        at[SymEngine::symbol(vars[i])] = SymEngine::parse(solution[i]);
+    }
+    double worst = 0.0;
+    for (const auto& equation : equations) {
+        const auto split = equation.find('=');
+        const auto f = SymEngine::sub(SymEngine::parse(equation.substr(0, split)), SymEngine::parse(equation.substr(split + 1)));
+        worst = std::max(worst, std::abs(SymEngine::eval_complex_double(*f->subs(at))));
+    }
+    return worst;
+}
+
+}
+
+void test_groebner_basis() {
+    auto result = mathllm::groebner_basis({"x^2 + y^2 - 1", "x - y"}, {"x", "y"}, "lex");
+    assert(result.complete);
+    assert(result.basis.size() == 2);
+    assert(same(result.basis[0], "x - y"));
+    assert(same(result.basis[1], "y^2 - 1/2"));
+
+    // Cyclic-4: the reduced grevlex basis has seven elements.
+    result = mathllm::groebner_basis(
+        {"a + b + c + d", "a*b + b*c + c*d + d*a", "a*b*c + b*c*d + c*d*a + d*a*b", "a*b*c*d = 1"},
+        {"a", "b", "c", "d"}
+    );
+    assert(result.complete);
+    assert(result.basis.size() == 7);
+    assert(same(result.basis.back(), "a + b + c + d"));
+    assert(same(result.basis[5], "b^2 + 2*b*d + d^2"));
+    assert(result.pairs_processed > 0);
+
+    // Inconsistent generators give the unit ideal.
+    result = mathllm::groebner_basis({"x*y - 1", "x", "y^3 + x"}, {"x", "y"});
+    assert(result.basis.size() == 1);
+    assert(same(result.basis[0], "1"));
+    std::cout << "[PASS] test_groebner_basis\n";
+}
+
+void test_groebner_modular() {
+    // 3x = 1 mod 7 gives x = 5.
+    auto result = mathllm::groebner_basis({"3*x - 1", "x^2 - 4"}, {"x"}, "grevlex", 7);
+    assert(result.basis.size() == 1);
+    assert(same(result.basis[0], "x + 2"));
+
+    // Over GF(2) x^2 + 1 = (x + 1)^2.
+    result = mathllm::groebner_basis({"x^2 + 1", "x^3 + x^2 + x + 1"}, {"x"}, "lex", 2);
+    assert(result.basis.size() == 1);
+    assert(same(result.basis[0], "x^2 + 1"));
+
+    bool threw = false;
+    try {
+        mathllm::groebner_basis({"x"}, {"x"}, "grevlex", 4);
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_groebner_modular\n";
+}
+
+void test_groebner_budget() {
+    mathllm::GroebnerBudget budget;
+    budget.max_terms = 4;
+    const auto result = mathllm::groebner_basis(
+        {"a + b + c + d", "a*b + b*c + c*d + d*a", "a*b*c + b*c*d + c*d*a + d*a*b", "a*b*c*d - 1"},
+        {"a", "b", "c", "d"}, "grevlex", 0, budget
+    );
+    assert(!result.complete);
+
+    const auto solved = mathllm::solve_polynomial_system({"x^2 + y^2 = 1", "x = y"}, {"x", "y"}, budget);
+    assert(solved.status == "budget_exceeded");
+    std::cout << "[PASS] test_groebner_budget\n";
+}
+
+void test_solve_polynomial_system() {
+    // Rational roots of the last variable are substituted exactly.
+    const std::vector<std::string> vars = {"x", "y"};
+    std::vector<std::string> equations = {"x^2 + y^2 = 5", "x*y = 2"};
+    auto result = mathllm::solve_polynomial_system(equations, vars);
+    assert(result.status == "finite");
+    assert(result.exact);
+    assert(result.solutions.size() == 4);
+    assert(result.triangular_sets.size() == 4);
+    for (const auto& solution : result.solutions) {
+        assert(SymEngine::is_a<SymEngine::Integer>(*SymEngine::parse(solution[0])));
+        assert(residual(equations, vars, solution) == 0.0);
+    }
+
+    // Shape position: x = y, so both come out in radicals.
+    equations = {"x^2 + y^2 = 1", "x - y = 0"};
+    result = mathllm::solve_polynomial_system(equations, vars);
+    assert(result.exact);
+    assert(result.solutions.size() == 2);
+    assert(result.triangular_sets.size() == 1);
+    for (const auto& solution : result.solutions) {
+        assert(residual(equations, vars, solution) < 1e-14);
+    }
+
+    // Complex solutions are kept on the exact path.
+    equations = {"x^2 + 1 = 0", "y - x = 1"};
+    result = mathllm::solve_polynomial_system(equations, vars);
+    assert(result.solutions.size() == 2);
+    for (const auto& solution : result.solutions) {
+        assert(residual(equations, vars, solution) < 1e-14);
+    }
+    std::cout << "[PASS] test_solve_polynomial_system\n";
+}
+
+void test_solve_polynomial_system_numeric() {
+    // Not in shape position: y^2 = 3 does not determine x.
+    const std::vector<std::string> vars = {"x", "y"};
+    const std::vector<std::string> equations = {"x^2 = 2", "y^2 = 3"};
+    const auto result = mathllm::solve_polynomial_system(equations, vars);
+    assert(result.status == "finite");
+    assert(!result.exact);
+    assert(result.solutions.size() == 4);
+    for (const auto& solution : result.solutions) {
+        assert(residual(equations, vars, solution) < 1e-12);
+    }
+    std::cout << "[PASS] test_solve_polynomial_system_numeric\n";
+}
+
+void test_solve_polynomial_system_degenerate() {
+    auto result = mathllm::solve_polynomial_system({"x + y = 1", "x + y = 2"}, {"x", "y"});
+    assert(result.status == "inconsistent");
+    assert(result.solutions.empty());
+
+    result = mathllm::solve_polynomial_system({"x*y = 0", "x*(x - 1) = 0"}, {"x", "y"});
+    assert(result.status == "infinite");
+    assert(!result.triangular_sets.empty());
+
+    bool threw = false;
+    try {
+        mathllm::solve_polynomial_system({"sin(x) = y"}, {"x", "y"});
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_solve_polynomial_system_degenerate\n";
+}
+
+int main() {
+    std::cout << "=== Groebner Basis Tests ===\n";
+
+    test_groebner_basis();
+    test_groebner_modular();
+    test_groebner_budget();
+    test_solve_polynomial_system();
+    test_solve_polynomial_system_numeric();
+    test_solve_polynomial_system_degenerate();
+
+    std::cout << "\n[SUCCESS] All Groebner basis tests passed\n";
+    return 0;
+}
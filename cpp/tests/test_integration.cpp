@@ -0,0 +1,423 @@
+#include "mathllm/canonical.h"
+#include "mathllm/integration.h"
+#include "mathllm/numeric.h"
+#include "mathllm/symbolic.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+bool fired(const mathllm::IntegrationResult& result, const std::string& rule) {
+    return std::find(result.rules_fired.begin(), result.rules_fired.end(), rule) != result.rules_fired.end();
+}
+
+bool differentiates_back(const std::string& antiderivative, const std::string& integrand) {
+    return mathllm::probe_equal(mathllm::diff(antiderivative, "x"), integrand, {"x"}).equal;
+}
+
+}
+
+void test_table_rules() {
+    auto result = mathllm::integrate_traced("tan(x)", "x");
+    assert(result.antiderivative == "-log(cos(x))");
+    assert(fired(result, "tan"));
+
+    result = mathllm::integrate_traced("sin(x)", "x");
+    assert(result.antiderivative == "-cos(x)");
+    assert(result.rules_fired.size() == 1);
+    assert(result.steps_used == 1);
+
+    assert(mathllm::integrate("exp(x)", "x") == "exp(x)");
+    assert(mathllm::integrate("1/x", "x") == "log(x)");
+    assert(mathllm::integrate("1/(1 + x^2)", "x") == "atan(x)");
+    assert(mathllm::integrate("1/cos(x)^2", "x") == "tan(x)");
+    std::cout << "[PASS] test_table_rules\n";
+}
+
+void test_linearity_trace() {
+    auto result = mathllm::integrate_traced("3*x^2 + 2", "x");
+    assert(fired(result, "sum"));
+    assert(fired(result, "constant_multiple"));
+    assert(fired(result, "power"));
+    assert(fired(result, "constant"));
+    assert(result.rules_fired.front() == "sum");
+    std::cout << "[PASS] test_linearity_trace\n";
+}
+
+void test_pow_shapes() {
+    auto result = mathllm::integrate_traced("2^x", "x");
+    assert(fired(result, "exponential"));
+    assert(!fired(result, "exp"));
+
+    result = mathllm::integrate_traced("sin(x)^2", "x");
+    assert(fired(result, "sin_squared"));
+
+    result = mathllm::integrate_traced("(x + 1)^2", "x");
+    assert(fired(result, "expand"));
+    std::cout << "[PASS] test_pow_shapes\n";
+}
+
+void test_failed_rules_not_traced() {
+    auto result = mathllm::integrate_traced("sec(x)*tan(x)", "x");
+    assert(result.antiderivative == "sec(x)");
+    assert(fired(result, "sec_tan"));
+    assert(!fired(result, "constant_multiple"));
+    std::cout << "[PASS] test_failed_rules_not_traced\n";
+}
+
+void test_unsupported_integrand() {
+    bool caught = false;
+    try {
+        mathllm::integrate_traced("exp(x^2)", "x");
+    } catch (const mathllm::SymbolicError& e) {
+        caught = std::string(e.what()).find("Unsupported integrand") != std::string::npos;
+    }
+    assert(caught && "exp(x^2) has no elementary antiderivative");
+    std::cout << "[PASS] test_unsupported_integrand\n";
+}
+
+void test_step_budget() {
+    bool caught = false;
+    try {
+        mathllm::integrate_traced("x + x^2 + x^3", "x", 2);
+    } catch (const mathllm::SymbolicError& e) {
+        caught = std::string(e.what()).find("budget") != std::string::npos;
+    }
+    assert(caught && "Budget of 2 steps cannot cover a three-term sum");
+
+    auto result = mathllm::integrate_traced("x + x^2 + x^3", "x", 4);
+    assert(result.steps_used == 4);
+    std::cout << "[PASS] test_step_budget\n";
+}
+
+void test_linear_substitution() {
+    auto result = mathllm::integrate_traced("cos(3*x + 1)", "x");
+    assert(fired(result, "cos"));
+    assert(differentiates_back(result.antiderivative, "cos(3*x + 1)"));
+
+    result = mathllm::integrate_traced("(2*x + 1)^5", "x");
+    assert(fired(result, "power"));
+    assert(!fired(result, "expand"));
+    assert(differentiates_back(result.antiderivative, "(2*x + 1)^5"));
+
+    result = mathllm::integrate_traced("1/(2*x + 3)", "x");
+    assert(fired(result, "reciprocal"));
+    assert(differentiates_back(result.antiderivative, "1/(2*x + 3)"));
+
+    result = mathllm::integrate_traced("sin(4*x)^2", "x");
+    assert(fired(result, "sin_squared"));
+    assert(differentiates_back(result.antiderivative, "sin(4*x)^2"));
+
+    // Every table form takes an affine argument.
+    const std::vector<std::pair<std::string, std::string>> forms = {
+        {"sec_tan", "sec(2*x + 1)*tan(2*x + 1)"},
+        {"csc_cot", "csc(3*x)*cot(3*x)"},
+        {"sin_cos", "sin(5*x - 2)*cos(5*x - 2)"},
+        {"arctan_form", "1/(1 + (2*x + 1)^2)"},
+        {"arcsin_form", "1/sqrt(1 - (3*x - 1)^2)"},
+        {"arcsin_form", "1/sqrt(1 + 4*x^2)"},
+    };
+    for (const auto& form : forms) {
+        result = mathllm::integrate_traced(form.second, "x");
+        assert(fired(result, form.first));
+        assert(differentiates_back(result.antiderivative, form.second));
+    }
+
+    assert(mathllm::diff(mathllm::integrate("exp(3*x)", "x"), "x") == "exp(3*x)");
+    std::cout << "[PASS] test_linear_substitution\n";
+}
+
+void test_derivative_divides() {
+    auto result = mathllm::integrate_traced("x*cos(x^2)", "x");
+    assert(fired(result, "derivative_divides"));
+    assert(differentiates_back(result.antiderivative, "x*cos(x^2)"));
+
+    result = mathllm::integrate_traced("cos(x)/sin(x)", "x");
+    assert(fired(result, "derivative_divides"));
+    assert(differentiates_back(result.antiderivative, "cos(x)/sin(x)"));
+
+    result = mathllm::integrate_traced("x*(x^2 + 1)^3", "x");
+    assert(fired(result, "derivative_divides"));
+    assert(differentiates_back(result.antiderivative, "x*(x^2 + 1)^3"));
+
+    result = mathllm::integrate_traced("log(x)/x", "x");
+    assert(differentiates_back(result.antiderivative, "log(x)/x"));
+
+    result = mathllm::integrate_traced("x*exp(x^2)", "x");
+    assert(fired(result, "derivative_divides"));
+    assert(fired(result, "exp"));
+
+    // User symbols shaped like substitution variables stay constants.
+    for (int i = 0; i < 4; ++i) {
+        const std::string integrand = "_u" + std::to_string(i) + "*x*cos(x^2)";
+        assert(mathllm::verify_equal(mathllm::diff(mathllm::integrate(integrand, "x"), "x"), integrand));
+    }
+    std::cout << "[PASS] test_derivative_divides\n";
+}
+
+void test_rational_functions() {
+    auto result = mathllm::integrate_traced("1/(x^2 - 1)", "x");
+    assert(fired(result, "rational"));
+    assert(differentiates_back(result.antiderivative, "1/(x^2 - 1)"));
+
+    result = mathllm::integrate_traced("(2*x + 3)/(x^2 + x + 1)", "x");
+    assert(fired(result, "rational"));
+    assert(differentiates_back(result.antiderivative, "(2*x + 3)/(x^2 + x + 1)"));
+
+    result = mathllm::integrate_traced("(x^3 + 1)/(x - 2)", "x");
+    assert(differentiates_back(result.antiderivative, "(x^3 + 1)/(x - 2)"));
+
+    result = mathllm::integrate_traced("1/(x^2 + 1)^2", "x");
+    assert(fired(result, "rational"));
+    assert(differentiates_back(result.antiderivative, "1/(x^2 + 1)^2"));
+
+    result = mathllm::integrate_traced("1/(x^2 - 2)", "x");
+    assert(differentiates_back(result.antiderivative, "1/(x^2 - 2)"));
+
+    result = mathllm::integrate_traced("x/((x - 1)^2*(x^2 + 4))", "x");
+    assert(differentiates_back(result.antiderivative, "x/((x - 1)^2*(x^2 + 4))"));
+
+    // Distinct irreducible quadratics, factored or expanded.
+    result = mathllm::integrate_traced("1/((x^2 + 1)*(x^2 + 2))", "x");
+    assert(fired(result, "rational"));
+    assert(!fired(result, "hermite_reduction"));
+    assert(mathllm::verify_equal(result.antiderivative, "atan(x) - atan(x/sqrt(2))/sqrt(2)", 1000.0));
+    assert(differentiates_back(result.antiderivative, "1/((x^2 + 1)*(x^2 + 2))"));
+
+    result = mathllm::integrate_traced("x/(x^4 + 5*x^2 + 6)", "x");
+    assert(fired(result, "rational"));
+    assert(differentiates_back(result.antiderivative, "x/(x^4 + 5*x^2 + 6)"));
+
+    result = mathllm::integrate_traced("1/((x^2 + x + 1)*(x^2 - 3)*(x - 1))", "x");
+    assert(differentiates_back(result.antiderivative, "1/((x^2 + x + 1)*(x^2 - 3)*(x - 1))"));
+    std::cout << "[PASS] test_rational_functions\n";
+}
+
+void test_hermite_reduction() {
+    auto result = mathllm::integrate_traced("(3*x^2 + 1)/(x^3 + x + 1)^2", "x");
+    assert(fired(result, "hermite_reduction"));
+    assert(differentiates_back(result.antiderivative, "(3*x^2 + 1)/(x^3 + x + 1)^2"));
+
+    bool caught = false;
+    try {
+        mathllm::integrate_traced("1/(x^3 + x + 1)", "x");
+    } catch (const mathllm::SymbolicError&) {
+        caught = true;
+    }
+    assert(caught && "Irreducible cubic log part needs algebraic extensions");
+    std::cout << "[PASS] test_hermite_reduction\n";
+}
+
+void test_integration_by_parts() {
+    auto result = mathllm::integrate_traced("x*sin(x)", "x");
+    assert(fired(result, "parts_tabular"));
+    assert(differentiates_back(result.antiderivative, "x*sin(x)"));
+
+    result = mathllm::integrate_traced("x^2*exp(x)", "x");
+    assert(fired(result, "parts_tabular"));
+    assert(mathllm::verify_equal(mathllm::diff(result.antiderivative, "x"), "x^2*exp(x)"));
+
+    result = mathllm::integrate_traced("x*log(x)", "x");
+    assert(fired(result, "parts_log"));
+    assert(differentiates_back(result.antiderivative, "x*log(x)"));
+
+    result = mathllm::integrate_traced("log(x)^3", "x");
+    assert(fired(result, "parts_log"));
+    assert(differentiates_back(result.antiderivative, "log(x)^3"));
+
+    result = mathllm::integrate_traced("exp(2*x)*sin(3*x)", "x");
+    assert(fired(result, "parts_cyclic"));
+    assert(mathllm::verify_equal(mathllm::diff(result.antiderivative, "x"), "exp(2*x)*sin(3*x)"));
+
+    bool caught = false;
+    try {
+        mathllm::integrate_traced("log(x)^6", "x");
+    } catch (const mathllm::SymbolicError&) {
+        caught = true;
+    }
+    assert(caught && "Six nested rounds of parts exceed the default depth of 4");
+    std::cout << "[PASS] test_integration_by_parts\n";
+}
+
+void test_definite_integrals() {
+    auto result = mathllm::integrate_definite("x^2", "x", 0.0, 3.0);
+    assert(result.method == "symbolic");
+    assert(std::abs(result.value - 9.0) < 1e-12);
+
+    result = mathllm::integrate_definite("sin(x)", "x", M_PI, 0.0);
+    assert(std::abs(result.value + 2.0) < 1e-12);
+
+    result = mathllm::integrate_definite("exp(x^2)", "x", 0.0, 1.0);
+    assert(result.method == "gauss_kronrod");
+    assert(result.converged);
+    assert(std::abs(result.value - 1.4626517459071816) < 1e-10);
+
+    result = mathllm::integrate_definite("1/cos(x)^2", "x", 0.0, 3.0);
+    assert(result.method != "symbolic" && "tan(x) jumps across the pole at pi/2");
+    assert(!result.converged);
+
+    result = mathllm::integrate_definite("x^3 - 2*x", "x", 0.0, 2.0);
+    assert(result.method == "symbolic");
+    assert(std::abs(result.value) < 1e-12);
+
+    result = mathllm::integrate_definite("log(x)/sqrt(x)", "x", 0.0, 1.0);
+    assert(result.method == "tanh_sinh");
+    assert(std::abs(result.value + 4.0) < 1e-8);
+
+    result = mathllm::integrate_definite("exp(-x^2)", "x", -std::numeric_limits<double>::infinity(),
+                                         std::numeric_limits<double>::infinity());
+    assert(std::abs(result.value - std::sqrt(M_PI)) < 1e-9);
+    std::cout << "[PASS] test_definite_integrals\n";
+}
+
+void test_multidimensional_integrals() {
+    auto result = mathllm::integrate_nd("x*y^2", {"x", "y"}, {{0.0, 1.0}, {0.0, 3.0}});
+    assert(result.method == "cubature");
+    assert(result.converged);
+    assert(std::abs(result.value - 4.5) < 1e-10);
+
+    result = mathllm::integrate_nd("exp(-x^2 - y^2 - z^2)", {"x", "y", "z"}, {{0.0, 1.0}, {0.0, 1.0}, {0.0, 1.0}});
+    assert(std::abs(result.value - std::pow(0.7468241328124271, 3)) < 1e-8);
+
+    result = mathllm::integrate_nd("sin(x)", {"x"}, {{0.0, M_PI}});
+    assert(result.method == "symbolic");
+    assert(std::abs(result.value - 2.0) < 1e-12);
+
+    const std::vector<std::string> vars = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    std::vector<std::pair<double, double>> box(vars.size(), {0.0, 1.0});
+    const std::string sum_of_squares = "a^2 + b^2 + c^2 + d^2 + e^2 + f^2 + g^2 + h^2";
+    auto first = mathllm::integrate_nd(sum_of_squares, vars, box, 1e-6, 7);
+    auto second = mathllm::integrate_nd(sum_of_squares, vars, box, 1e-6, 7);
+    assert(first.method == "qmc");
+    assert(first.value == second.value && "Same seed must reproduce the estimate");
+    assert(std::abs(first.value - 8.0 / 3.0) < 1e-4);
+    assert(first.error_estimate > 0.0 && first.error_estimate < 1e-4);
+    std::cout << "[PASS] test_multidimensional_integrals\n";
+}
+
+void test_antiderivative_memo() {
+    mathllm::clear_integration_memo();
+    const std::string first = mathllm::integrate("x^2 + sin(x)", "x");
+    auto stats = mathllm::integration_memo_stats();
+    assert(stats.hits == 0);
+    assert(stats.entries >= 3 && "Sum, power and sin results are all stored");
+
+    assert(mathllm::integrate("x^2 + sin(x)", "x") == first);
+    assert(mathllm::integrate("3*sin(x)", "x") == "-3*cos(x)");
+    stats = mathllm::integration_memo_stats();
+    assert(stats.hits == 2);
+    assert(stats.hit_rate > 0.0);
+
+    auto traced = mathllm::integrate_traced("x^2 + sin(x)", "x");
+    assert(!fired(traced, "memo") && "Traced integration bypasses the memo");
+
+    mathllm::set_integration_memo_capacity(2);
+    mathllm::integrate("x^3 + x^4 + x^5", "x");
+    assert(mathllm::integration_memo_stats().entries == 2);
+    mathllm::set_integration_memo_capacity(4096);
+    std::cout << "[PASS] test_antiderivative_memo\n";
+}
+
+void test_memo_warm_start() {
+    const std::string path = "test_integration_memo.tsv";
+    mathllm::clear_integration_memo();
+    mathllm::integrate("cos(2*x)", "x");
+    const auto saved = mathllm::save_integration_memo(path);
+    assert(saved == mathllm::integration_memo_stats().entries);
+
+    mathllm::clear_integration_memo();
+    assert(mathllm::load_integration_memo(path) == saved);
+    mathllm::integrate("cos(2*x)", "x");
+    assert(mathllm::integration_memo_stats().hits == 1);
+
+    {
+        std::ofstream out(path);
+        out << "x\tcos(x)\tcos(x)\nx\tcos(x)\tsin(x)\n";
+    }
+    mathllm::clear_integration_memo();
+    assert(mathllm::load_integration_memo(path) == 1 && "Wrong antiderivatives are dropped");
+    assert(mathllm::integration_memo_stats().entries == 1);
+
+    {
+        std::ofstream out(path);
+        out << "# comment\n\nx\tfoo(x)\tbar(x)\nx\tmissing tab\n";
+    }
+    bool caught = false;
+    try {
+        mathllm::load_integration_memo(path);
+    } catch (const mathllm::SymbolicError& e) {
+        caught = std::string(e.what()).find("line 4") != std::string::npos;
+    }
+    assert(caught && "Line 4 has only one field separator");
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_memo_warm_start\n";
+}
+
+void test_memo_shared_between_threads() {
+    mathllm::clear_integration_memo();
+    const std::vector<std::string> integrands = {"x*sin(x)", "x^2*exp(x)", "1/(x^2 - 1)", "cos(3*x + 1)"};
+    std::vector<std::string> expected;
+    for (const auto& integrand : integrands) {
+        expected.push_back(mathllm::integrate_traced(integrand, "x").antiderivative);
+    }
+
+    std::vector<std::thread> workers;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int round = 0; round < 25; ++round) {
+                for (std::size_t i = 0; i < integrands.size(); ++i) {
+                    if (mathllm::integrate(integrands[i], "x") != expected[i]) {
+                        ++mismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (int count : mismatches) {
+        assert(count == 0);
+    }
+    assert(mathllm::integration_memo_stats().hit_rate > 0.8);
+    std::cout << "[PASS] test_memo_shared_between_threads\n";
+}
+
+int main() {
+    std::cout << "=== Integration Rule Engine Tests ===\n";
+
+    test_table_rules();
+    test_linearity_trace();
+    test_pow_shapes();
+    test_failed_rules_not_traced();
+    test_linear_substitution();
+    test_derivative_divides();
+    test_rational_functions();
+    test_hermite_reduction();
+    test_integration_by_parts();
+    test_definite_integrals();
+    test_multidimensional_integrals();
+    // The memo tests count lookups that the alpha cache in front of
+    // integrate() would otherwise answer.
+    mathllm::set_alpha_cache_capacity(0);
+    test_antiderivative_memo();
+    test_memo_warm_start();
+    test_memo_shared_between_threads();
+    mathllm::set_alpha_cache_capacity(4096);
+    test_unsupported_integrand();
+    test_step_budget();
+
+    std::cout << "\n[SUCCESS] All integration rule engine tests passed\n";
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "mathllm/intern.h"
+
+#include <symengine/add.h>
+#include <symengine/basic.h>
+#include <symengine/functions.h>
+#include <symengine/mul.h>
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+SymEngine::RCP<const SymEngine::Basic> interned(const std::string& expr) {
+    return mathllm::intern(SymEngine::parse(expr));
+}
+
+// The node stored for sin(x) inside a sum or product.
+const SymEngine::Basic* stored_sine(const SymEngine::RCP<const SymEngine::Basic>& expr) {
+    const auto sine = SymEngine::parse("sin(x)");
+    if (SymEngine::is_a<SymEngine::Add>(*expr)) {
+        for (const auto& term : SymEngine::down_cast<const SymEngine::Add&>(*expr).get_dict()) {
+            if (SymEngine::eq(*term.first, *sine)) {
+                return term.first.get();
+            }
+        }
+    }
+    for (const auto& factor : SymEngine::down_cast<const SymEngine::Mul&>(*expr).get_dict()) {
+        if (SymEngine::eq(*factor.first, *sine)) {
+            return factor.first.get();
+        }
+    }
+    return nullptr;
+}
+
+}
+
+void test_identity() {
+    mathllm::clear_intern_table();
+    const auto a = interned("sin(x) + x^2");
+    const auto b = interned("x^2 + sin(x)");
+    assert(a.get() == b.get());
+    assert(mathllm::is_interned(a));
+    assert(!mathllm::is_interned(SymEngine::parse("sin(x) + x^2")));
+    assert(interned("x^3").get() != a.get());
+
+    const auto stats = mathllm::intern_stats();
+    assert(stats.hits >= 1);
+    assert(stats.entries > 0);
+    std::cout << "[PASS] test_identity\n";
+}
+
+void test_sharing() {
+    const auto sum = interned("sin(x) + 1");
+    const auto product = interned("sin(x)*y");
+    assert(stored_sine(sum) != nullptr);
+    assert(stored_sine(sum) == stored_sine(product));
+    std::cout << "[PASS] test_sharing\n";
+}
+
+void test_threads() {
+    mathllm::clear_intern_table();
+    const std::vector<std::string> exprs = {"sin(x)*cos(y)", "exp(x + y)^2", "log(1 + x^2)/x"};
+    std::vector<std::vector<const SymEngine::Basic*>> seen(4);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        workers.emplace_back([&exprs, &seen, t]() {
+            for (int round = 0; round < 50; ++round) {
+                for (std::size_t i = 0; i < exprs.size(); ++i) {
+                    const auto node = interned(exprs[i]);
+                    if (round == 0) {
+                        seen[t].push_back(node.get());
+                    }
+                }
+            }
+        });
+    }
+    // The nodes stay referenced by the table, so the addresses compared
+    // below are still live.
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (std::size_t t = 1; t < seen.size(); ++t) {
+        assert(seen[t] == seen[0]);
+    }
+    std::cout << "[PASS] test_threads\n";
+}
+
+void test_capacity() {
+    mathllm::clear_intern_table();
+    mathllm::set_intern_capacity(8);
+    const auto kept = interned("sin(x)");
+    for (int i = 0; i < 32; ++i) {
+        interned("x^" + std::to_string(i + 2) + " + " + std::to_string(i));
+    }
+    auto stats = mathllm::intern_stats();
+    assert(stats.entries <= 8);
+    assert(stats.retired > 0);
+    // Referenced entries survive the sweeps.
+    assert(mathllm::is_interned(kept));
+
+    mathllm::set_intern_capacity(0);
+    assert(mathllm::intern_stats().entries == 0);
+    const auto fresh = SymEngine::parse("cos(x)");
+    assert(mathllm::intern(fresh).get() == fresh.get());
+    mathllm::set_intern_capacity(1 << 18);
+    std::cout << "[PASS] test_capacity\n";
+}
+
+void test_epochs() {
+    mathllm::clear_intern_table();
+    std::size_t reclaimed = 0;
+    {
+        mathllm::InternPin pin;
+        interned("tan(x) + 7");
+        reclaimed = mathllm::intern_stats().reclaimed;
+        assert(mathllm::reclaim_interned() > 0);
+        // Retired, but held back by the pin.
+        assert(mathllm::intern_stats().reclaimed == reclaimed);
+        assert(mathllm::intern_stats().epoch > pin.epoch());
+    }
+    assert(mathllm::intern_stats().reclaimed > reclaimed);
+    std::cout << "[PASS] test_epochs\n";
+}
+
+int main() {
+    std::cout << "=== Interning Tests ===\n";
+
+    test_identity();
+    test_sharing();
+    test_threads();
+    test_capacity();
+    test_epochs();
+
+    std::cout << "\n[SUCCESS] All interning tests passed\n";
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <vector>
 
 void test_probe_simple_identity() {
     auto result = mathllm::probe_equal(
@@ -167,6 +168,63 @@ void test_probe_max_errors_tracking() {
     std::cout << "[PASS] test_probe_max_errors_tracking\n";
 }
 
+void test_compiled_expr() {
+    mathllm::CompiledExpr compiled("x*sin(y) + exp(x) + sqrt(x)/(1 + y^2) + pi", {"x", "y"});
+    const double point[] = {0.7, 1.3};
+    const double expected = 0.7 * std::sin(1.3) + std::exp(0.7) + std::sqrt(0.7) / (1 + 1.3 * 1.3) + M_PI;
+    assert(std::abs(compiled.evaluate(point) - expected) < 1e-12);
+
+    std::vector<double> points;
+    for (int i = 0; i < 100; ++i) {
+        points.push_back(0.01 * i);
+        points.push_back(1.0 - 0.01 * i);
+    }
+    std::vector<double> batch(100);
+    compiled.evaluate_batch(points.data(), 100, batch.data());
+    for (int i = 0; i < 100; ++i) {
+        assert(std::abs(batch[i] - compiled.evaluate(&points[2 * i])) < 1e-12);
+    }
+
+    mathllm::CompiledExpr folded("sin(2)*cos(2) + x", {"x"});
+    assert(std::abs(folded.evaluate(std::vector<double>{1.0}) - (std::sin(2.0) * std::cos(2.0) + 1.0)) < 1e-12);
+
+    bool caught = false;
+    try {
+        mathllm::CompiledExpr("x + z", {"x"});
+    } catch (const mathllm::NumericError&) {
+        caught = true;
+    }
+    assert(caught && "Should throw NumericError for a symbol outside the list");
+    std::cout << "[PASS] test_compiled_expr\n";
+}
+
+void test_interval_evaluation() {
+    double lo;
+    double hi;
+    const double lower[] = {-1.0};
+    const double upper[] = {2.0};
+    mathllm::CompiledExpr("x^2 - x", {"x"}).evaluate_interval(lower, upper, lo, hi);
+    // Naive interval extension: [0, 4] - [-1, 2] = [-2, 5].
+    assert(lo <= -2.0 && lo > -2.0 - 1e-12);
+    assert(hi >= 5.0 && hi < 5.0 + 1e-12);
+
+    const double angle_lo[] = {0.0};
+    const double angle_hi[] = {3.0};
+    mathllm::CompiledExpr("sin(x)", {"x"}).evaluate_interval(angle_lo, angle_hi, lo, hi);
+    assert(lo <= 0.0 && lo > -1e-12);
+    assert(hi >= 1.0 && hi < 1.0 + 1e-12);
+
+    // Every point of the box lies outside the domain of log.
+    const double negative_lo[] = {-3.0};
+    const double negative_hi[] = {-1.0};
+    mathllm::CompiledExpr("log(x)", {"x"}).evaluate_interval(negative_lo, negative_hi, lo, hi);
+    assert(lo > hi);
+
+    mathllm::CompiledExpr("1/x", {"x"}).evaluate_interval(lower, upper, lo, hi);
+    assert(std::isinf(lo) && std::isinf(hi));
+    std::cout << "[PASS] test_interval_evaluation\n";
+}
+
 int main() {
     std::cout << "=== Phase C: Numeric Probe Tests ===\n";
     
@@ -178,6 +236,8 @@ int main() {
     test_probe_deterministic();
     test_probe_error_handling();
     test_probe_max_errors_tracking();
+    test_compiled_expr();
+    test_interval_evaluation();
     
     std::cout << "\n[SUCCESS] All numeric probe tests passed\n";
     return 0;
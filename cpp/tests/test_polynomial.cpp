@@ -0,0 +1,173 @@
+#include "mathllm/polynomial.h"
+
+#include <symengine/eval_double.h>
+#include <symengine/integer.h>
+#include <symengine/parser.h>
+#include <symengine/rational.h>
+#include <symengine/symbol.h>
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+
+using mathllm::DensePoly;
+
+namespace {
+
+DensePoly poly(const std::string& text) {
+    DensePoly out;
+    const bool ok = DensePoly::from_basic(SymEngine::parse(text), SymEngine::symbol("x"), out);
+    assert(ok && "Expected a polynomial in x");
+    return out;
+}
+
+bool same(const DensePoly& a, const DensePoly& b) {
+    return (a - b).is_zero();
+}
+
+}
+
+void test_from_basic() {
+    DensePoly p = poly("(x + 1)^3");
+    assert(p.degree() == 3);
+    assert(SymEngine::eq(*p.coeff(2), *SymEngine::integer(3)));
+
+    p = poly("x^2/2 - 1/3");
+    assert(SymEngine::eq(*p.leading_coeff(), *SymEngine::Rational::from_two_ints(1, 2)));
+
+    DensePoly out;
+    assert(!DensePoly::from_basic(SymEngine::parse("sin(x) + 1"), SymEngine::symbol("x"), out));
+    assert(!DensePoly::from_basic(SymEngine::parse("a*x + 1"), SymEngine::symbol("x"), out));
+    assert(!DensePoly::from_basic(SymEngine::parse("1/x"), SymEngine::symbol("x"), out));
+
+    assert(poly("0").is_zero());
+    assert(poly("0").degree() == -1);
+    std::cout << "[PASS] test_from_basic\n";
+}
+
+void test_division_and_gcd() {
+    DensePoly q, r;
+    DensePoly::divmod(poly("x^3 + 1"), poly("x - 2"), q, r);
+    assert(same(q, poly("x^2 + 2*x + 4")));
+    assert(same(r, poly("9")));
+
+    assert(same(DensePoly::gcd(poly("x^2 - 1"), poly("2*x^2 + 4*x + 2")), poly("x + 1")));
+
+    DensePoly s, t;
+    const DensePoly a = poly("x^2 + 1");
+    const DensePoly b = poly("x - 3");
+    const DensePoly g = DensePoly::extended_gcd(a, b, s, t);
+    assert(same(g, poly("1")));
+    assert(same(s * a + t * b, g));
+
+    bool caught = false;
+    try {
+        DensePoly::divmod(poly("x"), DensePoly(), q, r);
+    } catch (const mathllm::SymbolicError&) {
+        caught = true;
+    }
+    assert(caught && "Division by the zero polynomial must throw");
+    std::cout << "[PASS] test_division_and_gcd\n";
+}
+
+void test_calculus() {
+    assert(same(poly("x^3 + 2*x").derivative(), poly("3*x^2 + 2")));
+    assert(same(poly("3*x^2 + 2").antiderivative(), poly("x^3 + 2*x")));
+    assert(SymEngine::eq(*poly("x^2 + 1").evaluate(SymEngine::integer(3)), *SymEngine::integer(10)));
+    std::cout << "[PASS] test_calculus\n";
+}
+
+void test_square_free() {
+    const auto factors = poly("(x - 1)*(x + 2)^2*(x^2 + 1)^3").square_free();
+    assert(factors.size() == 3);
+    assert(same(factors[0], poly("x - 1")));
+    assert(same(factors[1], poly("x + 2")));
+    assert(same(factors[2], poly("x^2 + 1")));
+    std::cout << "[PASS] test_square_free\n";
+}
+
+void test_rational_roots() {
+    auto roots = poly("2*x^3 - 3*x^2 - 3*x + 2").rational_roots();
+    assert(roots.size() == 3);
+
+    roots = poly("x^3 - x").rational_roots();
+    assert(roots.size() == 3);
+
+    roots = poly("x^2 - 2").rational_roots();
+    assert(roots.empty());
+    std::cout << "[PASS] test_rational_roots\n";
+}
+
+void test_from_expanded() {
+    DensePoly out;
+    assert(DensePoly::from_expanded(SymEngine::parse("3*x^2 + x - 5"), SymEngine::symbol("x"), out));
+    assert(out.degree() == 2);
+    assert(!DensePoly::from_expanded(SymEngine::parse("(x + 1)^2"), SymEngine::symbol("x"), out));
+    assert(!DensePoly::from_basic(SymEngine::parse("(x + 1)^100000"), SymEngine::symbol("x"), out));
+    // Exponents past the degree cap, including ones that wrap as int.
+    assert(!DensePoly::from_expanded(SymEngine::parse("x^100000000"), SymEngine::symbol("x"), out));
+    assert(!DensePoly::from_expanded(SymEngine::parse("x^3000000000"), SymEngine::symbol("x"), out));
+    assert(!DensePoly::from_expanded(SymEngine::parse("x^4294967298 + 1"), SymEngine::symbol("x"), out));
+    std::cout << "[PASS] test_from_expanded\n";
+}
+
+void test_polynomial_roots() {
+    // Repeated rational roots are reported once.
+    auto roots = mathllm::polynomial_roots(poly("(x - 1)^2*(x + 3)"));
+    assert(roots.size() == 2);
+
+    roots = mathllm::polynomial_roots(poly("x^2 - 2"));
+    assert(roots.size() == 2);
+    for (const auto& root : roots) {
+        assert(std::abs(std::abs(SymEngine::eval_double(*root)) - std::sqrt(2.0)) < 1e-12);
+    }
+
+    roots = mathllm::polynomial_roots(poly("x^3 - 2"));
+    assert(roots.size() == 3);
+
+    // Degree five with no rational roots falls back to the companion matrix.
+    const DensePoly quintic = poly("x^5 - x - 1");
+    const auto numeric = mathllm::numeric_roots(quintic);
+    assert(numeric.size() == 5);
+    for (const auto& z : numeric) {
+        assert(std::abs(std::pow(z, 5) - z - 1.0) < 1e-9);
+    }
+    assert(mathllm::polynomial_roots(quintic).size() == 5);
+    std::cout << "[PASS] test_polynomial_roots\n";
+}
+
+void test_numeric_polynomial_roots() {
+    SymEngine::vec_basic roots;
+    assert(mathllm::numeric_polynomial_roots(SymEngine::parse("x^5 - 1.5*x - 1"), SymEngine::symbol("x"), roots));
+    assert(roots.size() == 5);
+
+    // (x - 0.5)^2 (x + 1): the double root is reported once.
+    assert(mathllm::numeric_polynomial_roots(SymEngine::parse("(x - 0.5)^2*(x + 1)"), SymEngine::symbol("x"), roots));
+    assert(roots.size() == 2);
+    for (const auto& root : roots) {
+        const double value = SymEngine::eval_double(*root);
+        assert(std::abs(value - 0.5) < 1e-10 || std::abs(value + 1.0) < 1e-10);
+    }
+
+    assert(!mathllm::numeric_polynomial_roots(SymEngine::parse("x^2 + a"), SymEngine::symbol("x"), roots));
+    assert(!mathllm::numeric_polynomial_roots(SymEngine::parse("2.5"), SymEngine::symbol("x"), roots));
+    std::cout << "[PASS] test_numeric_polynomial_roots\n";
+}
+
+int main() {
+    std::cout << "=== Dense Polynomial Tests ===\n";
+
+    test_from_basic();
+    test_division_and_gcd();
+    test_calculus();
+    test_square_free();
+    test_rational_roots();
+    test_from_expanded();
+    test_polynomial_roots();
+    test_numeric_polynomial_roots();
+
+    std::cout << "\n[SUCCESS] All dense polynomial tests passed\n";
+    return 0;
+}
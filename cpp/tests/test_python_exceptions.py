@@ -15,7 +15,7 @@ def test_python_exceptions():
         print(f"[PASS] Caught {type(e).__name__}: {e}")
     
     try:
-        mathcore.integrate("tan(x)", "x")
+        mathcore.integrate("exp(x^2)", "x")
         print("[FAIL] Should have raised SymbolicError")
     except Exception as e:
         print(f"[PASS] Caught {type(e).__name__}: {e}")
@@ -0,0 +1,120 @@
+#include "mathllm/quadrature.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+
+mathllm::BatchFunction pointwise(double (*f)(double)) {
+    return [f](const double* x, std::size_t count, double* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = f(x[i]);
+        }
+    };
+}
+
+double inverse_sqrt(double x) { return 1.0 / std::sqrt(x); }
+double gaussian(double x) { return std::exp(-x * x); }
+double peak(double x) { return 1.0 / (1e-4 + (x - 0.3) * (x - 0.3)); }
+double reciprocal(double x) { return 1.0 / x; }
+
+}
+
+void test_gauss_kronrod_smooth() {
+    auto result = mathllm::gauss_kronrod(pointwise(static_cast<double (*)(double)>(std::cos)), 0.0, M_PI / 2);
+    assert(result.converged);
+    assert(std::abs(result.value - 1.0) < 1e-12);
+    assert(result.evaluations == 15 && "A single G7K15 panel suffices for cos on [0, pi/2]");
+    std::cout << "[PASS] test_gauss_kronrod_smooth\n";
+}
+
+void test_gauss_kronrod_adaptive() {
+    auto result = mathllm::gauss_kronrod(pointwise(peak), 0.0, 1.0);
+    const double exact = 100.0 * (std::atan(70.0) + std::atan(30.0));
+    assert(result.converged);
+    assert(std::abs(result.value - exact) < 1e-8 * exact);
+    assert(result.evaluations > 15);
+
+    auto reversed = mathllm::gauss_kronrod(pointwise(peak), 1.0, 0.0);
+    assert(std::abs(reversed.value + result.value) < 1e-12 * exact);
+    std::cout << "[PASS] test_gauss_kronrod_adaptive\n";
+}
+
+void test_infinite_range() {
+    const double inf = std::numeric_limits<double>::infinity();
+    auto result = mathllm::gauss_kronrod(pointwise(gaussian), 0.0, inf);
+    assert(result.converged);
+    assert(std::abs(result.value - std::sqrt(M_PI) / 2) < 1e-9);
+
+    result = mathllm::tanh_sinh(pointwise(gaussian), -inf, inf);
+    assert(std::abs(result.value - std::sqrt(M_PI)) < 1e-9);
+    std::cout << "[PASS] test_infinite_range\n";
+}
+
+void test_tanh_sinh_endpoint_singularity() {
+    auto result = mathllm::tanh_sinh(pointwise(inverse_sqrt), 0.0, 1.0);
+    assert(result.converged);
+    assert(std::abs(result.value - 2.0) < 1e-9);
+
+    bool caught = false;
+    try {
+        mathllm::gauss_kronrod(pointwise(reciprocal), -1.0, 1.0);
+    } catch (const mathllm::NumericError&) {
+        caught = true;
+    }
+    assert(caught && "G7K15 samples the centre, where 1/x is infinite");
+    std::cout << "[PASS] test_tanh_sinh_endpoint_singularity\n";
+}
+
+void test_adaptive_cubature() {
+    auto gaussian_2d = [](const double* x, std::size_t count, double* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = std::exp(-x[2 * i] * x[2 * i] - x[2 * i + 1] * x[2 * i + 1]);
+        }
+    };
+    auto result = mathllm::adaptive_cubature(gaussian_2d, {0.0, 0.0}, {1.0, 1.0});
+    assert(result.converged);
+    assert(std::abs(result.value - 0.7468241328124271 * 0.7468241328124271) < 1e-10);
+
+    auto flipped = mathllm::adaptive_cubature(gaussian_2d, {1.0, 0.0}, {0.0, 1.0});
+    assert(std::abs(flipped.value + result.value) < 1e-12);
+    std::cout << "[PASS] test_adaptive_cubature\n";
+}
+
+void test_qmc_reproducible() {
+    auto product = [](const double* x, std::size_t count, double* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            double value = 1.0;
+            for (std::size_t k = 0; k < 10; ++k) {
+                value *= 2.0 * x[10 * i + k];
+            }
+            out[i] = value;
+        }
+    };
+    const std::vector<double> lower(10, 0.0);
+    const std::vector<double> upper(10, 1.0);
+    auto first = mathllm::qmc_integrate(product, lower, upper, 1e-6, 1e-6, 4096, 8, 123);
+    auto second = mathllm::qmc_integrate(product, lower, upper, 1e-6, 1e-6, 4096, 8, 123);
+    assert(first.value == second.value);
+    assert(first.error_estimate == second.error_estimate);
+    assert(first.evaluations == 4096 * 8);
+    assert(std::abs(first.value - 1.0) < 5.0 * first.error_estimate + 1e-3);
+    std::cout << "[PASS] test_qmc_reproducible\n";
+}
+
+int main() {
+    std::cout << "=== Quadrature Tests ===\n";
+
+    test_gauss_kronrod_smooth();
+    test_gauss_kronrod_adaptive();
+    test_infinite_range();
+    test_tanh_sinh_endpoint_singularity();
+    test_adaptive_cubature();
+    test_qmc_reproducible();
+
+    std::cout << "\n[SUCCESS] All quadrature tests passed\n";
+    return 0;
+}
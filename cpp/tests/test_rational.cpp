@@ -0,0 +1,99 @@
+#include "mathllm/rational.h"
+#include "mathllm/symbolic.h"
+#include "mathllm/verifier.h"
+
+#include <symengine/basic.h>
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace {
+
+SymEngine::tribool rational_equal(const std::string& lhs, const std::string& rhs) {
+    return mathllm::rational_equal(SymEngine::parse(lhs), SymEngine::parse(rhs));
+}
+
+bool same(const std::string& lhs, const std::string& rhs) {
+    return SymEngine::eq(*SymEngine::parse(lhs), *SymEngine::parse(rhs));
+}
+
+}
+
+void test_cancel() {
+    assert(same(mathllm::cancel("(x^2 - 1)/(x - 1)"), "x + 1"));
+    assert(same(mathllm::cancel("1/(x - 1) - 1/(x + 1)"), "2/(x^2 - 1)"));
+    assert(same(mathllm::cancel("(x^3*y - x*y^3)/(x^2*y + 2*x*y^2 + y^3)"), "(x^2 - x*y)/(x + y)"));
+    assert(same(mathllm::cancel("(6*x^2 + 6*x)/(4*x)"), "(3*x + 3)/2"));
+    // Numerator and denominator are scaled so the denominator leads with a
+    // positive coefficient.
+    assert(same(mathllm::cancel("(x - y)/(y - x)"), "-1"));
+    std::cout << "[PASS] test_cancel\n";
+}
+
+void test_rational_form() {
+    auto form = mathllm::rational_form("(a*x + a*y)/(x^2 - y^2)");
+    assert(form.reduced);
+    assert(same(form.numerator.str(), "a"));
+    assert(same(form.denominator.str(), "x - y"));
+    assert(form.generators.size() == 3);
+
+    // Non-rational subterms are generators; function arguments are put in
+    // normal form first.
+    form = mathllm::rational_form("sin((x^2 - 1)/(x - 1)) - sin(x + 1)");
+    assert(form.numerator.str() == "0");
+    form = mathllm::rational_form("(sqrt(x)^3 - sqrt(x))/(x - 1)");
+    assert(same(form.numerator.str(), "sqrt(x)"));
+    assert(same(form.denominator.str(), "1"));
+
+    bool threw = false;
+    try {
+        mathllm::rational_form("1/(x - x)");
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_rational_form\n";
+}
+
+void test_rational_equal() {
+    assert(rational_equal("1/(x - 1) - 1/(x + 1)", "2/(x^2 - 1)") == SymEngine::tribool::tritrue);
+    assert(rational_equal("(x + y)^3/(x^2 - y^2)", "(x + y)^2/(x - y)") == SymEngine::tribool::tritrue);
+    assert(rational_equal("x/(x + 1)", "1/(x + 1)") == SymEngine::tribool::trifalse);
+    assert(rational_equal("tan(x)/(tan(x)^2 - 1)", "1/(tan(x) - 1) - 1/(tan(x)^2 - 1)") == SymEngine::tribool::tritrue);
+    // A nonzero numerator over sin and cos proves nothing: they are not
+    // independent.
+    assert(rational_equal("sin(x)^2 + cos(x)^2", "1") == SymEngine::tribool::indeterminate);
+    // Exponents past the cap are left to the later tiers, not truncated.
+    assert(rational_equal("x^4294967297", "x") == SymEngine::tribool::indeterminate);
+    assert(rational_equal("x^18446744073709551617", "x") == SymEngine::tribool::indeterminate);
+    assert(rational_equal("x^(4294967297/2)", "sqrt(x)") == SymEngine::tribool::indeterminate);
+    assert(rational_equal("x^40000*x^40000", "x^80000") == SymEngine::tribool::indeterminate);
+    std::cout << "[PASS] test_rational_equal\n";
+}
+
+void test_verifier_tier() {
+    assert(mathllm::verify_equal("1/(x - 1) - 1/(x + 1)", "2/(x^2 - 1)", 1000.0));
+    assert(!mathllm::verify_equal("1/(x - 1)", "1/(x + 1)", 1000.0));
+    assert(mathllm::verify_equal("(x^4 - y^4)/(x - y)", "(x + y)*(x^2 + y^2)", 1000.0));
+    assert(!mathllm::verify_equal("(x^4 - y^4)/(x - y)", "(x + y)*(x^2 - y^2)", 1000.0));
+    assert(!mathllm::verify_equal("x^4294967297", "x", 1000.0));
+
+    const auto result = mathllm::check_antiderivative("log(x) - log(x + 1)", "1/(x^2 + x)", "x");
+    assert(result.ok);
+    assert(result.method == "symbolic");
+    std::cout << "[PASS] test_verifier_tier\n";
+}
+
+int main() {
+    std::cout << "=== Rational Normal Form Tests ===\n";
+
+    test_cancel();
+    test_rational_form();
+    test_rational_equal();
+    test_verifier_tier();
+
+    std::cout << "\n[SUCCESS] All rational normal form tests passed\n";
+    return 0;
+}
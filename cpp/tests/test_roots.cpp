@@ -0,0 +1,151 @@
+#include "mathllm/roots.h"
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Coefficients (low to high) of prod (x - r) over roots.
+std::vector<double> from_roots(const std::vector<double>& roots) {
+    std::vector<double> c = {1.0};
+    for (double r : roots) {
+        std::vector<double> next(c.size() + 1, 0.0);
+        for (std::size_t k = 0; k < c.size(); ++k) {
+            next[k + 1] += c[k];
+            next[k] -= r * c[k];
+        }
+        c = next;
+    }
+    return c;
+}
+
+}
+
+void test_simple_roots() {
+    // x^5 - x - 1: one real root, two conjugate pairs.
+    const auto result = mathllm::find_polynomial_roots({-1.0, -1.0, 0.0, 0.0, 0.0, 1.0});
+    assert(result.converged);
+    assert(result.method == "aberth");
+    assert(result.roots.size() == 5);
+    int real = 0;
+    for (const auto& root : result.roots) {
+        assert(root.multiplicity == 1);
+        const auto z = root.value;
+        assert(std::abs(std::pow(z, 5) - z - 1.0) < 1e-12);
+        assert(root.error_estimate < 1e-10);
+        real += z.imag() == 0.0 ? 1 : 0;
+    }
+    assert(real == 1);
+    assert(std::abs(result.roots[4].value.real() - 1.1673039782614187) < 1e-13);
+
+    // An exhausted iteration budget falls back to the companion matrix.
+    const auto fallback = mathllm::find_polynomial_roots({-1.0, -1.0, 0.0, 0.0, 0.0, 1.0}, 1e-14, 1);
+    assert(fallback.method == "companion");
+    assert(fallback.converged);
+    assert(fallback.roots.size() == 5);
+    assert(std::abs(fallback.roots[4].value.real() - 1.1673039782614187) < 1e-13);
+    std::cout << "[PASS] test_simple_roots\n";
+}
+
+void test_multiplicity() {
+    // (x - 1)^3 (x + 2)^2 x^2 (x - 0.5)
+    auto c = from_roots({1.0, 1.0, 1.0, -2.0, -2.0, 0.5});
+    c.insert(c.begin(), 2, 0.0);
+    const auto result = mathllm::find_polynomial_roots(c);
+    assert(result.roots.size() == 4);
+    const double expected[] = {-2.0, 0.0, 0.5, 1.0};
+    const int multiplicity[] = {2, 2, 1, 3};
+    for (int i = 0; i < 4; ++i) {
+        assert(result.roots[i].multiplicity == multiplicity[i]);
+        assert(std::abs(result.roots[i].value - expected[i]) < 1e-10);
+        assert(result.roots[i].value.imag() == 0.0);
+    }
+    std::cout << "[PASS] test_multiplicity\n";
+}
+
+void test_degenerate_inputs() {
+    // Trailing zero coefficients are dropped; constants have no roots.
+    auto result = mathllm::find_polynomial_roots({-6.0, 2.0, 0.0, 0.0});
+    assert(result.roots.size() == 1);
+    assert(std::abs(result.roots[0].value - 3.0) < 1e-15);
+    assert(mathllm::find_polynomial_roots({4.0}).roots.empty());
+
+    bool threw = false;
+    try {
+        mathllm::find_polynomial_roots({0.0, 0.0});
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        mathllm::find_polynomial_roots({1.0, std::numeric_limits<double>::quiet_NaN()});
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_degenerate_inputs\n";
+}
+
+void test_wilkinson() {
+    // Wilkinson's polynomial of degree 12: clustered, badly conditioned roots.
+    std::vector<double> roots;
+    for (int k = 1; k <= 12; ++k) {
+        roots.push_back(k);
+    }
+    const auto result = mathllm::find_polynomial_roots(from_roots(roots));
+    assert(result.roots.size() == 12);
+    for (int k = 0; k < 12; ++k) {
+        assert(result.roots[k].multiplicity == 1);
+        assert(std::abs(result.roots[k].value - static_cast<double>(k + 1)) < 1e-6);
+    }
+    std::cout << "[PASS] test_wilkinson\n";
+}
+
+void test_batch() {
+    std::vector<std::vector<double>> polys;
+    for (int k = 1; k <= 50; ++k) {
+        polys.push_back(from_roots({-1.0 * k, 0.25 * k, 2.0 + k}));
+    }
+    polys.push_back({1.0, 0.0, 1.0});
+    const auto results = mathllm::find_polynomial_roots_batch(polys);
+    assert(results.size() == polys.size());
+    for (int k = 1; k <= 50; ++k) {
+        const auto& roots = results[k - 1].roots;
+        assert(roots.size() == 3);
+        assert(std::abs(roots[0].value + 1.0 * k) < 1e-10 * k);
+        assert(std::abs(roots[1].value - 0.25 * k) < 1e-10 * k);
+        assert(std::abs(roots[2].value - (2.0 + k)) < 1e-10 * k);
+    }
+    const auto& i_roots = results.back().roots;
+    assert(i_roots.size() == 2);
+    assert(std::abs(i_roots[0].value - std::complex<double>(0.0, -1.0)) < 1e-14);
+    assert(std::abs(i_roots[1].value - std::complex<double>(0.0, 1.0)) < 1e-14);
+
+    bool threw = false;
+    try {
+        mathllm::find_polynomial_roots_batch({{1.0, 1.0}, {0.0}});
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_batch\n";
+}
+
+int main() {
+    std::cout << "=== Polynomial Root Finder Tests ===\n";
+
+    test_simple_roots();
+    test_multiplicity();
+    test_degenerate_inputs();
+    test_wilkinson();
+    test_batch();
+
+    std::cout << "\n[SUCCESS] All root finder tests passed\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "mathllm/series.h"
+
+#include <symengine/basic.h>
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool same(const mathllm::Expression& lhs, const std::string& rhs) {
+    const auto difference = SymEngine::expand(SymEngine::sub(lhs.get(), SymEngine::parse(rhs)));
+    return SymEngine::eq(*difference, *SymEngine::zero);
+}
+
+bool coefficients_are(const mathllm::SeriesResult& result, const std::vector<std::string>& expected) {
+    if (result.coefficients.size() != expected.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        if (!same(result.coefficients[i], expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void test_taylor() {
+    auto result = mathllm::series("sin(x)", "x", "0", 8);
+    assert(result.valuation == 1);
+    assert(result.order == 8);
+    assert(coefficients_are(result, {"1", "0", "-1/6", "0", "1/120", "0", "-1/5040"}));
+    assert(same(result.expansion, "x - x^3/6 + x^5/120 - x^7/5040"));
+
+    result = mathllm::series("exp(x)", "x", "1", 4);
+    assert(result.valuation == 0);
+    assert(coefficients_are(result, {"E", "E", "E/2", "E/6"}));
+
+    result = mathllm::series("sqrt(1 + x)", "x", "0", 3);
+    assert(coefficients_are(result, {"1", "1/2", "-1/8"}));
+
+    result = mathllm::series("atan(x) + log(1 + x)", "x", "0", 4);
+    assert(coefficients_are(result, {"2", "-1/2", "0"}));
+    assert(result.valuation == 1);
+
+    result = mathllm::series("tan(x)", "x", "0", 6);
+    assert(coefficients_are(result, {"1", "0", "1/3", "0", "2/15"}));
+    std::cout << "[PASS] test_taylor\n";
+}
+
+void test_laurent() {
+    auto result = mathllm::series("1/(x*sin(x))", "x", "0", 4);
+    assert(result.valuation == -2);
+    assert(coefficients_are(result, {"1", "0", "1/6", "0", "7/360", "0"}));
+
+    // The leading terms cancel, so the driver needs more working precision.
+    result = mathllm::series("(sin(x) - x)/x^3", "x", "0", 3);
+    assert(result.valuation == 0);
+    assert(coefficients_are(result, {"-1/6", "0", "1/120"}));
+
+    result = mathllm::series("cos(x)^2 + sin(x)^2", "x", "0", 5);
+    assert(coefficients_are(result, {"1", "0", "0", "0", "0"}));
+
+    // Tiny exact coefficients are not rounded away.
+    result = mathllm::series("exp(-40)*x", "x", "0", 3);
+    assert(result.valuation == 1);
+    assert(coefficients_are(result, {"exp(-40)", "0"}));
+    std::cout << "[PASS] test_laurent\n";
+}
+
+void test_series_at_infinity() {
+    auto result = mathllm::series("x/(x + 1)", "x", "oo", 3);
+    assert(result.valuation == 0);
+    assert(coefficients_are(result, {"1", "-1", "1"}));
+    assert(same(result.expansion, "1 - 1/x + 1/x^2"));
+
+    result = mathllm::series("x*sin(1/x)", "x", "-oo", 3);
+    assert(coefficients_are(result, {"1", "0", "-1/6"}));
+    std::cout << "[PASS] test_series_at_infinity\n";
+}
+
+void test_series_errors() {
+    const std::vector<std::string> not_laurent = {"exp(1/x)", "log(x)", "sqrt(x)"};
+    for (const auto& expr : not_laurent) {
+        bool threw = false;
+        try {
+            mathllm::series(expr, "x", "0", 4);
+        } catch (const mathllm::SymbolicError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    bool threw = false;
+    try {
+        mathllm::series("x", "x", "0", 0);
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_series_errors\n";
+}
+
+void test_limit_exact() {
+    auto result = mathllm::limit("x^2 + 1", "x", "2");
+    assert(result.method == "substitution");
+    assert(result.value.str() == "5");
+
+    result = mathllm::limit("sin(x)/x", "x", "0");
+    assert(result.method == "series");
+    assert(result.value.str() == "1");
+    assert(result.confidence == 1.0);
+
+    result = mathllm::limit("exp(-35)*sin(x)/x", "x", "0");
+    assert(result.method == "series");
+    assert(same(result.value, "exp(-35)"));
+
+    result = mathllm::limit("(1 - cos(x))/x^2", "x", "0");
+    assert(result.value.str() == "1/2");
+
+    result = mathllm::limit("(1 + 1/x)^x", "x", "oo");
+    assert(result.value.str() == "E");
+
+    result = mathllm::limit("sqrt(x^2 + x) - x", "x", "oo");
+    assert(result.value.str() == "1/2");
+
+    result = mathllm::limit("1/x", "x", "0", "+");
+    assert(result.value.name() == "oo");
+    result = mathllm::limit("1/x", "x", "0", "-");
+    assert(result.value.name() == "-oo");
+    // The one-sided limits differ.
+    result = mathllm::limit("1/x", "x", "0");
+    assert(result.value.str() == "nan");
+    assert(result.confidence == 1.0);
+
+    result = mathllm::limit("abs(x)/x", "x", "0", "-");
+    assert(result.value.str() == "-1");
+    std::cout << "[PASS] test_limit_exact\n";
+}
+
+void test_limit_numeric() {
+    // No Laurent expansion at 0: Richardson extrapolation takes over.
+    auto result = mathllm::limit("exp(-1/x)/x", "x", "0", "+");
+    assert(result.method == "richardson");
+    assert(std::abs(result.value.approximation().real()) < 1e-10);
+    assert(result.confidence > 0.5);
+
+    result = mathllm::limit("exp(1/x)", "x", "0", "+");
+    assert(result.method == "richardson");
+    assert(result.value.name() == "oo");
+
+    result = mathllm::limit("exp(1/x)", "x", "0");
+    assert(result.value.str() == "nan");
+
+    bool threw = false;
+    try {
+        mathllm::limit("x", "x", "0", "left");
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_limit_numeric\n";
+}
+
+int main() {
+    std::cout << "=== Series Tests ===\n";
+
+    test_taylor();
+    test_laurent();
+    test_series_at_infinity();
+    test_series_errors();
+    test_limit_exact();
+    test_limit_numeric();
+
+    std::cout << "\n[SUCCESS] All series tests passed\n";
+    return 0;
+}
@@ -0,0 +1,375 @@
+#include "mathllm/solution_set.h"
+#include "mathllm/solver.h"
+#include "mathllm/symbolic.h"
+
+#include <symengine/eval_double.h>
+#include <symengine/parser.h>
+#include <symengine/symbol.h>
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void test_transcendental_roots() {
+    auto result = mathllm::find_real_roots("x*exp(x)", "2", "x", -10.0, 10.0);
+    assert(result.complete);
+    assert(result.roots.size() == 1);
+    assert(result.roots[0].verified);
+    assert(std::abs(result.roots[0].value - 0.8526055020137255) < 1e-12);
+    assert(result.roots[0].error_bound < 1e-11);
+
+    result = mathllm::find_real_roots("cos(x)", "x", "x", -100.0, 100.0);
+    assert(result.roots.size() == 1);
+    assert(std::abs(result.roots[0].value - 0.7390851332151607) < 1e-12);
+    std::cout << "[PASS] test_transcendental_roots\n";
+}
+
+void test_all_roots_in_interval() {
+    const auto result = mathllm::find_real_roots("sin(x)", "0", "x", -10.0, 10.0);
+    assert(result.roots.size() == 7);
+    for (int k = -3; k <= 3; ++k) {
+        const auto& root = result.roots[k + 3];
+        assert(root.verified);
+        assert(std::abs(root.value - k * M_PI) <= root.error_bound + 1e-15);
+        assert(root.error_bound < 1e-10);
+    }
+
+    // log(x) is undefined left of zero; those boxes are discarded.
+    const auto log_roots = mathllm::find_real_roots("log(x)", "0", "x", -5.0, 5.0);
+    assert(log_roots.roots.size() == 1);
+    assert(std::abs(log_roots.roots[0].value - 1.0) < 1e-12);
+
+    // The poles of tan(x) - x are not roots; the triple root at 0 is an
+    // unverified cluster.
+    const auto tan_roots = mathllm::find_real_roots("tan(x)", "x", "x", -5.0, 5.0);
+    assert(tan_roots.roots.size() == 3);
+    for (const auto& root : tan_roots.roots) {
+        assert(std::abs(std::tan(root.value) - root.value) < 1e-6);
+    }
+    std::cout << "[PASS] test_all_roots_in_interval\n";
+}
+
+void test_unverified_double_root() {
+    const auto result = mathllm::find_real_roots("(x - 1)^2", "0", "x", -3.0, 5.0);
+    assert(result.roots.size() == 1);
+    assert(!result.roots[0].verified);
+    assert(std::abs(result.roots[0].value - 1.0) <= result.roots[0].error_bound);
+    std::cout << "[PASS] test_unverified_double_root\n";
+}
+
+void test_invalid_input() {
+    bool threw = false;
+    try {
+        mathllm::find_real_roots("x", "0", "x", 1.0, -1.0);
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        mathllm::find_real_roots("x +", "0", "x", -1.0, 1.0);
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_invalid_input\n";
+}
+
+void test_solve_equation_fallback() {
+    const std::string solutions = mathllm::solve_equation("x*exp(x)", "2", "x");
+    assert(solutions.find("0.85260550201") != std::string::npos);
+    assert(mathllm::solve_equation("cos(x)", "x", "x").find("0.73908513321") != std::string::npos);
+    std::cout << "[PASS] test_solve_equation_fallback\n";
+}
+
+void test_solve_equation_set() {
+    auto result = mathllm::solve_equation_set("(x - 1)^2*(x + 2)", "0", "x");
+    assert(result.method == "polynomial");
+    assert(result.str == mathllm::solve_equation("(x - 1)^2*(x + 2)", "0", "x"));
+    assert(result.elements.size() == 2);
+    for (const auto& element : result.elements) {
+        assert(element.value.kind() == "Integer");
+        assert(element.multiplicity == (element.value.name() == "1" ? 2 : 1));
+        assert(element.approximation.real() == std::stod(element.value.name()));
+    }
+
+    // Complex roots split into real and imaginary parts.
+    result = mathllm::solve_equation_set("x^2", "-1", "x");
+    assert(result.elements.size() == 2);
+    for (const auto& element : result.elements) {
+        assert(element.value.kind() == "Complex");
+        const auto parts = element.value.args();
+        assert(parts[0].name() == "0");
+        assert(std::abs(element.approximation.imag()) == 1.0);
+    }
+
+    result = mathllm::solve_equation_set("x", "log(2)", "x");
+    assert(result.elements.size() == 1);
+    assert(result.elements[0].value.kind() == "Function");
+    assert(result.elements[0].value.name() == "log");
+    assert(std::abs(result.elements[0].approximation.real() - std::log(2.0)) < 1e-15);
+
+    result = mathllm::solve_equation_set("x*exp(x)", "2", "x");
+    assert(result.method == "interval_bisection");
+    assert(result.elements[0].value.kind() == "Float");
+
+    // Only verified roots are listed; the unverified one at 0 and the reals
+    // outside the scanned range stay behind as a condition.
+    result = mathllm::solve_equation_set("tan(x)", "x", "x");
+    assert(result.method == "interval_bisection");
+    assert(!result.elements.empty());
+    for (const auto& element : result.elements) {
+        const double value = element.approximation.real();
+        assert(std::abs(value) > 1.0 && std::abs(std::tan(value) - value) < 1e-6);
+    }
+    assert(result.conditions.size() == 1);
+
+    // No real roots to fall back on: the ConditionSet is kept as a marker.
+    result = mathllm::solve_equation_set("exp(x) + x^2", "-1", "x");
+    assert(result.elements.empty());
+    assert(result.conditions.size() == 1);
+    assert(std::isnan(result.conditions[0].approximation().real()));
+    std::cout << "[PASS] test_solve_equation_set\n";
+}
+
+void test_solve_system() {
+    // Circle and line: (sqrt(2), sqrt(2)) from a start in the first quadrant.
+    const auto result = mathllm::solve_system({"x^2 + y^2 = 4", "y - x"}, {"x", "y"}, {1.0, 0.5});
+    assert(result.converged);
+    assert(std::abs(result.solution[0] - std::sqrt(2.0)) < 1e-10);
+    assert(std::abs(result.solution[1] - std::sqrt(2.0)) < 1e-10);
+    assert(result.residual_norm <= 1e-10);
+    assert(result.iterations > 0 && result.iterations < 20);
+
+    // Over-determined but consistent: Gauss-Newton steps reach the solution.
+    const auto overdetermined = mathllm::solve_system({"x + y = 3", "x - y = 1", "2*x + y = 5"}, {"x", "y"}, {0.0, 0.0});
+    assert(overdetermined.converged);
+    assert(std::abs(overdetermined.solution[0] - 2.0) < 1e-10);
+    assert(std::abs(overdetermined.solution[1] - 1.0) < 1e-10);
+
+    // Inconsistent: no start can converge.
+    const auto inconsistent = mathllm::solve_system({"x + y = 1", "x + y = 2"}, {"x", "y"}, {0.0, 0.0});
+    assert(!inconsistent.converged);
+    std::cout << "[PASS] test_solve_system\n";
+}
+
+void test_solve_system_multistart() {
+    const std::vector<std::vector<double>> starts = {{1.0, 3.0}, {3.0, 0.0}, {0.5, 2.5}, {2.5, 0.5}};
+    const auto solutions = mathllm::solve_system_multistart({"x*y = 2", "x + y = 3"}, {"x", "y"}, starts);
+    assert(solutions.size() == 2);
+    for (const auto& solution : solutions) {
+        assert(solution.converged);
+        const double x = solution.solution[0];
+        const double y = solution.solution[1];
+        assert((std::abs(x - 1.0) < 1e-10 && std::abs(y - 2.0) < 1e-10)
+               || (std::abs(x - 2.0) < 1e-10 && std::abs(y - 1.0) < 1e-10));
+    }
+    assert(solutions[0].start_index == 0);
+    std::cout << "[PASS] test_solve_system_multistart\n";
+}
+
+void test_solve_system_errors() {
+    bool threw = false;
+    try {
+        mathllm::solve_system({"x + y"}, {"x", "y"}, {1.0});
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        mathllm::solve_system({"x = y = 1"}, {"x", "y"}, {1.0, 1.0});
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_solve_system_errors\n";
+}
+
+void test_linear_exact() {
+    auto result = mathllm::solve_linear_system({"x + y = 3", "x - y = 1"}, {"x", "y"});
+    assert(result.status == "unique");
+    assert(result.method == "fraction_free");
+    assert(result.rank == 2);
+    assert(result.solution.size() == 2 && result.solution[0] == "2" && result.solution[1] == "1");
+    assert(result.values.size() == 2 && result.values[0] == 2.0);
+    assert(result.nullspace.empty());
+
+    result = mathllm::solve_linear_system({"x/2 + y/3 = 1", "x - y"}, {"x", "y"});
+    assert(result.solution[0] == "6/5" && result.solution[1] == "6/5");
+
+    // Symbolic coefficients: x = y = 1/(a + 1).
+    result = mathllm::solve_linear_system({"a*x + y = 1", "x - y = 0"}, {"x", "y"});
+    assert(result.status == "unique");
+    assert(result.values.empty());
+    const auto x = SymEngine::parse(result.solution[0])->subs({{SymEngine::symbol("a"), SymEngine::parse("2")}});
+    assert(std::abs(SymEngine::eval_double(*x) - 1.0 / 3.0) < 1e-15);
+    std::cout << "[PASS] test_linear_exact\n";
+}
+
+void test_linear_rank_deficient() {
+    auto result = mathllm::solve_linear_system({"x + y + z = 1", "2*x + 2*y + 2*z = 2"}, {"x", "y", "z"});
+    assert(result.status == "infinite");
+    assert(result.rank == 1);
+    assert(result.solution[0] == "1" && result.solution[1] == "0" && result.solution[2] == "0");
+    assert(result.nullspace.size() == 2);
+    assert(result.nullspace[0][0] == "-1" && result.nullspace[0][1] == "1" && result.nullspace[0][2] == "0");
+
+    result = mathllm::solve_linear_system({"x + y = 1", "x + y = 2"}, {"x", "y"});
+    assert(result.status == "inconsistent");
+    assert(result.solution.empty());
+
+    result = mathllm::solve_linear_system({"0.5*x + 0.5*y = 1", "x + y = 2"}, {"x", "y"});
+    assert(result.method == "dense_lu");
+    assert(result.status == "infinite");
+    assert(result.nullspace.size() == 1);
+    std::cout << "[PASS] test_linear_rank_deficient\n";
+}
+
+void test_linear_numeric() {
+    auto result = mathllm::solve_linear_system({"0.5*x + y = 1", "x - y = 0.5"}, {"x", "y"});
+    assert(result.method == "dense_lu");
+    assert(result.status == "unique");
+    assert(std::abs(result.values[0] - 1.0) < 1e-14 && std::abs(result.values[1] - 0.5) < 1e-14);
+
+    // Tridiagonal 100 x 100: large and sparse, so sparse LU.
+    const int n = 100;
+    std::vector<std::string> equations;
+    std::vector<std::string> vars;
+    for (int i = 0; i < n; ++i) {
+        vars.push_back("x" + std::to_string(i));
+    }
+    for (int i = 0; i < n; ++i) {
+        std::string equation = "2*" + vars[i];
+        if (i > 0) {
+            equation += " - " + vars[i - 1];
+        }
+        if (i + 1 < n) {
+            equation += " - " + vars[i + 1];
+        }
+        equations.push_back(equation + " = 1");
+    }
+    result = mathllm::solve_linear_system(equations, vars);
+    assert(result.method == "sparse_lu");
+    assert(result.status == "unique");
+    for (int i = 0; i < n; ++i) {
+        // Discrete Poisson solution: x_i = (i + 1) (n - i) / 2.
+        assert(std::abs(result.values[i] - 0.5 * (i + 1) * (n - i)) < 1e-8);
+    }
+
+    bool threw = false;
+    try {
+        mathllm::solve_linear_system({"x*y = 1"}, {"x", "y"});
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_linear_numeric\n";
+}
+
+void test_solve_parametric() {
+    const auto quadratic = mathllm::solve_parametric("a*x^2 + b*x + c", "0", "x", {"a", "b", "c"});
+    assert(quadratic.width() == 2);
+    assert(quadratic.cases().size() == 2);
+    assert(quadratic.cases()[0].condition == "a != 0");
+    assert(quadratic.cases()[0].solutions.size() == 2);
+    assert(quadratic.cases()[1].condition == "a == 0 and b != 0");
+    assert(quadratic.cases()[1].solutions.size() == 1);
+
+    const auto rows = quadratic.evaluate({{1.0, -3.0, 2.0}, {1.0, 0.0, 1.0}, {0.0, 2.0, -4.0}, {0.0, 0.0, 1.0}, {2.0, 4.0, 2.0}});
+    assert(rows.size() == 5);
+    assert(std::abs(rows[0][0] - 1.0) < 1e-15 && std::abs(rows[0][1] - 2.0) < 1e-15);
+    // Complex roots, the linear case, no case at all, a double root.
+    assert(std::isnan(rows[1][0]) && std::isnan(rows[1][1]));
+    assert(rows[2][0] == 2.0 && std::isnan(rows[2][1]));
+    assert(std::isnan(rows[3][0]) && std::isnan(rows[3][1]));
+    assert(rows[4][0] == -1.0 && rows[4][1] == -1.0);
+
+    // Cubics have no real-valued closed form: roots come from the
+    // polynomial root finder on the compiled coefficients.
+    const auto cubic = mathllm::solve_parametric("x^3 - p*x", "q", "x", {"p", "q"});
+    assert(cubic.width() == 3);
+    assert(cubic.cases().size() == 1);
+    assert(cubic.cases()[0].condition.empty());
+    assert(cubic.cases()[0].solutions.empty());
+    std::vector<double> points;
+    for (int k = 1; k <= 100; ++k) {
+        points.push_back(0.5 * k);
+        points.push_back(0.0);
+    }
+    std::vector<double> out(3 * 100);
+    cubic.evaluate_batch(points.data(), 100, out.data());
+    for (int k = 1; k <= 100; ++k) {
+        const double root = std::sqrt(0.5 * k);
+        assert(std::abs(out[3 * (k - 1)] + root) < 1e-12);
+        assert(std::abs(out[3 * (k - 1) + 1]) < 1e-12);
+        assert(std::abs(out[3 * (k - 1) + 2] - root) < 1e-12);
+    }
+
+    // Not polynomial in x: the FiniteSet from SymEngine::solve.
+    const auto rational = mathllm::solve_parametric("a/x", "b", "x", {"a", "b"});
+    assert(rational.width() == 1);
+    assert(std::abs(rational.evaluate({{3.0, 4.0}})[0][0] - 0.75) < 1e-15);
+    // A solution that only rounding separates from a pole is still excluded.
+    const auto pole = mathllm::solve_parametric("(10*x - 3)/(x - b)", "0", "x", {"b"});
+    assert(std::abs(pole.evaluate({{1.0}})[0][0] - 0.3) < 1e-15);
+    assert(std::isnan(pole.evaluate({{0.1 + 0.2}})[0][0]));
+
+    // A perfect square lists its root twice.
+    const auto square = mathllm::solve_parametric("x^2 - 2*a*x + a^2", "0", "x", {"a"});
+    assert(square.width() == 2);
+    assert(square.cases()[0].solutions.size() == 2);
+    const auto doubled = square.evaluate({{1.5}})[0];
+    assert(doubled[0] == 1.5 && doubled[1] == 1.5);
+
+    bool threw = false;
+    try {
+        mathllm::solve_parametric("x", "a", "x", {"x"});
+    } catch (const mathllm::NumericError&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        mathllm::solve_parametric("a*y", "1", "x", {"a", "y"});
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+    // Degrees that would wrap as int, or exceed the dense cap, are refused.
+    for (const std::string degree : {"4294967298", "3000000000", "100000000"}) {
+        threw = false;
+        try {
+            mathllm::solve_parametric("x^" + degree, "a", "x", {"a"});
+        } catch (const mathllm::SymbolicError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "[PASS] test_solve_parametric\n";
+}
+
+int main() {
+    std::cout << "=== Numeric Solver Tests ===\n";
+
+    test_transcendental_roots();
+    test_all_roots_in_interval();
+    test_unverified_double_root();
+    test_invalid_input();
+    test_solve_equation_fallback();
+    test_solve_equation_set();
+    test_solve_system();
+    test_solve_system_multistart();
+    test_solve_system_errors();
+    test_linear_exact();
+    test_linear_rank_deficient();
+    test_linear_numeric();
+    test_solve_parametric();
+
+    std::cout << "\n[SUCCESS] All numeric solver tests passed\n";
+    return 0;
+}
@@ -9,6 +9,9 @@ int main() {
     assert(mathllm::diff("x^2", "x") == "2*x");
     assert(mathllm::diff("sin(x)", "x") == "cos(x)");
     assert(mathllm::diff("exp(x)", "x") == "exp(x)");
+    // Exponents past the dense-polynomial cap go through SymEngine intact.
+    assert(mathllm::diff("x^3000000000", "x").find("3000000000") != std::string::npos);
+    assert(mathllm::diff("x^4294967298", "x").find("4294967298") != std::string::npos);
 
     assert(mathllm::integrate("2*x", "x") == "x^2");
     assert(mathllm::integrate("cos(x)", "x") == "sin(x)");
@@ -20,8 +23,20 @@ int main() {
 
     assert(mathllm::solve_equation("x", "5", "x") == "[5]");
 
-    assert(mathllm::verify_equal("x^2 + 2*x + 1", "(x + 1)^2"));
-    assert(!mathllm::verify_equal("x^2", "x^3"));
+    assert(mathllm::verify_equal("x^2 + 2*x + 1", "(x + 1)^2", 1000.0));
+    assert(!mathllm::verify_equal("x^2", "x^3", 1000.0));
+
+    assert(mathllm::simplify("sin(x)^2 + cos(x)^2") == "1");
+    assert(mathllm::simplify("(x^2 - 1)/(x - 1)") == "1 + x");
+    assert(mathllm::simplify("tan(x)*cos(x)") == "sin(x)");
+    // sqrt(sin(x))/sqrt(cos(x)) and sqrt(tan(x)) differ where cos(x) < 0.
+    assert(mathllm::simplify("sqrt(sin(x))/sqrt(cos(x))").find("tan") == std::string::npos);
+    assert(mathllm::simplify("sin(x)^(1/3)*cos(x)^(-1/3)").find("tan") == std::string::npos);
+    assert(mathllm::simplify("(x + 1)^2 - x^2", 100.0, "nodes") == "1 + 2*x");
+    assert(mathllm::verify_equal(mathllm::simplify("exp(2*log(x) + 1)"), "E*x^2", 1000.0));
+    assert(mathllm::simplify("sin(x)^2 + cos(x)^2", 0.0) != "1");
+    // Powers past the limit are left alone rather than expanded.
+    assert(mathllm::simplify("sin(x)^100000").find("100000") != std::string::npos);
 
     bool threw = false;
     try {
@@ -31,5 +46,13 @@ int main() {
     }
     assert(threw);
 
+    threw = false;
+    try {
+        mathllm::simplify("x", 100.0, "length");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
     return 0;
 }
@@ -0,0 +1,99 @@
+#include "mathllm/trig.h"
+#include "mathllm/symbolic.h"
+
+#include <symengine/basic.h>
+#include <symengine/parser.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace {
+
+SymEngine::tribool trig_equal(const std::string& lhs, const std::string& rhs) {
+    return mathllm::trig_equal(SymEngine::parse(lhs), SymEngine::parse(rhs));
+}
+
+bool same(const std::string& lhs, const std::string& rhs) {
+    return SymEngine::eq(*SymEngine::parse(lhs), *SymEngine::parse(rhs));
+}
+
+}
+
+void test_canonical() {
+    assert(same(mathllm::trig_canonical("sin(x)^2*cos(x)"), "cos(x)/4 - cos(3*x)/4"));
+    assert(same(mathllm::trig_canonical("2*sin(x)*cos(x)"), "sin(2*x)"));
+    assert(same(mathllm::trig_canonical("sin(x)^2 + cos(x)^2"), "1"));
+    assert(same(mathllm::trig_canonical("cos(x)*cos(y)"), "cos(x - y)/2 + cos(x + y)/2"));
+    // Half-turn phases fold into the coefficients.
+    assert(same(mathllm::trig_canonical("sin(x + pi/2)"), "cos(x)"));
+    assert(same(mathllm::trig_canonical("cos(x - pi)"), "-cos(x)"));
+    // Equal inputs in different shapes meet in one form.
+    assert(mathllm::trig_canonical("cos(x)^4 - sin(x)^4") == mathllm::trig_canonical("cos(2*x)"));
+    std::cout << "[PASS] test_canonical\n";
+}
+
+void test_trig_equal() {
+    assert(trig_equal("sin(3*x)", "3*sin(x) - 4*sin(x)^3") == SymEngine::tribool::tritrue);
+    assert(trig_equal("cos(x + y)", "cos(x)*cos(y) - sin(x)*sin(y)") == SymEngine::tribool::tritrue);
+    assert(trig_equal("sin(x/2)^2", "(1 - cos(x))/2") == SymEngine::tribool::tritrue);
+    assert(trig_equal("tan(x)", "sin(2*x)/(1 + cos(2*x))") == SymEngine::tribool::tritrue);
+    assert(trig_equal("sec(x)^2 - tan(x)^2", "1") == SymEngine::tribool::tritrue);
+    assert(trig_equal("x*sin(x)^2 + x*cos(x)^2", "x") == SymEngine::tribool::tritrue);
+    assert(trig_equal("sin(x + 1)", "sin(1)*cos(x) + cos(1)*sin(x)") == SymEngine::tribool::tritrue);
+    assert(trig_equal("exp(I*x)", "cos(x) + I*sin(x)") == SymEngine::tribool::tritrue);
+
+    assert(trig_equal("sin(x)", "cos(x)") == SymEngine::tribool::trifalse);
+    assert(trig_equal("sin(2*x)", "2*sin(x)") == SymEngine::tribool::trifalse);
+    // Nonzero coefficients that are not numbers, or angles that are not
+    // combinations of symbols, decide nothing.
+    assert(trig_equal("x*sin(x)", "sin(x)") == SymEngine::tribool::indeterminate);
+    assert(trig_equal("sin(x^2)", "cos(x^2)") == SymEngine::tribool::indeterminate);
+    // Nor do differences that trigonometric functions under other heads
+    // might cancel.
+    assert(trig_equal("abs(sin(x))*sign(sin(x))", "sin(x)") == SymEngine::tribool::indeterminate);
+    assert(trig_equal("sin(x) + abs(cos(x))^2", "sin(x) + cos(x)^2") == SymEngine::tribool::indeterminate);
+    // Powers past the exponent limit are not truncated.
+    assert(trig_equal("sin(x)^18446744073709551617", "sin(x)") == SymEngine::tribool::indeterminate);
+    assert(trig_equal("cos(x)^4294967297", "cos(x)") == SymEngine::tribool::indeterminate);
+    std::cout << "[PASS] test_trig_equal\n";
+}
+
+void test_errors() {
+    bool threw = false;
+    try {
+        mathllm::trig_canonical("(sin(x) + cos(y) + sin(z) + cos(w) + sin(2*v) + cos(3*u))^40");
+    } catch (const mathllm::SymbolicError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        mathllm::trig_canonical("sin(x +");
+    } catch (const mathllm::SymbolicError& e) {
+        threw = std::string(e.what()).find("Parse error") != std::string::npos;
+    }
+    assert(threw);
+    std::cout << "[PASS] test_errors\n";
+}
+
+void test_verifier_tier() {
+    assert(mathllm::verify_equal("sin(x)^4", "3/8 - cos(2*x)/2 + cos(4*x)/8", 1000.0));
+    assert(mathllm::verify_equal("sin(5*x)", "16*sin(x)^5 - 20*sin(x)^3 + 5*sin(x)", 1000.0));
+    assert(!mathllm::verify_equal("cos(2*x)", "2*cos(x)^2", 1000.0));
+    assert(mathllm::simplify("sin(x)^3 + sin(x)*cos(x)^2") == "sin(x)");
+    std::cout << "[PASS] test_verifier_tier\n";
+}
+
+int main() {
+    std::cout << "=== Trigonometric Normal Form Tests ===\n";
+
+    test_canonical();
+    test_trig_equal();
+    test_errors();
+    test_verifier_tier();
+
+    std::cout << "\n[SUCCESS] All trigonometric normal form tests passed\n";
+    return 0;
+}
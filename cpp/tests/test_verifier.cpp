@@ -0,0 +1,97 @@
+#include "mathllm/verifier.h"
+
+#include <symengine/symengine_exception.h>
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+void test_check_antiderivative() {
+    auto result = mathllm::check_antiderivative("x^3/3 + sin(x)", "x^2 + cos(x)", "x");
+    assert(result.ok);
+    assert(result.method == "symbolic");
+
+    result = mathllm::check_antiderivative("sin(x)^2/2", "sin(x)*cos(x)", "x");
+    assert(result.ok);
+
+    result = mathllm::check_antiderivative("-cos(x)^2/2", "sin(x)*cos(x)", "x");
+    assert(result.ok && "Antiderivatives differing by a constant both pass");
+
+    result = mathllm::check_antiderivative("log(1 + x^2)", "x/(1 + x^2)", "x");
+    assert(!result.ok);
+    assert(result.method == "failed");
+    assert(result.max_error > 0.1);
+    std::cout << "[PASS] test_check_antiderivative\n";
+}
+
+void test_check_roots() {
+    auto result = mathllm::check_roots("x^2 - 2", "x", {"sqrt(2)", "-sqrt(2)"});
+    assert(result.ok);
+    assert(result.roots.size() == 2);
+
+    result = mathllm::check_roots("x^2 + 1", "x", {"I", "-I", "1"});
+    assert(!result.ok);
+    assert(result.roots[0].ok && result.roots[1].ok);
+    assert(!result.roots[2].ok);
+
+    result = mathllm::check_roots("x^2 - a^2", "x", {"a"});
+    assert(result.ok && result.roots[0].method == "symbolic");
+
+    result = mathllm::check_roots("x^3 - 1000001", "x", {"100.00003333332222"});
+    assert(result.ok && "Floating roots are judged relative to the term sizes");
+    std::cout << "[PASS] test_check_roots\n";
+}
+
+void test_check_ode_solution() {
+    auto result = mathllm::check_ode_solution("3*exp(-2*t)", "-2*y", "t");
+    assert(result.ok);
+
+    result = mathllm::check_ode_solution("1/(1 - t)", "y^2", "t");
+    assert(result.ok);
+
+    result = mathllm::check_ode_solution("exp(t)", "t*y", "t");
+    assert(!result.ok);
+    std::cout << "[PASS] test_check_ode_solution\n";
+}
+
+void test_verify_equal_rational() {
+    assert(mathllm::verify_equal("1/(x - 1) - 1/(x + 1)", "2/(x^2 - 1)"));
+    assert(mathllm::verify_equal("(x^2 - y^2)/(x + y)", "x - y"));
+    assert(!mathllm::verify_equal("1/(x - 1)", "1/(x + 1)"));
+    std::cout << "[PASS] test_verify_equal_rational\n";
+}
+
+void test_check_parse_error() {
+    bool caught = false;
+    try {
+        mathllm::check_antiderivative("x +* 2", "1", "x");
+    } catch (const mathllm::VerifierError& e) {
+        caught = std::string(e.what()).find("Parse error") != std::string::npos;
+    }
+    assert(caught);
+
+    // Whatever diff rejects surfaces as VerifierError too.
+    for (const auto& expr : {"floor(x)", "ceiling(x)"}) {
+        try {
+            mathllm::check_antiderivative(expr, "1", "x");
+            mathllm::check_ode_solution(expr, "1", "x", "y");
+        } catch (const mathllm::VerifierError&) {
+        } catch (const SymEngine::SymEngineException&) {
+            assert(false && "diff errors must be reported as VerifierError");
+        }
+    }
+    std::cout << "[PASS] test_check_parse_error\n";
+}
+
+int main() {
+    std::cout << "=== Verifier Check Tests ===\n";
+
+    test_check_antiderivative();
+    test_check_roots();
+    test_check_ode_solution();
+    test_verify_equal_rational();
+    test_check_parse_error();
+
+    std::cout << "\n[SUCCESS] All verifier check tests passed\n";
+    return 0;
+}
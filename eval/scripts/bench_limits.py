@@ -0,0 +1,117 @@
+from __future__ import annotations
+
+import argparse
+import json
+import statistics
+import sys
+import time
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Tuple
+
+import sympy as sp
+
+ROOT = Path(__file__).resolve().parents[2]
+PYTHON_SRC = ROOT / "python" / "src"
+if str(PYTHON_SRC) not in sys.path:
+    sys.path.insert(0, str(PYTHON_SRC))
+
+from mathllm.mir import mathcore_to_sympy  # noqa: E402
+from mathllm.verify import _import_mathcore  # noqa: E402
+
+# (expression, point, direction); the same corpus as BM_Limit_Corpus.
+CORPUS: List[Tuple[str, str, str]] = [
+    ("sin(x)/x", "0", "+-"),
+    ("(1 - cos(x))/x^2", "0", "+-"),
+    ("(exp(x) - 1)/x", "0", "+-"),
+    ("(1 + 1/x)^x", "oo", "+-"),
+    ("sqrt(x^2 + x) - x", "oo", "+-"),
+    ("(x^2 - 1)/(x - 1)", "1", "+-"),
+    ("tan(x)/x", "0", "+-"),
+    ("x*sin(1/x)", "oo", "+-"),
+    ("(sin(x) - x)/x^3", "0", "+-"),
+    ("exp(-1/x)/x", "0", "+"),
+]
+
+
+def _median_ms(fn: Callable[[], Any], repeats: int) -> Tuple[float, Any]:
+    result = None
+    timings = []
+    for _ in range(repeats):
+        start = time.perf_counter()
+        result = fn()
+        timings.append((time.perf_counter() - start) * 1000.0)
+    return statistics.median(timings), result
+
+
+def _sympy_limit(expr: str, point: str, direction: str) -> sp.Expr:
+    x = sp.Symbol("x")
+    parsed = sp.sympify(expr.replace("^", "**"))
+    target = sp.sympify(point)
+    if target.is_infinite:
+        return sp.limit(parsed, x, target)
+    return sp.limit(parsed, x, target, dir=direction)
+
+
+def run(repeats: int) -> List[Dict[str, Any]]:
+    mathcore = _import_mathcore()
+    rows = []
+    for expr, point, direction in CORPUS:
+        native_ms, native = _median_ms(lambda: mathcore.limit(expr, "x", point, direction), repeats)
+        sympy_ms, reference = _median_ms(lambda: _sympy_limit(expr, point, direction), repeats)
+        value = mathcore_to_sympy(native.value)
+        agree = bool(sp.simplify(value - reference) == 0) if value.is_finite else value == reference
+        if not agree and value.is_number and reference.is_number:
+            agree = abs(complex(value) - complex(reference)) <= 10 * native.error_estimate + 1e-9
+        rows.append({
+            "expr": expr,
+            "point": point,
+            "dir": direction,
+            "mathcore": str(value),
+            "method": native.method,
+            "confidence": native.confidence,
+            "sympy": str(reference),
+            "agree": agree,
+            "mathcore_ms": native_ms,
+            "sympy_ms": sympy_ms,
+        })
+    return rows
+
+
+def parse_args(argv: List[str]) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Time mathcore.limit against sympy.limit on a limit corpus")
+    parser.add_argument(
+        "--repeats",
+        type=int,
+        default=5,
+        help="Timed runs per limit; the median is reported (default: 5).",
+    )
+    parser.add_argument(
+        "--output",
+        type=Path,
+        help="Optional path to write the per-limit results as JSON.",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: List[str]) -> int:
+    args = parse_args(argv)
+    rows = run(args.repeats)
+    for row in rows:
+        print(
+            f"{row['expr']:<24} x->{row['point']}{'' if row['dir'] == '+-' else row['dir']:<2} "
+            f"mathcore {row['mathcore']:<10} ({row['method']}, {row['mathcore_ms']:.3f} ms)  "
+            f"sympy {row['sympy']:<10} ({row['sympy_ms']:.3f} ms)  {'ok' if row['agree'] else 'MISMATCH'}"
+        )
+    native_total = sum(row["mathcore_ms"] for row in rows)
+    sympy_total = sum(row["sympy_ms"] for row in rows)
+    speedup = sympy_total / native_total if native_total else float("inf")
+    print(f"Total: mathcore {native_total:.2f} ms, sympy {sympy_total:.2f} ms ({speedup:.1f}x)")
+    if args.output:
+        output_path = args.output if args.output.is_absolute() else (ROOT / args.output)
+        output_path.parent.mkdir(parents=True, exist_ok=True)
+        output_path.write_text(json.dumps(rows, indent=2) + "\n", encoding="utf-8")
+    return 0 if all(row["agree"] for row in rows) else 1
+
+
+if __name__ == "__main__":
+    raise SystemExit(main(sys.argv[1:]))
@@ -47,7 +47,70 @@ class MIRProblem:
 
 
 def expr_to_mathcore_string(expr: sp.Expr) -> str:
-    return str(sp.simplify(expr))
+    """Simplifies with the native core when it is built, with SymPy otherwise."""
+    from .verify import VerificationError, _import_mathcore
+
+    try:
+        mathcore = _import_mathcore()
+    except VerificationError:
+        return str(sp.simplify(expr))
+    return mathcore.simplify(str(expr))
+
+
+# SymEngine function names that differ from SymPy's.
+_MATHCORE_FUNCTIONS = {"abs": sp.Abs, "lambertw": sp.LambertW}
+
+
+def mathcore_to_sympy(expr) -> sp.Expr:
+    """Builds the SymPy expression for a mathcore.Expression from its tree."""
+    kind = expr.kind
+    if kind == "Integer":
+        return sp.Integer(int(expr.name))
+    if kind == "Rational":
+        num, den = expr.args
+        return sp.Rational(int(num.name), int(den.name))
+    if kind == "Float":
+        return sp.Float(expr.approximation.real)
+    if kind == "Complex":
+        real, imag = expr.args
+        return mathcore_to_sympy(real) + sp.I * mathcore_to_sympy(imag)
+    if kind == "Symbol":
+        return sp.Symbol(expr.name)
+    if kind == "Constant":
+        return getattr(sp, expr.name)
+    if kind == "Infinity":
+        return {"oo": sp.oo, "-oo": -sp.oo, "zoo": sp.zoo}[expr.name]
+    args = [mathcore_to_sympy(arg) for arg in expr.args]
+    if kind == "Add":
+        return sp.Add(*args)
+    if kind == "Mul":
+        return sp.Mul(*args)
+    if kind == "Pow":
+        return sp.Pow(*args)
+    if kind == "Function":
+        function = _MATHCORE_FUNCTIONS.get(expr.name) or getattr(sp, expr.name, None) or sp.Function(expr.name)
+        return function(*args)
+    return sp.sympify(str(expr))
+
+
+def solutions_from_mathcore(solution_set) -> List[sp.Expr]:
+    """Solutions of a mathcore.SolutionSet, intervals as sp.Interval.
+
+    An interval_bisection set gives its verified real roots; its condition
+    only stands for roots the scan may have missed. Raises RuntimeError when
+    part of any other set is only known by a condition.
+    """
+    if solution_set.conditions and solution_set.method != "interval_bisection":
+        raise RuntimeError(f"mathcore left the equation unsolved: {solution_set}")
+    solutions: List[sp.Expr] = [mathcore_to_sympy(element.value) for element in solution_set.elements]
+    for interval in solution_set.intervals:
+        solutions.append(sp.Interval(
+            mathcore_to_sympy(interval.start),
+            mathcore_to_sympy(interval.end),
+            interval.left_open,
+            interval.right_open,
+        ))
+    return solutions
 
 
 def _ensure_iterable_symbols(symbols: Iterable[sp.Symbol]) -> List[sp.Symbol]:
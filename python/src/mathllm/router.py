@@ -1,6 +1,5 @@
 from __future__ import annotations
 
-import ast
 import json
 import os
 import time
@@ -13,7 +12,7 @@ from .concise import ConciseConfig, ConciseError, render_concise
 from .explain import TalkerClient, ExplanationStyle, ExplanationResult
 from .guard import preserve_explanation, GuardConfig
 from .latex import LatexParseResult, LatexParseError, parse_expression_from_input
-from .mir import MIRProblem, Objective, from_sympy, expr_to_mathcore_string
+from .mir import MIRProblem, Objective, from_sympy, expr_to_mathcore_string, solutions_from_mathcore
 from .compile import to_numpy_fn, to_octave, to_matlab_stub, to_c_stub, sample_numpy_grid
 from .verify import VerificationResult, verify_all, symbolic_equal, unit_check
 
@@ -121,6 +120,9 @@ class MathRouter:
             from .verify import _import_mathcore
 
             self._mathcore = _import_mathcore()
+            memo_path = os.environ.get("MATHCORE_INTEGRATION_MEMO")
+            if memo_path and os.path.exists(memo_path) and hasattr(self._mathcore, "load_integration_memo"):
+                self._mathcore.load_integration_memo(memo_path)
         return self._mathcore
 
     @staticmethod
@@ -396,15 +398,8 @@ class MathRouter:
         rhs = prepared["rhs"]
         var = prepared["variable"]
         try:
-            result_str = mathcore.solve_equation(expr_to_mathcore_string(lhs), expr_to_mathcore_string(rhs), str(var))
-            try:
-                parsed = ast.literal_eval(result_str)
-                if not isinstance(parsed, list):
-                    parsed = [parsed]
-            except (ValueError, SyntaxError):
-                parsed = [result_str]
-            solutions = [sp.sympify(item) for item in parsed]
-            return solutions, "mathcore"
+            result = mathcore.solve_equation_set(expr_to_mathcore_string(lhs), expr_to_mathcore_string(rhs), str(var))
+            return solutions_from_mathcore(result), "mathcore"
         except RuntimeError:
             solutions = sp.solve(sp.Eq(lhs, rhs), var)
             if not isinstance(solutions, list):
@@ -425,17 +420,32 @@ class MathRouter:
         mir_expr = prepared["problem"].expr
         return verify_all(mir_expr, candidate, reference_expr=expected)
 
+    def _check_roots_native(self, residual: sp.Expr, var: sp.Symbol, candidates: List[sp.Expr]):
+        mathcore = self._load_mathcore()
+        if not candidates or not hasattr(mathcore, "check_roots"):
+            return None
+        try:
+            # Plain str() keeps this path free of SymPy simplification.
+            return mathcore.check_roots(str(residual), str(var), [str(solution) for solution in candidates])
+        except Exception:
+            return None
+
     def _verify_solve(self, prepared: Dict[str, object], candidates: List[sp.Expr]) -> VerificationResult:
         lhs = prepared["lhs"]
         rhs = prepared["rhs"]
         var = prepared["variable"]
         symbolic_checks: List[bool] = []
         numeric_checks: List[bool] = []
-        for solution in candidates:
-            subs_lhs = lhs.subs(var, solution)
-            subs_rhs = rhs.subs(var, solution)
-            symbolic_checks.append(symbolic_equal(subs_lhs, subs_rhs))
-            numeric_checks.append(sp.simplify(subs_lhs - subs_rhs) == 0)
+        native = self._check_roots_native(lhs - rhs, var, candidates)
+        if native is not None:
+            symbolic_checks = [check.method == "symbolic" for check in native.roots]
+            numeric_checks = [check.ok for check in native.roots]
+        else:
+            for solution in candidates:
+                subs_lhs = lhs.subs(var, solution)
+                subs_rhs = rhs.subs(var, solution)
+                symbolic_checks.append(symbolic_equal(subs_lhs, subs_rhs))
+                numeric_checks.append(sp.simplify(subs_lhs - subs_rhs) == 0)
         unit_result, unit_env = unit_check(prepared["problem"].expr, prepared["problem"].expr.sympy_expr)
         details = {
             "symbolic_checks": symbolic_checks,
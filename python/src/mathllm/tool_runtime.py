@@ -1,6 +1,5 @@
 from __future__ import annotations
 
-import json
 import logging
 import time
 from dataclasses import dataclass, field
@@ -8,6 +7,7 @@ from typing import Any, Dict, List, Optional
 
 import sympy as sp
 
+from .mir import solutions_from_mathcore
 from .planner import Plan, PlanStep
 from .verify import _import_mathcore, numeric_probe, symbolic_equal
 
@@ -227,12 +227,9 @@ class ToolRuntime:
         var = args.get("var")
         if not all(isinstance(item, str) for item in (lhs, rhs, var)):
             raise RuntimeError("solve_equation requires lhs, rhs, var strings")
-        raw = self.mathcore.solve_equation(lhs, rhs, var)
-        try:
-            parsed = json.loads(raw)
-        except json.JSONDecodeError:
-            parsed = [raw]
-        solutions = [sp.sympify(sol) for sol in parsed]
+        solutions = solutions_from_mathcore(self.mathcore.solve_equation_set(lhs, rhs, var))
+        if not solutions:
+            raise RuntimeError("solve_equation found no solutions")
         return sp.Matrix(solutions) if len(solutions) > 1 else solutions[0]
 
     def _tool_verify_equal(self, args: Dict[str, Any], _: Dict[str, sp.Expr]) -> bool:
@@ -246,7 +243,7 @@ class ToolRuntime:
         expr = args.get("expr")
         if not isinstance(expr, str):
             raise RuntimeError("simplify requires expr string")
-        return sp.simplify(expr)
+        return sp.sympify(self.mathcore.simplify(expr))
 
     def _tool_ode_solve_stub(self, args: Dict[str, Any], _: Dict[str, sp.Expr]) -> sp.Expr:
         expr = args.get("expr", "0")
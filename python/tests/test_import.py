@@ -16,6 +16,43 @@ def test_integrate():
     assert mathcore.integrate("2*x", "x") == "x**2"
 
 
+def test_simplify():
+    assert mathcore.simplify("sin(x)^2 + cos(x)^2") == "1"
+    assert mathcore.simplify("(x^2 - 1)/(x - 1)", objective="nodes") == "1 + x"
+
+
+def test_egraph_equivalent():
+    result = mathcore.egraph_equivalent("sin(x)^2 + cos(x)^2", "1")
+    assert result.equal
+    assert result.stats.stop_reason == "goal"
+
+
+def test_cancel():
+    assert mathcore.cancel("(x^2 - 1)/(x - 1)") == "1 + x"
+    form = mathcore.rational_form("(a*x + a*y)/(x^2 - y^2)")
+    assert form.reduced
+    assert str(form.numerator) == "a"
+
+
+def test_trig_canonical():
+    assert mathcore.trig_canonical("2*sin(x)*cos(x)") == "sin(2*x)"
+    assert mathcore.trig_canonical("sin(x)^2 + cos(x)^2") == "1"
+
+
+def test_intern_stats():
+    mathcore.verify_equal("x^2 + 1", "1 + x^2")
+    stats = mathcore.intern_stats()
+    assert stats.entries > 0
+    assert stats.capacity > 0
+
+
+def test_alpha_canonicalize():
+    first = mathcore.alpha_canonicalize("x^2*sin(x)", ["x"])
+    second = mathcore.alpha_canonicalize("t^2*sin(t)", ["t"])
+    assert first.key == second.key
+    assert first.renaming == [("x", "_0")]
+
+
 def test_verify_equal_true():
     assert mathcore.verify_equal("x^2", "x*x") is True
 
@@ -26,3 +63,45 @@ def test_verify_equal_false():
 
 def test_solve_equation_linear():
     assert mathcore.solve_equation("x", "3", "x") == "[3]"
+
+
+def test_solve_equation_set():
+    result = mathcore.solve_equation_set("(x - 1)^2*(x + 2)", "0", "x")
+    assert {element.value.name: element.multiplicity for element in result.elements} == {"1": 2, "-2": 1}
+    assert str(result) == mathcore.solve_equation("(x - 1)^2*(x + 2)", "0", "x")
+
+
+def test_solutions_from_mathcore():
+    import sympy as sp
+    from mathllm.mir import solutions_from_mathcore
+
+    solutions = solutions_from_mathcore(mathcore.solve_equation_set("x^2", "2", "x"))
+    assert sorted(solutions) == [-sp.sqrt(2), sp.sqrt(2)]
+
+
+def test_solve_equation_transcendental():
+    from mathllm.mir import solutions_from_mathcore
+    from mathllm.tool_runtime import ToolRuntime
+
+    result = mathcore.solve_equation_set("cos(x)", "x", "x")
+    assert result.method == "interval_bisection"
+    assert [element.multiplicity for element in result.elements] == [1]
+    assert result.conditions
+
+    solutions = solutions_from_mathcore(result)
+    assert len(solutions) == 1
+    assert abs(float(solutions[0]) - 0.7390851332151607) < 1e-9
+
+    root = ToolRuntime()._tool_solve_equation({"lhs": "cos(x)", "rhs": "x", "var": "x"}, {})
+    assert abs(float(root) - 0.7390851332151607) < 1e-9
+
+
+def test_solve_equation_rational():
+    import sympy as sp
+    from mathllm.mir import solutions_from_mathcore
+
+    result = mathcore.solve_equation_set("1/(x - 1)", "2", "x")
+    assert result.method == "symengine"
+    assert not result.conditions
+    assert [element.multiplicity for element in result.elements] == [1]
+    assert solutions_from_mathcore(result) == [sp.Rational(3, 2)]